@@ -16,12 +16,17 @@
  ***********************************************************************/
 
 #include <geos/geom/prep/PreparedGeometryFactory.h>
-#include <geos/index/strtree/STRtree.h>
+#include <geos/index/SpatialIndex.h>
+#include <geos/index/strtree/STRtreeSnapshot.h>
 #include <geos/io/WKTReader.h>
 #include <geos/io/WKBReader.h>
 #include <geos/io/WKTWriter.h>
 #include <geos/io/WKBWriter.h>
-#include <geos/io/CLocalizer.h>
+#include <geos/io/GeoJSON.h>
+#include <geos/io/GeoJSONReader.h>
+#include <geos/io/GeoJSONWriter.h>
+#include <geos/io/TWKBReader.h>
+#include <geos/io/TWKBWriter.h>
 #include <geos/operation/overlay/OverlayOp.h>
 #include <geos/operation/union/CascadedPolygonUnion.h>
 #include <geos/algorithm/distance/DiscreteHausdorffDistance.h>
@@ -38,11 +43,17 @@
 #define GEOSGeometry geos::geom::Geometry
 #define GEOSPreparedGeometry geos::geom::prep::PreparedGeometry
 #define GEOSCoordSequence geos::geom::CoordinateSequence
-#define GEOSSTRtree geos::index::strtree::STRtree
+#define GEOSSTRtree geos::index::SpatialIndex
+#define GEOSSTRtreeSnapshot geos::index::strtree::STRtreeSnapshot
 #define GEOSWKTReader_t geos::io::WKTReader
 #define GEOSWKTWriter_t geos::io::WKTWriter
 #define GEOSWKBReader_t geos::io::WKBReader
 #define GEOSWKBWriter_t geos::io::WKBWriter
+#define GEOSGeoJSONReader_t geos::io::GeoJSONReader
+#define GEOSGeoJSONWriter_t geos::io::GeoJSONWriter
+#define GEOSGeoJSONFeatures_t geos::io::GeoJSONFeatureCollection
+#define GEOSTWKBReader_t geos::io::TWKBReader
+#define GEOSTWKBWriter_t geos::io::TWKBWriter
 typedef struct GEOSBufParams_t GEOSBufferParams;
 
 #include "geos_c.h"
@@ -73,9 +84,8 @@ using geos::io::WKTReader;
 using geos::io::WKTWriter;
 using geos::io::WKBReader;
 using geos::io::WKBWriter;
-using geos::io::CLocalizer;
 
-using geos::index::strtree::STRtree;
+using geos::index::SpatialIndex;
 
 using geos::operation::overlay::OverlayOp;
 using geos::operation::overlay::overlayOp;
@@ -115,6 +125,18 @@ finishGEOS ()
     }
 }
 
+int
+GEOSArena_begin()
+{
+    return GEOSArena_begin_r( handle );
+}
+
+int
+GEOSArena_release()
+{
+    return GEOSArena_release_r( handle );
+}
+
 GEOSInterruptCallback*
 GEOS_interruptRegisterCallback(GEOSInterruptCallback* cb)
 {
@@ -699,6 +721,18 @@ GEOSHasZ(const Geometry *g)
     return GEOSHasZ_r( handle, g );
 }
 
+int
+GEOS_getPackedXYCoordSeq()
+{
+    return GEOS_getPackedXYCoordSeq_r( handle );
+}
+
+int
+GEOS_setPackedXYCoordSeq(int enable)
+{
+    return GEOS_setPackedXYCoordSeq_r( handle, enable );
+}
+
 int
 GEOS_getWKBOutputDims()
 {
@@ -796,6 +830,27 @@ GEOSCoordSeq_getDimensions(const CoordinateSequence *s, unsigned int *dims)
     return GEOSCoordSeq_getDimensions_r( handle, s, dims );
 }
 
+CoordinateSequence *
+GEOSCoordSeq_copyFromBuffer(const double *buf, unsigned int size,
+                            unsigned int dims, unsigned int stride)
+{
+    return GEOSCoordSeq_copyFromBuffer_r( handle, buf, size, dims, stride );
+}
+
+int
+GEOSCoordSeq_copyToBuffer(const CoordinateSequence *s, double *buf,
+                          unsigned int dims, unsigned int stride)
+{
+    return GEOSCoordSeq_copyToBuffer_r( handle, s, buf, dims, stride );
+}
+
+CoordinateSequence *
+GEOSCoordSeq_createBorrowed(const double *buf, unsigned int size,
+                            unsigned int dims, unsigned int stride)
+{
+    return GEOSCoordSeq_createBorrowed_r( handle, buf, size, dims, stride );
+}
+
 void
 GEOSCoordSeq_destroy(CoordinateSequence *s)
 {
@@ -826,6 +881,29 @@ GEOSGeom_createLineString(CoordinateSequence *cs)
     return GEOSGeom_createLineString_r( handle, cs );
 }
 
+Geometry *
+GEOSGeom_createLinearRingFromBuffer(const double *buf, unsigned int size,
+                                    unsigned int dims, unsigned int stride)
+{
+    return GEOSGeom_createLinearRingFromBuffer_r( handle, buf, size, dims, stride );
+}
+
+Geometry *
+GEOSGeom_createLineStringFromBuffer(const double *buf, unsigned int size,
+                                    unsigned int dims, unsigned int stride)
+{
+    return GEOSGeom_createLineStringFromBuffer_r( handle, buf, size, dims, stride );
+}
+
+Geometry *
+GEOSGeom_createPolygonFromBuffer(const double *buf,
+                                 const unsigned int *ringSizes,
+                                 unsigned int nrings,
+                                 unsigned int dims, unsigned int stride)
+{
+    return GEOSGeom_createPolygonFromBuffer_r( handle, buf, ringSizes, nrings, dims, stride );
+}
+
 Geometry *
 GEOSGeom_createPolygon(Geometry *shell, Geometry **holes, unsigned int nholes)
 {
@@ -1023,6 +1101,204 @@ GEOSWKBWriter_setIncludeSRID(GEOSWKBWriter* writer, const char newIncludeSRID)
 }
 
 
+/* GeoJSON Reader */
+GEOSGeoJSONReader *
+GEOSGeoJSONReader_create()
+{
+    return GEOSGeoJSONReader_create_r( handle );
+}
+
+void
+GEOSGeoJSONReader_destroy(GEOSGeoJSONReader *reader)
+{
+    GEOSGeoJSONReader_destroy_r( handle, reader );
+}
+
+Geometry*
+GEOSGeoJSONReader_read(GEOSGeoJSONReader *reader, const char *json, size_t size)
+{
+    return GEOSGeoJSONReader_read_r( handle, reader, json, size );
+}
+
+GEOSGeoJSONFeatures*
+GEOSGeoJSONReader_readFeatures(GEOSGeoJSONReader *reader, const char *json, size_t size)
+{
+    return GEOSGeoJSONReader_readFeatures_r( handle, reader, json, size );
+}
+
+int
+GEOSGeoJSONFeatures_getNumFeatures(const GEOSGeoJSONFeatures *features)
+{
+    return GEOSGeoJSONFeatures_getNumFeatures_r( handle, features );
+}
+
+const Geometry*
+GEOSGeoJSONFeatures_getGeometry(const GEOSGeoJSONFeatures *features, int n)
+{
+    return GEOSGeoJSONFeatures_getGeometry_r( handle, features, n );
+}
+
+Geometry*
+GEOSGeoJSONFeatures_releaseGeometry(GEOSGeoJSONFeatures *features, int n)
+{
+    return GEOSGeoJSONFeatures_releaseGeometry_r( handle, features, n );
+}
+
+const char*
+GEOSGeoJSONFeatures_getProperties(const GEOSGeoJSONFeatures *features, int n, size_t *size)
+{
+    return GEOSGeoJSONFeatures_getProperties_r( handle, features, n, size );
+}
+
+const char*
+GEOSGeoJSONFeatures_getId(const GEOSGeoJSONFeatures *features, int n, size_t *size)
+{
+    return GEOSGeoJSONFeatures_getId_r( handle, features, n, size );
+}
+
+void
+GEOSGeoJSONFeatures_destroy(GEOSGeoJSONFeatures *features)
+{
+    GEOSGeoJSONFeatures_destroy_r( handle, features );
+}
+
+/* GeoJSON Writer */
+GEOSGeoJSONWriter *
+GEOSGeoJSONWriter_create()
+{
+    return GEOSGeoJSONWriter_create_r( handle );
+}
+
+void
+GEOSGeoJSONWriter_destroy(GEOSGeoJSONWriter *writer)
+{
+    GEOSGeoJSONWriter_destroy_r( handle, writer );
+}
+
+char*
+GEOSGeoJSONWriter_write(GEOSGeoJSONWriter *writer, const Geometry *geom)
+{
+    return GEOSGeoJSONWriter_write_r( handle, writer, geom );
+}
+
+void
+GEOSGeoJSONWriter_setOutputDimension(GEOSGeoJSONWriter *writer, int dim)
+{
+    GEOSGeoJSONWriter_setOutputDimension_r( handle, writer, dim );
+}
+
+
+/* TWKB Reader */
+GEOSTWKBReader *
+GEOSTWKBReader_create()
+{
+    return GEOSTWKBReader_create_r( handle );
+}
+
+void
+GEOSTWKBReader_destroy(GEOSTWKBReader *reader)
+{
+    GEOSTWKBReader_destroy_r( handle, reader );
+}
+
+Geometry*
+GEOSTWKBReader_read(GEOSTWKBReader *reader, const unsigned char *twkb, size_t size)
+{
+    return GEOSTWKBReader_read_r( handle, reader, twkb, size );
+}
+
+Geometry*
+GEOSTWKBReader_readWithIds(GEOSTWKBReader *reader, const unsigned char *twkb, size_t size, int64_t **ids, size_t *numIds)
+{
+    return GEOSTWKBReader_readWithIds_r( handle, reader, twkb, size, ids, numIds );
+}
+
+/* TWKB Writer */
+GEOSTWKBWriter *
+GEOSTWKBWriter_create()
+{
+    return GEOSTWKBWriter_create_r( handle );
+}
+
+void
+GEOSTWKBWriter_destroy(GEOSTWKBWriter *writer)
+{
+    GEOSTWKBWriter_destroy_r( handle, writer );
+}
+
+unsigned char*
+GEOSTWKBWriter_write(GEOSTWKBWriter *writer, const Geometry *geom, size_t *size)
+{
+    return GEOSTWKBWriter_write_r( handle, writer, geom, size );
+}
+
+unsigned char*
+GEOSTWKBWriter_writeWithIds(GEOSTWKBWriter *writer, const Geometry *geom, const int64_t *ids, size_t *size)
+{
+    return GEOSTWKBWriter_writeWithIds_r( handle, writer, geom, ids, size );
+}
+
+int
+GEOSTWKBWriter_getOutputDimension(const GEOSTWKBWriter* writer)
+{
+    return GEOSTWKBWriter_getOutputDimension_r( handle, writer );
+}
+
+void
+GEOSTWKBWriter_setOutputDimension(GEOSTWKBWriter* writer, int newDimension)
+{
+    GEOSTWKBWriter_setOutputDimension_r( handle, writer, newDimension );
+}
+
+int
+GEOSTWKBWriter_getPrecision(const GEOSTWKBWriter* writer)
+{
+    return GEOSTWKBWriter_getPrecision_r( handle, writer );
+}
+
+void
+GEOSTWKBWriter_setPrecision(GEOSTWKBWriter* writer, int precision)
+{
+    GEOSTWKBWriter_setPrecision_r( handle, writer, precision );
+}
+
+int
+GEOSTWKBWriter_getPrecisionZ(const GEOSTWKBWriter* writer)
+{
+    return GEOSTWKBWriter_getPrecisionZ_r( handle, writer );
+}
+
+void
+GEOSTWKBWriter_setPrecisionZ(GEOSTWKBWriter* writer, int precision)
+{
+    GEOSTWKBWriter_setPrecisionZ_r( handle, writer, precision );
+}
+
+char
+GEOSTWKBWriter_getIncludeBBox(const GEOSTWKBWriter* writer)
+{
+    return GEOSTWKBWriter_getIncludeBBox_r( handle, writer );
+}
+
+void
+GEOSTWKBWriter_setIncludeBBox(GEOSTWKBWriter* writer, const char newIncludeBBox)
+{
+    GEOSTWKBWriter_setIncludeBBox_r( handle, writer, newIncludeBBox );
+}
+
+char
+GEOSTWKBWriter_getIncludeSize(const GEOSTWKBWriter* writer)
+{
+    return GEOSTWKBWriter_getIncludeSize_r( handle, writer );
+}
+
+void
+GEOSTWKBWriter_setIncludeSize(GEOSTWKBWriter* writer, const char newIncludeSize)
+{
+    GEOSTWKBWriter_setIncludeSize_r( handle, writer, newIncludeSize );
+}
+
+
 //-----------------------------------------------------------------
 // Prepared Geometry
 //-----------------------------------------------------------------
@@ -1099,14 +1375,32 @@ GEOSPreparedWithin(const geos::geom::prep::PreparedGeometry *pg1, const Geometry
     return GEOSPreparedWithin_r( handle, pg1, g2 );
 }
 
-STRtree *
+SpatialIndex *
 GEOSSTRtree_create (size_t nodeCapacity)
 {
     return GEOSSTRtree_create_r( handle, nodeCapacity );
 }
 
+SpatialIndex *
+GEOSSTRtree_createThreaded (size_t nodeCapacity, size_t numThreads)
+{
+    return GEOSSTRtree_createThreaded_r( handle, nodeCapacity, numThreads );
+}
+
+SpatialIndex *
+GEOSSTRtree_createHilbert (size_t nodeCapacity)
+{
+    return GEOSSTRtree_createHilbert_r( handle, nodeCapacity );
+}
+
+SpatialIndex *
+GEOSSTRtree_createRStar (size_t maxEntries)
+{
+    return GEOSSTRtree_createRStar_r( handle, maxEntries );
+}
+
 void
-GEOSSTRtree_insert (geos::index::strtree::STRtree *tree,
+GEOSSTRtree_insert (geos::index::SpatialIndex *tree,
                     const geos::geom::Geometry *g,
                     void *item)
 {
@@ -1114,7 +1408,7 @@ GEOSSTRtree_insert (geos::index::strtree::STRtree *tree,
 }
 
 void
-GEOSSTRtree_query (geos::index::strtree::STRtree *tree,
+GEOSSTRtree_query (geos::index::SpatialIndex *tree,
                    const geos::geom::Geometry *g,
                    GEOSQueryCallback cb,
                    void *userdata)
@@ -1122,8 +1416,29 @@ GEOSSTRtree_query (geos::index::strtree::STRtree *tree,
     GEOSSTRtree_query_r( handle, tree, g, cb, userdata );
 }
 
+GEOSQueryHit *
+GEOSSTRtree_queryBatch (geos::index::SpatialIndex *tree,
+                        const geos::geom::Geometry *const *geoms,
+                        size_t numGeoms,
+                        size_t numThreads,
+                        size_t *numHits)
+{
+    return GEOSSTRtree_queryBatch_r( handle, tree, geoms, numGeoms,
+                                     numThreads, numHits );
+}
+
+int
+GEOSSTRtree_join(geos::index::SpatialIndex *tree1,
+                 geos::index::SpatialIndex *tree2,
+                 size_t numThreads,
+                 GEOSJoinCallback callback,
+                 void *userdata)
+{
+    return GEOSSTRtree_join_r( handle, tree1, tree2, numThreads, callback, userdata );
+}
+
 void
-GEOSSTRtree_iterate(geos::index::strtree::STRtree *tree,
+GEOSSTRtree_iterate(geos::index::SpatialIndex *tree,
                     GEOSQueryCallback callback,
                     void *userdata)
 {
@@ -1131,19 +1446,73 @@ GEOSSTRtree_iterate(geos::index::strtree::STRtree *tree,
 }
 
 char
-GEOSSTRtree_remove (geos::index::strtree::STRtree *tree,
+GEOSSTRtree_remove (geos::index::SpatialIndex *tree,
                     const geos::geom::Geometry *g,
                     void *item)
 {
     return GEOSSTRtree_remove_r( handle, tree, g, item );
 }
 
+const void *
+GEOSSTRtree_nearest (geos::index::SpatialIndex *tree,
+                     const void *item,
+                     const geos::geom::Geometry *itemEnvelope,
+                     GEOSDistanceCallback distancefn,
+                     void *userdata)
+{
+    return GEOSSTRtree_nearest_r( handle, tree, item, itemEnvelope,
+                                  distancefn, userdata );
+}
+
+int
+GEOSSTRtree_nearestK (geos::index::SpatialIndex *tree,
+                      const void *item,
+                      const geos::geom::Geometry *itemEnvelope,
+                      size_t k,
+                      GEOSDistanceCallback distancefn,
+                      void *userdata,
+                      const void **results)
+{
+    return GEOSSTRtree_nearestK_r( handle, tree, item, itemEnvelope, k,
+                                   distancefn, userdata, results );
+}
+
 void
-GEOSSTRtree_destroy (geos::index::strtree::STRtree *tree)
+GEOSSTRtree_destroy (geos::index::SpatialIndex *tree)
 {
     GEOSSTRtree_destroy_r( handle, tree );
 }
 
+int
+GEOSSTRtree_writeSnapshot (geos::index::SpatialIndex *tree,
+                           const char *filename,
+                           GEOSItemIdCallback idfn,
+                           void *userdata)
+{
+    return GEOSSTRtree_writeSnapshot_r( handle, tree, filename, idfn, userdata );
+}
+
+geos::index::strtree::STRtreeSnapshot *
+GEOSSTRtreeSnapshot_open (const char *filename)
+{
+    return GEOSSTRtreeSnapshot_open_r( handle, filename );
+}
+
+int
+GEOSSTRtreeSnapshot_query (const geos::index::strtree::STRtreeSnapshot *snapshot,
+                           const geos::geom::Geometry *g,
+                           GEOSSnapshotQueryCallback callback,
+                           void *userdata)
+{
+    return GEOSSTRtreeSnapshot_query_r( handle, snapshot, g, callback, userdata );
+}
+
+void
+GEOSSTRtreeSnapshot_destroy (geos::index::strtree::STRtreeSnapshot *snapshot)
+{
+    GEOSSTRtreeSnapshot_destroy_r( handle, snapshot );
+}
+
 double
 GEOSProject (const geos::geom::Geometry *g,
              const geos::geom::Geometry *p)
@@ -36,8 +36,10 @@
 
 #ifndef __cplusplus
 # include <stddef.h> /* for size_t definition */
+# include <stdint.h> /* for int64_t definition */
 #else
 # include <cstddef>
+# include <stdint.h>
 using std::size_t;
 #endif
 
@@ -121,6 +123,7 @@ typedef struct GEOSGeom_t GEOSGeometry;
 typedef struct GEOSPrepGeom_t GEOSPreparedGeometry;
 typedef struct GEOSCoordSeq_t GEOSCoordSequence;
 typedef struct GEOSSTRtree_t GEOSSTRtree;
+typedef struct GEOSSTRtreeSnapshot_t GEOSSTRtreeSnapshot;
 typedef struct GEOSBufParams_t GEOSBufferParams;
 #endif
 
@@ -154,6 +157,47 @@ enum GEOSByteOrders {
 
 typedef void (*GEOSQueryCallback)(void *item, void *userdata);
 
+/*
+ * Callback function receiving a pair of items found by
+ * GEOSSTRtree_join, item1 from the first tree and item2 from
+ * the second.
+ */
+typedef void (*GEOSJoinCallback)(void *item1, void *item2, void *userdata);
+
+/*
+ * Callback function for use in spatial index nearest neighbour
+ * searches. Computes the distance between two items of the index
+ * and stores it in *distance.
+ *
+ * The distance must not be less than the distance between the
+ * envelopes the items were inserted with.
+ *
+ * Return 1 if the distance was computed, 0 on failure.
+ */
+typedef int (*GEOSDistanceCallback)(const void *item1, const void *item2,
+                                    double *distance, void *userdata);
+
+/*
+ * A result of GEOSSTRtree_queryBatch: the item was found by the
+ * query with the given index.
+ */
+typedef struct GEOSQueryHit_t {
+    size_t queryIndex;
+    void *item;
+} GEOSQueryHit;
+
+/*
+ * Callback function giving the identifier saved for an item by
+ * GEOSSTRtree_writeSnapshot.
+ */
+typedef int64_t (*GEOSItemIdCallback)(const void *item, void *userdata);
+
+/*
+ * Callback function receiving the identifier of an item found by
+ * GEOSSTRtreeSnapshot_query.
+ */
+typedef void (*GEOSSnapshotQueryCallback)(int64_t id, void *userdata);
+
 /************************************************************************
  *
  * Initialization, cleanup, version
@@ -223,6 +267,30 @@ extern GEOSMessageHandler_r GEOS_DLL GEOSContext_setErrorMessageHandler_r(GEOSCo
                                                                           GEOSMessageHandler_r ef,
                                                                           void *userData);
 
+/*
+ * Open and close an arena scope on the given GEOS context.
+ *
+ * Between GEOSArena_begin_r and GEOSArena_release_r, geometries and
+ * coordinate sequences created through the context (by the
+ * GEOSGeom_create* functions, the WKT and WKB parsing functions and
+ * the results of operations) are carved from one region of memory.
+ * Destroying them one by one still works but gives no memory back.
+ *
+ * GEOSArena_release_r destroys every such object not destroyed yet
+ * and gives the whole region back at once. None of them, nor any
+ * pointer into them, may be used afterwards. Readers and writers
+ * created before the scope was opened keep allocating from the heap;
+ * those created in a scope allocate from the heap between scopes.
+ * Clones of arena geometries, made with GEOSGeom_clone_r or inside
+ * operations, are allocated from the heap too, and stay valid until
+ * destroyed.
+ *
+ * Return 1 on success, 0 on exception (e.g. opening a scope which is
+ * already open, or releasing one which is not).
+ */
+extern int GEOS_DLL GEOSArena_begin_r(GEOSContextHandle_t handle);
+extern int GEOS_DLL GEOSArena_release_r(GEOSContextHandle_t handle);
+
 extern const char GEOS_DLL *GEOSversion();
 
 
@@ -280,12 +348,25 @@ extern unsigned char GEOS_DLL *GEOSGeomToHEX_buf_r(GEOSContextHandle_t handle,
  * Create a Coordinate sequence with ``size'' coordinates
  * of ``dims'' dimensions.
  * Return NULL on exception.
+ *
+ * With packed XY sequences enabled (see GEOS_setPackedXYCoordSeq_r),
+ * 2-dimensional sequences store points as two doubles instead of
+ * three, and Z is not stored.
  */
 extern GEOSCoordSequence GEOS_DLL *GEOSCoordSeq_create_r(
                                                 GEOSContextHandle_t handle,
                                                 unsigned int size,
                                                 unsigned int dims);
 
+/*
+ * Specify whether GEOSCoordSeq_create_r makes packed XY sequences
+ * when asked for 2 dimensions (0, the default, or 1).
+ * Return the previous setting, or -1 on error.
+ */
+extern int GEOS_DLL GEOS_getPackedXYCoordSeq_r(GEOSContextHandle_t handle);
+extern int GEOS_DLL GEOS_setPackedXYCoordSeq_r(GEOSContextHandle_t handle,
+                                               int enable);
+
 /*
  * Clone a Coordinate Sequence.
  * Return NULL on exception.
@@ -346,6 +427,56 @@ extern int GEOS_DLL GEOSCoordSeq_getDimensions_r(GEOSContextHandle_t handle,
                                                  const GEOSCoordSequence* s,
                                                  unsigned int *dims);
 
+/*
+ * Bulk copies between Coordinate Sequences and interleaved arrays
+ * of doubles, x0, y0[, z0], ...
+ *
+ * ``dims'' (2 or 3) is the number of ordinates copied per point and
+ * ``stride'' (at least dims) the number of doubles from one point to
+ * the next, so that x, y can be taken from an XYZM array with a
+ * stride of 4. Doubles between the copied ordinates are left alone.
+ * Z is written as NaN for points which have none.
+ *
+ * copyFromBuffer reads ``size'' points and makes a sequence as
+ * GEOSCoordSeq_create_r would; it returns NULL on exception.
+ * copyToBuffer writes every point of the sequence, and returns 0 on
+ * exception.
+ */
+extern GEOSCoordSequence GEOS_DLL *GEOSCoordSeq_copyFromBuffer_r(
+                                                GEOSContextHandle_t handle,
+                                                const double* buf,
+                                                unsigned int size,
+                                                unsigned int dims,
+                                                unsigned int stride);
+extern int GEOS_DLL GEOSCoordSeq_copyToBuffer_r(GEOSContextHandle_t handle,
+                                                const GEOSCoordSequence* s,
+                                                double* buf,
+                                                unsigned int dims,
+                                                unsigned int stride);
+
+/*
+ * Create a read-only Coordinate Sequence over ``size'' points of an
+ * interleaved array of doubles, laid out as for
+ * GEOSCoordSeq_copyFromBuffer_r, without copying them.
+ * Return NULL on exception.
+ *
+ * The caller keeps ownership of the array, which must stay allocated
+ * and unchanged until the sequence, and every geometry built on it
+ * (including prepared geometries and STRtree entries using them),
+ * has been destroyed. Results of operations on such geometries, and
+ * their clones, have their own copy of the points and do not depend
+ * on the array.
+ *
+ * Setting ordinates of the sequence, or changing a geometry built on
+ * it (for instance with GEOSNormalize_r), fails with an exception.
+ */
+extern GEOSCoordSequence GEOS_DLL *GEOSCoordSeq_createBorrowed_r(
+                                                GEOSContextHandle_t handle,
+                                                const double* buf,
+                                                unsigned int size,
+                                                unsigned int dims,
+                                                unsigned int stride);
+
 /************************************************************************
  *
  *  Linear referencing functions -- there are more, but these are
@@ -513,6 +644,30 @@ extern GEOSGeometry GEOS_DLL *GEOSGeom_createCollection_r(
 extern GEOSGeometry GEOS_DLL *GEOSGeom_createEmptyCollection_r(
                                        GEOSContextHandle_t handle, int type);
 
+/*
+ * Build geometries straight from interleaved arrays of doubles,
+ * read as by GEOSCoordSeq_copyFromBuffer_r. The caller keeps the
+ * arrays.
+ *
+ * The rings of a polygon follow one another in ``buf'', shell
+ * first; ``ringSizes'' gives the number of points of each. With no
+ * rings an empty polygon is returned.
+ */
+extern GEOSGeometry GEOS_DLL *GEOSGeom_createLinearRingFromBuffer_r(
+                                       GEOSContextHandle_t handle,
+                                       const double* buf, unsigned int size,
+                                       unsigned int dims, unsigned int stride);
+extern GEOSGeometry GEOS_DLL *GEOSGeom_createLineStringFromBuffer_r(
+                                       GEOSContextHandle_t handle,
+                                       const double* buf, unsigned int size,
+                                       unsigned int dims, unsigned int stride);
+extern GEOSGeometry GEOS_DLL *GEOSGeom_createPolygonFromBuffer_r(
+                                       GEOSContextHandle_t handle,
+                                       const double* buf,
+                                       const unsigned int* ringSizes,
+                                       unsigned int nrings,
+                                       unsigned int dims, unsigned int stride);
+
 extern GEOSGeometry GEOS_DLL *GEOSGeom_clone_r(GEOSContextHandle_t handle,
                                                const GEOSGeometry* g);
 
@@ -787,6 +942,34 @@ extern char GEOS_DLL GEOSPreparedWithin_r(GEOSContextHandle_t handle,
 extern GEOSSTRtree GEOS_DLL *GEOSSTRtree_create_r(
                                     GEOSContextHandle_t handle,
                                     size_t nodeCapacity);
+/*
+ * Like GEOSSTRtree_create_r, but the tree is built using up to
+ * numThreads threads. The tree built is the same for any number
+ * of threads; only the build time changes.
+ */
+extern GEOSSTRtree GEOS_DLL *GEOSSTRtree_createThreaded_r(
+                                    GEOSContextHandle_t handle,
+                                    size_t nodeCapacity,
+                                    size_t numThreads);
+/*
+ * Creates a query-only R-tree packed in Hilbert curve order.
+ * It is built with a single sort, which is faster than the
+ * Sort-Tile-Recursive packing of GEOSSTRtree_create_r, and accepts
+ * the same GEOSSTRtree_* calls. Inserting or removing items after
+ * the first query is allowed, but rebuilds the tree.
+ */
+extern GEOSSTRtree GEOS_DLL *GEOSSTRtree_createHilbert_r(
+                                    GEOSContextHandle_t handle,
+                                    size_t nodeCapacity);
+/*
+ * Creates a dynamic R*-tree, which accepts the same GEOSSTRtree_*
+ * calls. Items can be inserted and removed at any time, without
+ * the whole tree being rebuilt. maxEntries is the maximum number
+ * of entries of a node, at least 4.
+ */
+extern GEOSSTRtree GEOS_DLL *GEOSSTRtree_createRStar_r(
+                                    GEOSContextHandle_t handle,
+                                    size_t maxEntries);
 extern void GEOS_DLL GEOSSTRtree_insert_r(GEOSContextHandle_t handle,
                                           GEOSSTRtree *tree,
                                           const GEOSGeometry *g,
@@ -796,6 +979,39 @@ extern void GEOS_DLL GEOSSTRtree_query_r(GEOSContextHandle_t handle,
                                          const GEOSGeometry *g,
                                          GEOSQueryCallback callback,
                                          void *userdata);
+/*
+ * Queries the tree with the envelopes of numGeoms geometries at once.
+ *
+ * Returns an array of *numHits (query index, item) pairs, ordered by
+ * query index; the items found by each query are in the order
+ * GEOSSTRtree_query_r would report them. Nearby queries share their
+ * walks of the tree, and up to numThreads threads are used.
+ *
+ * The array must be freed with GEOSFree_r.
+ * Returns NULL on exception.
+ */
+extern GEOSQueryHit GEOS_DLL *GEOSSTRtree_queryBatch_r(
+                                         GEOSContextHandle_t handle,
+                                         GEOSSTRtree *tree,
+                                         const GEOSGeometry *const *geoms,
+                                         size_t numGeoms,
+                                         size_t numThreads,
+                                         size_t *numHits);
+/*
+ * Report each pair of an item of tree1 and an item of tree2 whose
+ * envelopes intersect. Both trees must come from GEOSSTRtree_create_r;
+ * they are walked together, skipping disjoint pairs of nodes, using
+ * up to numThreads threads. The callback is always called from the
+ * calling thread. tree1 and tree2 may be the same tree.
+ *
+ * Return 1 on success, 0 on exception.
+ */
+extern int GEOS_DLL GEOSSTRtree_join_r(GEOSContextHandle_t handle,
+                                       GEOSSTRtree *tree1,
+                                       GEOSSTRtree *tree2,
+                                       size_t numThreads,
+                                       GEOSJoinCallback callback,
+                                       void *userdata);
 extern void GEOS_DLL GEOSSTRtree_iterate_r(GEOSContextHandle_t handle,
                                        GEOSSTRtree *tree,
                                        GEOSQueryCallback callback,
@@ -804,9 +1020,80 @@ extern char GEOS_DLL GEOSSTRtree_remove_r(GEOSContextHandle_t handle,
                                           GEOSSTRtree *tree,
                                           const GEOSGeometry *g,
                                           void *item);
+
+/*
+ * Return the item of the tree nearest to the given item, or NULL if
+ * the tree is empty or an exception occurred.
+ *
+ * itemEnvelope is a geometry whose envelope bounds the query item.
+ * If distancefn is NULL, all items (including the query item) are
+ * expected to be GEOSGeometry and their exact distance is used.
+ */
+extern const void GEOS_DLL *GEOSSTRtree_nearest_r(GEOSContextHandle_t handle,
+                                          GEOSSTRtree *tree,
+                                          const void *item,
+                                          const GEOSGeometry *itemEnvelope,
+                                          GEOSDistanceCallback distancefn,
+                                          void *userdata);
+
+/*
+ * Store up to k items of the tree nearest to the given item in
+ * results, ordered by increasing distance. The results array must
+ * have room for k items.
+ *
+ * Return the number of items stored, or -1 on exception.
+ *
+ * See GEOSSTRtree_nearest_r for the meaning of the other arguments.
+ */
+extern int GEOS_DLL GEOSSTRtree_nearestK_r(GEOSContextHandle_t handle,
+                                          GEOSSTRtree *tree,
+                                          const void *item,
+                                          const GEOSGeometry *itemEnvelope,
+                                          size_t k,
+                                          GEOSDistanceCallback distancefn,
+                                          void *userdata,
+                                          const void **results);
 extern void GEOS_DLL GEOSSTRtree_destroy_r(GEOSContextHandle_t handle,
                                            GEOSSTRtree *tree);
 
+/*
+ * Save a tree created by GEOSSTRtree_create_r, building it if needed,
+ * to the named file. Items are saved as the identifiers returned by
+ * idfn, as pointers do not outlive the process.
+ *
+ * Return 1 on success, 0 on exception.
+ */
+extern int GEOS_DLL GEOSSTRtree_writeSnapshot_r(GEOSContextHandle_t handle,
+                                                GEOSSTRtree *tree,
+                                                const char *filename,
+                                                GEOSItemIdCallback idfn,
+                                                void *userdata);
+
+/*
+ * Open a file written by GEOSSTRtree_writeSnapshot_r. The file is
+ * memory-mapped and queried in place, without being loaded.
+ *
+ * Return NULL on exception.
+ */
+extern GEOSSTRtreeSnapshot GEOS_DLL *GEOSSTRtreeSnapshot_open_r(
+                                                GEOSContextHandle_t handle,
+                                                const char *filename);
+
+/*
+ * Report the identifiers of the saved items whose envelopes intersect
+ * the envelope of g, in the order GEOSSTRtree_query_r would have
+ * reported the items.
+ *
+ * Return 1 on success, 0 on exception.
+ */
+extern int GEOS_DLL GEOSSTRtreeSnapshot_query_r(GEOSContextHandle_t handle,
+                                                const GEOSSTRtreeSnapshot *snapshot,
+                                                const GEOSGeometry *g,
+                                                GEOSSnapshotQueryCallback callback,
+                                                void *userdata);
+extern void GEOS_DLL GEOSSTRtreeSnapshot_destroy_r(GEOSContextHandle_t handle,
+                                                   GEOSSTRtreeSnapshot *snapshot);
+
 
 /************************************************************************
  *
@@ -1063,6 +1350,10 @@ typedef struct GEOSWKTReader_t GEOSWKTReader;
 typedef struct GEOSWKTWriter_t GEOSWKTWriter;
 typedef struct GEOSWKBReader_t GEOSWKBReader;
 typedef struct GEOSWKBWriter_t GEOSWKBWriter;
+typedef struct GEOSGeoJSONReader_t GEOSGeoJSONReader;
+typedef struct GEOSGeoJSONWriter_t GEOSGeoJSONWriter;
+typedef struct GEOSTWKBReader_t GEOSTWKBReader;
+typedef struct GEOSTWKBWriter_t GEOSTWKBWriter;
 
 
 /* WKT Reader */
@@ -1159,10 +1450,189 @@ extern char GEOS_DLL GEOSWKBWriter_getIncludeSRID_r(GEOSContextHandle_t handle,
 extern void GEOS_DLL GEOSWKBWriter_setIncludeSRID_r(GEOSContextHandle_t handle,
                                    GEOSWKBWriter* writer, const char writeSRID);
 
+/* GeoJSON Reader */
+
+/*
+ * Features read by GEOSGeoJSONReader_readFeatures_r: for each one a
+ * geometry, and the JSON text of its id and properties.
+ */
+typedef struct GEOSGeoJSONFeatures_t GEOSGeoJSONFeatures;
+
+extern GEOSGeoJSONReader GEOS_DLL *GEOSGeoJSONReader_create_r(
+                                             GEOSContextHandle_t handle);
+extern void GEOS_DLL GEOSGeoJSONReader_destroy_r(GEOSContextHandle_t handle,
+                                             GEOSGeoJSONReader* reader);
+
+/*
+ * Read a GeoJSON geometry. A Feature gives its geometry, and a
+ * FeatureCollection a GeometryCollection of the geometries of its
+ * features. Return NULL on exception.
+ */
+extern GEOSGeometry GEOS_DLL *GEOSGeoJSONReader_read_r(GEOSContextHandle_t handle,
+                                                   GEOSGeoJSONReader* reader,
+                                                   const char *json,
+                                                   size_t size);
+
+/*
+ * Read all the features of a GeoJSON FeatureCollection in one call.
+ * A Feature, or a geometry, gives a single feature.
+ * Return NULL on exception.
+ */
+extern GEOSGeoJSONFeatures GEOS_DLL *GEOSGeoJSONReader_readFeatures_r(
+                                             GEOSContextHandle_t handle,
+                                             GEOSGeoJSONReader* reader,
+                                             const char *json,
+                                             size_t size);
+
+/* Return -1 on exception */
+extern int GEOS_DLL GEOSGeoJSONFeatures_getNumFeatures_r(
+                                             GEOSContextHandle_t handle,
+                                             const GEOSGeoJSONFeatures* features);
+
+/*
+ * The geometry of the n-th feature, owned by the features.
+ * Return NULL for a null geometry, one already released, or on
+ * exception.
+ */
+extern const GEOSGeometry GEOS_DLL *GEOSGeoJSONFeatures_getGeometry_r(
+                                             GEOSContextHandle_t handle,
+                                             const GEOSGeoJSONFeatures* features,
+                                             int n);
+
+/*
+ * Give the geometry of the n-th feature to the caller, who must
+ * destroy it, without copying it.
+ * Return NULL as GEOSGeoJSONFeatures_getGeometry_r does.
+ */
+extern GEOSGeometry GEOS_DLL *GEOSGeoJSONFeatures_releaseGeometry_r(
+                                             GEOSContextHandle_t handle,
+                                             GEOSGeoJSONFeatures* features,
+                                             int n);
+
+/*
+ * The JSON text of the properties of the n-th feature, "null" if it
+ * has none, and of its id, "" if it has none. The null terminated
+ * text is owned by the features; its length is stored in size if
+ * not NULL. Return NULL on exception.
+ */
+extern const char GEOS_DLL *GEOSGeoJSONFeatures_getProperties_r(
+                                             GEOSContextHandle_t handle,
+                                             const GEOSGeoJSONFeatures* features,
+                                             int n,
+                                             size_t *size);
+extern const char GEOS_DLL *GEOSGeoJSONFeatures_getId_r(
+                                             GEOSContextHandle_t handle,
+                                             const GEOSGeoJSONFeatures* features,
+                                             int n,
+                                             size_t *size);
+
+extern void GEOS_DLL GEOSGeoJSONFeatures_destroy_r(GEOSContextHandle_t handle,
+                                             GEOSGeoJSONFeatures* features);
+
+/* GeoJSON Writer */
+extern GEOSGeoJSONWriter GEOS_DLL *GEOSGeoJSONWriter_create_r(
+                                             GEOSContextHandle_t handle);
+extern void GEOS_DLL GEOSGeoJSONWriter_destroy_r(GEOSContextHandle_t handle,
+                                             GEOSGeoJSONWriter* writer);
+
+/* The caller owns the result, to be freed with GEOSFree_r */
+extern char GEOS_DLL *GEOSGeoJSONWriter_write_r(GEOSContextHandle_t handle,
+                                            GEOSGeoJSONWriter* writer,
+                                            const GEOSGeometry* g);
+extern void GEOS_DLL GEOSGeoJSONWriter_setOutputDimension_r(
+                                            GEOSContextHandle_t handle,
+                                            GEOSGeoJSONWriter *writer,
+                                            int dim);
+
+/* TWKB Reader */
+extern GEOSTWKBReader GEOS_DLL *GEOSTWKBReader_create_r(
+                                             GEOSContextHandle_t handle);
+extern void GEOS_DLL GEOSTWKBReader_destroy_r(GEOSContextHandle_t handle,
+                                             GEOSTWKBReader* reader);
+extern GEOSGeometry GEOS_DLL *GEOSTWKBReader_read_r(GEOSContextHandle_t handle,
+                                                   GEOSTWKBReader* reader,
+                                                   const unsigned char *twkb,
+                                                   size_t size);
+
+/*
+ * Also return the id list of the geometry in ids, to be freed with
+ * GEOSFree_r, and its length in numIds. ids is set to NULL if there
+ * is no id list.
+ */
+extern GEOSGeometry GEOS_DLL *GEOSTWKBReader_readWithIds_r(
+                                             GEOSContextHandle_t handle,
+                                             GEOSTWKBReader* reader,
+                                             const unsigned char *twkb,
+                                             size_t size,
+                                             int64_t **ids,
+                                             size_t *numIds);
+
+/* TWKB Writer */
+extern GEOSTWKBWriter GEOS_DLL *GEOSTWKBWriter_create_r(
+                                             GEOSContextHandle_t handle);
+extern void GEOS_DLL GEOSTWKBWriter_destroy_r(GEOSContextHandle_t handle,
+                                             GEOSTWKBWriter* writer);
+
+/* The caller owns the results for these two methods! */
+extern unsigned char GEOS_DLL *GEOSTWKBWriter_write_r(
+                                             GEOSContextHandle_t handle,
+                                             GEOSTWKBWriter* writer,
+                                             const GEOSGeometry* g,
+                                             size_t *size);
+
+/*
+ * Write a multi geometry or collection with an id list,
+ * one id for each of its GEOSGetNumGeometries_r() components.
+ */
+extern unsigned char GEOS_DLL *GEOSTWKBWriter_writeWithIds_r(
+                                             GEOSContextHandle_t handle,
+                                             GEOSTWKBWriter* writer,
+                                             const GEOSGeometry* g,
+                                             const int64_t *ids,
+                                             size_t *size);
+
+/*
+ * Specify whether output TWKB should be 2d or 3d.
+ */
+extern int GEOS_DLL GEOSTWKBWriter_getOutputDimension_r(
+                                  GEOSContextHandle_t handle,
+                                  const GEOSTWKBWriter* writer);
+extern void GEOS_DLL GEOSTWKBWriter_setOutputDimension_r(
+                                   GEOSContextHandle_t handle,
+                                   GEOSTWKBWriter* writer, int newDimension);
+
+/*
+ * Specify the number of decimal digits kept, from -8 to 7 for x and y
+ * (0 by default), and from 0 to 7 for z.
+ */
+extern int GEOS_DLL GEOSTWKBWriter_getPrecision_r(GEOSContextHandle_t handle,
+                                   const GEOSTWKBWriter* writer);
+extern void GEOS_DLL GEOSTWKBWriter_setPrecision_r(GEOSContextHandle_t handle,
+                                   GEOSTWKBWriter* writer, int precision);
+extern int GEOS_DLL GEOSTWKBWriter_getPrecisionZ_r(GEOSContextHandle_t handle,
+                                   const GEOSTWKBWriter* writer);
+extern void GEOS_DLL GEOSTWKBWriter_setPrecisionZ_r(GEOSContextHandle_t handle,
+                                   GEOSTWKBWriter* writer, int precision);
+
+/*
+ * Specify whether the bounding box and the byte size of each
+ * geometry should be output.
+ */
+extern char GEOS_DLL GEOSTWKBWriter_getIncludeBBox_r(GEOSContextHandle_t handle,
+                                   const GEOSTWKBWriter* writer);
+extern void GEOS_DLL GEOSTWKBWriter_setIncludeBBox_r(GEOSContextHandle_t handle,
+                                   GEOSTWKBWriter* writer, const char writeBBox);
+extern char GEOS_DLL GEOSTWKBWriter_getIncludeSize_r(GEOSContextHandle_t handle,
+                                   const GEOSTWKBWriter* writer);
+extern void GEOS_DLL GEOSTWKBWriter_setIncludeSize_r(GEOSContextHandle_t handle,
+                                   GEOSTWKBWriter* writer, const char writeSize);
+
+
 
 /*
  * Free buffers returned by stuff like GEOSWKBWriter_write(),
- * GEOSWKBWriter_writeHEX() and GEOSWKTWriter_write().
+ * GEOSWKBWriter_writeHEX(), GEOSWKTWriter_write(),
+ * GEOSGeoJSONWriter_write() and GEOSTWKBWriter_write().
  */
 extern void GEOS_DLL GEOSFree_r(GEOSContextHandle_t handle, void *buffer);
 
@@ -1181,6 +1651,9 @@ extern void GEOS_DLL initGEOS(GEOSMessageHandler notice_function,
     GEOSMessageHandler error_function);
 extern void GEOS_DLL finishGEOS(void);
 
+extern int GEOS_DLL GEOSArena_begin(void);
+extern int GEOS_DLL GEOSArena_release(void);
+
 /************************************************************************
  *
  * NOTE - These functions are DEPRECATED.  Please use the new Reader and
@@ -1224,6 +1697,13 @@ extern unsigned char GEOS_DLL *GEOSGeomToHEX_buf(const GEOSGeometry* g, size_t *
  */
 extern GEOSCoordSequence GEOS_DLL *GEOSCoordSeq_create(unsigned int size, unsigned int dims);
 
+/*
+ * Specify whether GEOSCoordSeq_create makes packed XY sequences
+ * when asked for 2 dimensions. Return the previous setting.
+ */
+extern int GEOS_DLL GEOS_getPackedXYCoordSeq();
+extern int GEOS_DLL GEOS_setPackedXYCoordSeq(int enable);
+
 /*
  * Clone a Coordinate Sequence.
  * Return NULL on exception.
@@ -1268,6 +1748,14 @@ extern int GEOS_DLL GEOSCoordSeq_getSize(const GEOSCoordSequence* s,
     unsigned int *size);
 extern int GEOS_DLL GEOSCoordSeq_getDimensions(const GEOSCoordSequence* s,
     unsigned int *dims);
+extern GEOSCoordSequence GEOS_DLL *GEOSCoordSeq_copyFromBuffer(
+    const double* buf, unsigned int size, unsigned int dims,
+    unsigned int stride);
+extern int GEOS_DLL GEOSCoordSeq_copyToBuffer(const GEOSCoordSequence* s,
+    double* buf, unsigned int dims, unsigned int stride);
+extern GEOSCoordSequence GEOS_DLL *GEOSCoordSeq_createBorrowed(
+    const double* buf, unsigned int size, unsigned int dims,
+    unsigned int stride);
 
 /************************************************************************
  *
@@ -1390,6 +1878,15 @@ extern GEOSGeometry GEOS_DLL *GEOSGeom_createPolygon(GEOSGeometry* shell,
 extern GEOSGeometry GEOS_DLL *GEOSGeom_createCollection(int type,
     GEOSGeometry* *geoms, unsigned int ngeoms);
 extern GEOSGeometry GEOS_DLL *GEOSGeom_createEmptyCollection(int type);
+extern GEOSGeometry GEOS_DLL *GEOSGeom_createLinearRingFromBuffer(
+    const double* buf, unsigned int size, unsigned int dims,
+    unsigned int stride);
+extern GEOSGeometry GEOS_DLL *GEOSGeom_createLineStringFromBuffer(
+    const double* buf, unsigned int size, unsigned int dims,
+    unsigned int stride);
+extern GEOSGeometry GEOS_DLL *GEOSGeom_createPolygonFromBuffer(
+    const double* buf, const unsigned int* ringSizes, unsigned int nrings,
+    unsigned int dims, unsigned int stride);
 
 extern GEOSGeometry GEOS_DLL *GEOSGeom_clone(const GEOSGeometry* g);
 
@@ -1580,6 +2077,10 @@ extern char GEOS_DLL GEOSPreparedWithin(const GEOSPreparedGeometry* pg1, const G
  */
 
 extern GEOSSTRtree GEOS_DLL *GEOSSTRtree_create(size_t nodeCapacity);
+extern GEOSSTRtree GEOS_DLL *GEOSSTRtree_createThreaded(size_t nodeCapacity,
+                                                       size_t numThreads);
+extern GEOSSTRtree GEOS_DLL *GEOSSTRtree_createHilbert(size_t nodeCapacity);
+extern GEOSSTRtree GEOS_DLL *GEOSSTRtree_createRStar(size_t maxEntries);
 extern void GEOS_DLL GEOSSTRtree_insert(GEOSSTRtree *tree,
                                         const GEOSGeometry *g,
                                         void *item);
@@ -1587,13 +2088,45 @@ extern void GEOS_DLL GEOSSTRtree_query(GEOSSTRtree *tree,
                                        const GEOSGeometry *g,
                                        GEOSQueryCallback callback,
                                        void *userdata);
+extern GEOSQueryHit GEOS_DLL *GEOSSTRtree_queryBatch(GEOSSTRtree *tree,
+                                       const GEOSGeometry *const *geoms,
+                                       size_t numGeoms,
+                                       size_t numThreads,
+                                       size_t *numHits);
+extern int GEOS_DLL GEOSSTRtree_join(GEOSSTRtree *tree1,
+                                     GEOSSTRtree *tree2,
+                                     size_t numThreads,
+                                     GEOSJoinCallback callback,
+                                     void *userdata);
 extern void GEOS_DLL GEOSSTRtree_iterate(GEOSSTRtree *tree,
                                        GEOSQueryCallback callback,
                                        void *userdata);
 extern char GEOS_DLL GEOSSTRtree_remove(GEOSSTRtree *tree,
                                         const GEOSGeometry *g,
                                         void *item);
+extern const void GEOS_DLL *GEOSSTRtree_nearest(GEOSSTRtree *tree,
+                                        const void *item,
+                                        const GEOSGeometry *itemEnvelope,
+                                        GEOSDistanceCallback distancefn,
+                                        void *userdata);
+extern int GEOS_DLL GEOSSTRtree_nearestK(GEOSSTRtree *tree,
+                                        const void *item,
+                                        const GEOSGeometry *itemEnvelope,
+                                        size_t k,
+                                        GEOSDistanceCallback distancefn,
+                                        void *userdata,
+                                        const void **results);
 extern void GEOS_DLL GEOSSTRtree_destroy(GEOSSTRtree *tree);
+extern int GEOS_DLL GEOSSTRtree_writeSnapshot(GEOSSTRtree *tree,
+                                              const char *filename,
+                                              GEOSItemIdCallback idfn,
+                                              void *userdata);
+extern GEOSSTRtreeSnapshot GEOS_DLL *GEOSSTRtreeSnapshot_open(const char *filename);
+extern int GEOS_DLL GEOSSTRtreeSnapshot_query(const GEOSSTRtreeSnapshot *snapshot,
+                                              const GEOSGeometry *g,
+                                              GEOSSnapshotQueryCallback callback,
+                                              void *userdata);
+extern void GEOS_DLL GEOSSTRtreeSnapshot_destroy(GEOSSTRtreeSnapshot *snapshot);
 
 
 /************************************************************************
@@ -1834,9 +2367,53 @@ extern void GEOS_DLL GEOSWKBWriter_setByteOrder(GEOSWKBWriter* writer, int byteO
 extern char GEOS_DLL GEOSWKBWriter_getIncludeSRID(const GEOSWKBWriter* writer);
 extern void GEOS_DLL GEOSWKBWriter_setIncludeSRID(GEOSWKBWriter* writer, const char writeSRID);
 
+/* GeoJSON Reader */
+extern GEOSGeoJSONReader GEOS_DLL *GEOSGeoJSONReader_create();
+extern void GEOS_DLL GEOSGeoJSONReader_destroy(GEOSGeoJSONReader* reader);
+extern GEOSGeometry GEOS_DLL *GEOSGeoJSONReader_read(GEOSGeoJSONReader* reader, const char *json, size_t size);
+extern GEOSGeoJSONFeatures GEOS_DLL *GEOSGeoJSONReader_readFeatures(GEOSGeoJSONReader* reader, const char *json, size_t size);
+extern int GEOS_DLL GEOSGeoJSONFeatures_getNumFeatures(const GEOSGeoJSONFeatures* features);
+extern const GEOSGeometry GEOS_DLL *GEOSGeoJSONFeatures_getGeometry(const GEOSGeoJSONFeatures* features, int n);
+extern GEOSGeometry GEOS_DLL *GEOSGeoJSONFeatures_releaseGeometry(GEOSGeoJSONFeatures* features, int n);
+extern const char GEOS_DLL *GEOSGeoJSONFeatures_getProperties(const GEOSGeoJSONFeatures* features, int n, size_t *size);
+extern const char GEOS_DLL *GEOSGeoJSONFeatures_getId(const GEOSGeoJSONFeatures* features, int n, size_t *size);
+extern void GEOS_DLL GEOSGeoJSONFeatures_destroy(GEOSGeoJSONFeatures* features);
+
+/* GeoJSON Writer */
+extern GEOSGeoJSONWriter GEOS_DLL *GEOSGeoJSONWriter_create();
+extern void GEOS_DLL GEOSGeoJSONWriter_destroy(GEOSGeoJSONWriter* writer);
+extern char GEOS_DLL *GEOSGeoJSONWriter_write(GEOSGeoJSONWriter* writer, const GEOSGeometry* g);
+extern void GEOS_DLL GEOSGeoJSONWriter_setOutputDimension(GEOSGeoJSONWriter *writer, int dim);
+
+/* TWKB Reader */
+extern GEOSTWKBReader GEOS_DLL *GEOSTWKBReader_create();
+extern void GEOS_DLL GEOSTWKBReader_destroy(GEOSTWKBReader* reader);
+extern GEOSGeometry GEOS_DLL *GEOSTWKBReader_read(GEOSTWKBReader* reader, const unsigned char *twkb, size_t size);
+extern GEOSGeometry GEOS_DLL *GEOSTWKBReader_readWithIds(GEOSTWKBReader* reader, const unsigned char *twkb, size_t size, int64_t **ids, size_t *numIds);
+
+/* TWKB Writer */
+extern GEOSTWKBWriter GEOS_DLL *GEOSTWKBWriter_create();
+extern void GEOS_DLL GEOSTWKBWriter_destroy(GEOSTWKBWriter* writer);
+
+/* The caller owns the results for these two methods! */
+extern unsigned char GEOS_DLL *GEOSTWKBWriter_write(GEOSTWKBWriter* writer, const GEOSGeometry* g, size_t *size);
+extern unsigned char GEOS_DLL *GEOSTWKBWriter_writeWithIds(GEOSTWKBWriter* writer, const GEOSGeometry* g, const int64_t *ids, size_t *size);
+
+extern int GEOS_DLL GEOSTWKBWriter_getOutputDimension(const GEOSTWKBWriter* writer);
+extern void GEOS_DLL GEOSTWKBWriter_setOutputDimension(GEOSTWKBWriter* writer, int newDimension);
+extern int GEOS_DLL GEOSTWKBWriter_getPrecision(const GEOSTWKBWriter* writer);
+extern void GEOS_DLL GEOSTWKBWriter_setPrecision(GEOSTWKBWriter* writer, int precision);
+extern int GEOS_DLL GEOSTWKBWriter_getPrecisionZ(const GEOSTWKBWriter* writer);
+extern void GEOS_DLL GEOSTWKBWriter_setPrecisionZ(GEOSTWKBWriter* writer, int precision);
+extern char GEOS_DLL GEOSTWKBWriter_getIncludeBBox(const GEOSTWKBWriter* writer);
+extern void GEOS_DLL GEOSTWKBWriter_setIncludeBBox(GEOSTWKBWriter* writer, const char writeBBox);
+extern char GEOS_DLL GEOSTWKBWriter_getIncludeSize(const GEOSTWKBWriter* writer);
+extern void GEOS_DLL GEOSTWKBWriter_setIncludeSize(GEOSTWKBWriter* writer, const char writeSize);
+
 /*
  * Free buffers returned by stuff like GEOSWKBWriter_write(),
- * GEOSWKBWriter_writeHEX() and GEOSWKTWriter_write().
+ * GEOSWKBWriter_writeHEX(), GEOSWKTWriter_write(),
+ * GEOSGeoJSONWriter_write() and GEOSTWKBWriter_write().
  */
 extern void GEOS_DLL GEOSFree(void *buffer);
 
@@ -31,15 +31,30 @@
 #include <geos/geom/PrecisionModel.h> 
 #include <geos/geom/GeometryFactory.h> 
 #include <geos/geom/CoordinateSequenceFactory.h> 
+#include <geos/geom/BorrowedCoordinateSequence.h>
+#include <geos/geom/PackedXYCoordinateSequence.h>
+#include <geos/geom/PackedXYCoordinateSequenceFactory.h>
 #include <geos/geom/Coordinate.h> 
 #include <geos/geom/IntersectionMatrix.h> 
 #include <geos/geom/Envelope.h> 
 #include <geos/index/strtree/STRtree.h> 
+#include <geos/index/strtree/STRtreeSnapshot.h>
+#include <geos/index/hilbertrtree/HilbertRtree.h>
+#include <geos/index/rstartree/RStarTree.h>
+#include <geos/index/strtree/GeometryItemDistance.h>
+#include <geos/index/strtree/ItemBoundable.h>
 #include <geos/index/ItemVisitor.h>
+#include <geos/index/ItemPairVisitor.h>
+#include <geos/index/SpatialIndex.h>
 #include <geos/io/WKTReader.h>
 #include <geos/io/WKBReader.h>
 #include <geos/io/WKTWriter.h>
 #include <geos/io/WKBWriter.h>
+#include <geos/io/GeoJSON.h>
+#include <geos/io/GeoJSONReader.h>
+#include <geos/io/GeoJSONWriter.h>
+#include <geos/io/TWKBReader.h>
+#include <geos/io/TWKBWriter.h>
 #include <geos/algorithm/distance/DiscreteHausdorffDistance.h>
 #include <geos/algorithm/CGAlgorithms.h>
 #include <geos/algorithm/BoundaryNodeRule.h>
@@ -64,14 +79,18 @@
 #include <geos/linearref/LengthIndexedLine.h>
 #include <geos/triangulate/DelaunayTriangulationBuilder.h>
 #include <geos/triangulate/VoronoiDiagramBuilder.h>
+#include <geos/util/Arena.h>
 #include <geos/util/IllegalArgumentException.h>
+#include <geos/util/IllegalStateException.h>
 #include <geos/util/Interrupt.h>
+#include <geos/util/UnsupportedOperationException.h>
 #include <geos/util/UniqueCoordinateArrayFilter.h>
 #include <geos/util/Machine.h>
 #include <geos/version.h> 
 
 // This should go away
 #include <cmath> // finite
+#include <algorithm>
 #include <cstdarg>
 #include <cstddef>
 #include <cstdio>
@@ -81,7 +100,9 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 #include <memory>
+#include <new>
 
 #ifdef _MSC_VER
 #pragma warning(disable : 4099)
@@ -93,11 +114,17 @@
 #define GEOSPreparedGeometry geos::geom::prep::PreparedGeometry
 #define GEOSCoordSequence geos::geom::CoordinateSequence
 #define GEOSBufferParams geos::operation::buffer::BufferParameters
-#define GEOSSTRtree geos::index::strtree::STRtree
+#define GEOSSTRtree geos::index::SpatialIndex
+#define GEOSSTRtreeSnapshot geos::index::strtree::STRtreeSnapshot
 #define GEOSWKTReader_t geos::io::WKTReader
 #define GEOSWKTWriter_t geos::io::WKTWriter
 #define GEOSWKBReader_t geos::io::WKBReader
 #define GEOSWKBWriter_t geos::io::WKBWriter
+#define GEOSGeoJSONReader_t geos::io::GeoJSONReader
+#define GEOSGeoJSONWriter_t geos::io::GeoJSONWriter
+#define GEOSGeoJSONFeatures_t geos::io::GeoJSONFeatureCollection
+#define GEOSTWKBReader_t geos::io::TWKBReader
+#define GEOSTWKBWriter_t geos::io::TWKBWriter
 
 #include "geos_c.h"
 #include "../geos_svn_revision.h"
@@ -126,6 +153,12 @@ using geos::io::WKTReader;
 using geos::io::WKTWriter;
 using geos::io::WKBReader;
 using geos::io::WKBWriter;
+using geos::io::GeoJSONFeature;
+using geos::io::GeoJSONFeatureCollection;
+using geos::io::GeoJSONReader;
+using geos::io::GeoJSONWriter;
+using geos::io::TWKBReader;
+using geos::io::TWKBWriter;
 
 using geos::operation::overlay::OverlayOp;
 using geos::operation::overlay::overlayOp;
@@ -149,6 +182,9 @@ typedef struct GEOSContextHandle_HS
     void *errorData;
     int WKBOutputDims;
     int WKBByteOrder;
+    int packedXYCoordSeq;
+    geos::util::Arena *arena;
+    GeometryFactory *arenaFactory;
     int initialized;
 
     GEOSContextHandle_HS()
@@ -165,11 +201,21 @@ typedef struct GEOSContextHandle_HS
       geomFactory = GeometryFactory::getDefaultInstance();
       WKBOutputDims = 2;
       WKBByteOrder = getMachineByteOrder();
+      packedXYCoordSeq = 0;
+      arena = 0;
+      arenaFactory = 0;
       setNoticeHandler(NULL);
       setErrorHandler(NULL);
       initialized = 1;
     }
 
+    ~GEOSContextHandle_HS()
+    {
+      // Geometries of the arena go before the factory they use
+      delete arena;
+      delete arenaFactory;
+    }
+
     GEOSMessageHandler
     setNoticeHandler(GEOSMessageHandler nf)
     {
@@ -268,6 +314,49 @@ class CAPI_ItemVisitor : public geos::index::ItemVisitor {
     void visitItem (void *item) { callback(item, userdata); }
 };
 
+// CAPI_ItemPairVisitor is used internally by the CAPI STRtree join
+class CAPI_ItemPairVisitor : public geos::index::ItemPairVisitor {
+    GEOSJoinCallback callback;
+    void *userdata;
+  public:
+    CAPI_ItemPairVisitor (GEOSJoinCallback cb, void *ud)
+        : ItemPairVisitor(), callback(cb), userdata(ud) {}
+    void visitItemPair (void *item1, void *item2)
+    {
+        callback(item1, item2, userdata);
+    }
+};
+
+// CAPI_ItemDistance is used internally by the CAPI STRtree
+// nearest neighbour wrappers.
+class CAPI_ItemDistance : public geos::index::strtree::ItemDistance {
+    GEOSDistanceCallback distancefn;
+    void *userdata;
+  public:
+    CAPI_ItemDistance (GEOSDistanceCallback df, void *ud)
+        : ItemDistance(), distancefn(df), userdata(ud) {}
+    double distance (const geos::index::strtree::ItemBoundable *item1,
+                     const geos::index::strtree::ItemBoundable *item2)
+    {
+        double d;
+        if ( ! distancefn(item1->getItem(), item2->getItem(), &d, userdata) )
+        {
+            throw std::runtime_error("Failed to compute distance.");
+        }
+        return d;
+    }
+};
+
+// CAPI_ItemIdentifier is used internally by GEOSSTRtree_writeSnapshot.
+class CAPI_ItemIdentifier : public geos::index::strtree::STRtreeSnapshot::ItemIdentifier {
+    GEOSItemIdCallback idfn;
+    void *userdata;
+  public:
+    CAPI_ItemIdentifier (GEOSItemIdCallback fn, void *ud)
+        : ItemIdentifier(), idfn(fn), userdata(ud) {}
+    int64 getId (void *item) { return idfn(item, userdata); }
+};
+
 
 //## PROTOTYPES #############################################
 
@@ -302,6 +391,76 @@ char* gstrdup(std::string const& str)
     return gstrdup_s(str.c_str(), str.size());
 }
 
+// Copy a byte buffer to memory the caller frees with GEOSFree
+unsigned char* bufdup(std::vector<unsigned char> const& buf, std::size_t *size)
+{
+    unsigned char* out = static_cast<unsigned char*>(malloc(buf.size() + 1));
+    if (0 == out)
+    {
+        throw(std::runtime_error("Failed to allocate memory for duplicate buffer"));
+    }
+
+    if ( ! buf.empty() ) std::memcpy(out, &buf[0], buf.size());
+    *size = buf.size();
+    return out;
+}
+
+void checkBufferLayout(unsigned int dims, unsigned int stride)
+{
+    if ( dims < 2 || dims > 3 )
+        throw IllegalArgumentException("Buffer dimensions must be 2 or 3");
+    if ( stride < dims )
+        throw IllegalArgumentException("Buffer stride is less than its dimensions");
+}
+
+// Build a sequence from ``size'' points of an interleaved buffer,
+// as GEOSCoordSeq_create_r would make it
+CoordinateSequence*
+coordSeqFromBuffer(const GEOSContextHandleInternal_t *handle,
+                   const double *buf, std::size_t size,
+                   unsigned int dims, unsigned int stride)
+{
+    using geos::geom::Coordinate;
+    using geos::geom::PackedXYCoordinateSequence;
+
+    checkBufferLayout(dims, stride);
+
+    if ( handle->packedXYCoordSeq && 2 == dims )
+    {
+        if ( 2 == stride )
+            return new PackedXYCoordinateSequence(buf, size);
+
+        std::vector<double> xy(2 * size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            xy[2 * i] = buf[i * stride];
+            xy[2 * i + 1] = buf[i * stride + 1];
+        }
+        return new PackedXYCoordinateSequence(xy.empty() ? 0 : &xy[0], size);
+    }
+
+    std::vector<Coordinate> *coords = new std::vector<Coordinate>(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const double *p = buf + i * stride;
+        Coordinate &c = (*coords)[i];
+        c.x = p[0];
+        c.y = p[1];
+        if ( 3 == dims ) c.z = p[2];
+    }
+
+    const GeometryFactory *gf = handle->geomFactory;
+    return gf->getCoordinateSequenceFactory()->create(coords, dims);
+}
+
+const GeoJSONFeature&
+getGeoJSONFeature(const GeoJSONFeatureCollection *features, int n)
+{
+    if ( n < 0 || static_cast<std::size_t>(n) >= features->getSize() )
+        throw IllegalArgumentException("Feature index out of range");
+    return features->getFeature(n);
+}
+
 } // namespace anonymous
 
 extern "C" {
@@ -394,6 +553,95 @@ GEOS_finish_r(GEOSContextHandle_t extHandle)
     finishGEOS_r(extHandle);
 }
 
+int
+GEOSArena_begin_r(GEOSContextHandle_t extHandle)
+{
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    try
+    {
+        if ( handle->geomFactory == handle->arenaFactory )
+        {
+            throw geos::util::IllegalStateException("Arena scope is already open");
+        }
+
+        // The arena and its factory are kept once made: readers made
+        // in a scope still refer to the factory
+        if ( ! handle->arena )
+        {
+            std::auto_ptr<geos::util::Arena> arena(new geos::util::Arena());
+            handle->arenaFactory = new GeometryFactory(handle->geomFactory,
+                arena.get());
+            handle->arena = arena.release();
+        }
+
+        handle->arenaFactory->setArena(handle->arena);
+        handle->geomFactory = handle->arenaFactory;
+        return 1;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 0;
+}
+
+int
+GEOSArena_release_r(GEOSContextHandle_t extHandle)
+{
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    try
+    {
+        if ( ! handle->arenaFactory || handle->geomFactory != handle->arenaFactory )
+        {
+            throw geos::util::IllegalStateException("Arena scope is not open");
+        }
+
+        // Detached, the factory allocates from the heap until the
+        // next scope
+        handle->arena->release();
+        handle->arenaFactory->setArena(0);
+        handle->geomFactory = handle->arenaFactory->getCloneFactory();
+        return 1;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 0;
+}
+
 void 
 GEOSFree_r (GEOSContextHandle_t extHandle, void* buffer) 
 { 
@@ -1455,12 +1703,8 @@ GEOSGeomFromWKB_buf_r(GEOSContextHandle_t extHandle, const unsigned char *wkb, s
     using geos::io::WKBReader;
     try
     {
-        std::string wkbstring(reinterpret_cast<const char*>(wkb), size); // make it binary !
         WKBReader r(*(static_cast<GeometryFactory const*>(handle->geomFactory)));
-        std::istringstream is(std::ios_base::binary);
-        is.str(wkbstring);
-        is.seekg(0, std::ios::beg); // rewind reader pointer
-        Geometry *g = r.read(is);
+        Geometry *g = r.read(wkb, size);
         return g;
     }
     catch (const std::exception &e)
@@ -3635,6 +3879,11 @@ GEOSCoordSeq_create_r(GEOSContextHandle_t extHandle, unsigned int size, unsigned
 
     try
     {
+        if ( handle->packedXYCoordSeq && 2 == dims )
+        {
+            using geos::geom::PackedXYCoordinateSequenceFactory;
+            return PackedXYCoordinateSequenceFactory::instance()->create(size, dims);
+        }
         const GeometryFactory *gf = handle->geomFactory;
         return gf->getCoordinateSequenceFactory()->create(size, dims);
     }
@@ -3650,6 +3899,45 @@ GEOSCoordSeq_create_r(GEOSContextHandle_t extHandle, unsigned int size, unsigned
     return NULL;
 }
 
+int
+GEOS_getPackedXYCoordSeq_r(GEOSContextHandle_t extHandle)
+{
+    if ( 0 == extHandle )
+    {
+        return -1;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return -1;
+    }
+
+    return handle->packedXYCoordSeq;
+}
+
+int
+GEOS_setPackedXYCoordSeq_r(GEOSContextHandle_t extHandle, int enable)
+{
+    if ( 0 == extHandle )
+    {
+        return -1;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return -1;
+    }
+
+    const int old = handle->packedXYCoordSeq;
+    handle->packedXYCoordSeq = enable ? 1 : 0;
+
+    return old;
+}
+
 int
 GEOSCoordSeq_setOrdinate_r(GEOSContextHandle_t extHandle, CoordinateSequence *cs,
                            unsigned int idx, unsigned int dim, double val)
@@ -3865,6 +4153,148 @@ GEOSCoordSeq_getDimensions_r(GEOSContextHandle_t extHandle, const CoordinateSequ
     return 0;
 }
 
+CoordinateSequence *
+GEOSCoordSeq_copyFromBuffer_r(GEOSContextHandle_t extHandle, const double *buf,
+                              unsigned int size, unsigned int dims,
+                              unsigned int stride)
+{
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        return coordSeqFromBuffer(handle, buf, size, dims, stride);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return NULL;
+}
+
+int
+GEOSCoordSeq_copyToBuffer_r(GEOSContextHandle_t extHandle,
+                            const CoordinateSequence *cs, double *buf,
+                            unsigned int dims, unsigned int stride)
+{
+    assert(0 != cs);
+    assert(0 != buf);
+
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    try
+    {
+        using geos::geom::Coordinate;
+        using geos::geom::PackedXYCoordinateSequence;
+
+        checkBufferLayout(dims, stride);
+
+        const std::size_t size = cs->getSize();
+
+        // Packed sequences are copied straight from their array
+        const PackedXYCoordinateSequence *pcs =
+            dynamic_cast<const PackedXYCoordinateSequence *>(cs);
+        if ( pcs )
+        {
+            const double *xy = pcs->data();
+            if ( 2 == stride )
+            {
+                if ( size ) std::memcpy(buf, xy, 2 * size * sizeof(double));
+                return 1;
+            }
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                double *p = buf + i * stride;
+                p[0] = xy[2 * i];
+                p[1] = xy[2 * i + 1];
+                if ( 3 == dims ) p[2] = DoubleNotANumber;
+            }
+            return 1;
+        }
+
+        const std::vector<Coordinate> *coords = cs->toVector();
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const Coordinate &c = (*coords)[i];
+            double *p = buf + i * stride;
+            p[0] = c.x;
+            p[1] = c.y;
+            if ( 3 == dims ) p[2] = c.z;
+        }
+        return 1;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 0;
+}
+
+CoordinateSequence *
+GEOSCoordSeq_createBorrowed_r(GEOSContextHandle_t extHandle, const double *buf,
+                              unsigned int size, unsigned int dims,
+                              unsigned int stride)
+{
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        using geos::geom::BorrowedCoordinateSequence;
+
+        checkBufferLayout(dims, stride);
+        return new BorrowedCoordinateSequence(buf, size, dims, stride);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return NULL;
+}
+
 void
 GEOSCoordSeq_destroy_r(GEOSContextHandle_t extHandle, CoordinateSequence *s)
 {
@@ -4194,7 +4624,149 @@ GEOSGeom_createPolygon_r(GEOSContextHandle_t extHandle, Geometry *shell, Geometr
 }
 
 Geometry *
-GEOSGeom_clone_r(GEOSContextHandle_t extHandle, const Geometry *g)
+GEOSGeom_createLinearRingFromBuffer_r(GEOSContextHandle_t extHandle,
+                                      const double *buf, unsigned int size,
+                                      unsigned int dims, unsigned int stride)
+{
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        const GeometryFactory *gf = handle->geomFactory;
+        CoordinateSequence *cs = coordSeqFromBuffer(handle, buf, size, dims, stride);
+
+        return gf->createLinearRing(cs);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return NULL;
+}
+
+Geometry *
+GEOSGeom_createLineStringFromBuffer_r(GEOSContextHandle_t extHandle,
+                                      const double *buf, unsigned int size,
+                                      unsigned int dims, unsigned int stride)
+{
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        const GeometryFactory *gf = handle->geomFactory;
+        CoordinateSequence *cs = coordSeqFromBuffer(handle, buf, size, dims, stride);
+
+        return gf->createLineString(cs);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return NULL;
+}
+
+Geometry *
+GEOSGeom_createPolygonFromBuffer_r(GEOSContextHandle_t extHandle,
+                                   const double *buf,
+                                   const unsigned int *ringSizes,
+                                   unsigned int nrings,
+                                   unsigned int dims, unsigned int stride)
+{
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        using geos::geom::LinearRing;
+
+        const GeometryFactory *gf = handle->geomFactory;
+        if ( 0 == nrings )
+        {
+            return gf->createPolygon();
+        }
+
+        // Rings are built one by one, so that the ones made so far
+        // can be released if a later one is invalid
+        LinearRing *shell = 0;
+        std::vector<Geometry *> *holes = new std::vector<Geometry *>();
+        try
+        {
+            holes->reserve(nrings - 1);
+            const double *p = buf;
+            for (unsigned int i = 0; i < nrings; ++i)
+            {
+                CoordinateSequence *cs = coordSeqFromBuffer(handle, p,
+                        ringSizes[i], dims, stride);
+                LinearRing *ring = gf->createLinearRing(cs);
+                if ( shell ) holes->push_back(ring);
+                else shell = ring;
+                p += static_cast<std::size_t>(ringSizes[i]) * stride;
+            }
+        }
+        catch (...)
+        {
+            delete shell;
+            for (std::size_t i = 0; i < holes->size(); ++i)
+                delete (*holes)[i];
+            delete holes;
+            throw;
+        }
+
+        return gf->createPolygon(shell, holes);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return NULL;
+}
+
+Geometry *
+GEOSGeom_clone_r(GEOSContextHandle_t extHandle, const Geometry *g)
 {
     assert(0 != g);
 
@@ -4776,14 +5348,6 @@ GEOSWKBReader_destroy_r(GEOSContextHandle_t extHandle, WKBReader *reader)
     }
 }
 
-struct membuf : public std::streambuf
-{
-  membuf(char* s, std::size_t n)
-  {
-    setg(s, s, s + n);
-  }
-};
-
 Geometry*
 GEOSWKBReader_read_r(GEOSContextHandle_t extHandle, WKBReader *reader, const unsigned char *wkb, size_t size)
 {
@@ -4804,16 +5368,7 @@ GEOSWKBReader_read_r(GEOSContextHandle_t extHandle, WKBReader *reader, const uns
 
     try
     {
-        //std::string wkbstring(reinterpret_cast<const char*>(wkb), size); // make it binary !
-        //std::istringstream is(std::ios_base::binary);
-        //is.str(wkbstring);
-        //is.seekg(0, std::ios::beg); // rewind reader pointer
-
-        // http://stackoverflow.com/questions/2079912/simpler-way-to-create-a-c-memorystream-from-char-size-t-without-copying-t
-        membuf mb((char*)wkb, size);
-        istream is(&mb);
-
-        Geometry *g = reader->read(is);
+        Geometry *g = reader->read(wkb, size);
         return g;
     }
     catch (const std::exception &e)
@@ -5206,30 +5761,25 @@ GEOSWKBWriter_setIncludeSRID_r(GEOSContextHandle_t extHandle, GEOSWKBWriter* wri
 }
 
 
-//-----------------------------------------------------------------
-// Prepared Geometry 
-//-----------------------------------------------------------------
-
-const geos::geom::prep::PreparedGeometry*
-GEOSPrepare_r(GEOSContextHandle_t extHandle, const Geometry *g)
+/* GeoJSON Reader */
+GEOSGeoJSONReader*
+GEOSGeoJSONReader_create_r(GEOSContextHandle_t extHandle)
 {
     if ( 0 == extHandle )
     {
-        return 0;
+        return NULL;
     }
 
     GEOSContextHandleInternal_t *handle = 0;
     handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
     if ( 0 == handle->initialized )
     {
-        return 0;
+        return NULL;
     }
 
-    const geos::geom::prep::PreparedGeometry* prep = 0;
-
     try
     {
-        prep = geos::geom::prep::PreparedGeometryFactory::prepare(g);
+        return new GeoJSONReader(*(GeometryFactory*)handle->geomFactory);
     }
     catch (const std::exception &e)
     {
@@ -5239,18 +5789,18 @@ GEOSPrepare_r(GEOSContextHandle_t extHandle, const Geometry *g)
     {
         handle->ERROR_MESSAGE("Unknown exception thrown");
     }
-    
-    return prep;
+
+    return NULL;
 }
 
 void
-GEOSPreparedGeom_destroy_r(GEOSContextHandle_t extHandle, const geos::geom::prep::PreparedGeometry *a)
+GEOSGeoJSONReader_destroy_r(GEOSContextHandle_t extHandle, GEOSGeoJSONReader *reader)
 {
     GEOSContextHandleInternal_t *handle = 0;
 
     try
     {
-        delete a;
+        delete reader;
     }
     catch (const std::exception &e)
     {
@@ -5284,29 +5834,26 @@ GEOSPreparedGeom_destroy_r(GEOSContextHandle_t extHandle, const geos::geom::prep
     }
 }
 
-char
-GEOSPreparedContains_r(GEOSContextHandle_t extHandle,
-        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+Geometry*
+GEOSGeoJSONReader_read_r(GEOSContextHandle_t extHandle, GEOSGeoJSONReader *reader, const char *json, size_t size)
 {
-    assert(0 != pg);
-    assert(0 != g);
+    assert(0 != reader);
 
     if ( 0 == extHandle )
     {
-        return 2;
+        return NULL;
     }
 
     GEOSContextHandleInternal_t *handle = 0;
     handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
     if ( 0 == handle->initialized )
     {
-        return 2;
+        return NULL;
     }
 
-    try 
+    try
     {
-        bool result = pg->contains(g);
-        return result;
+        return reader->read(json, size);
     }
     catch (const std::exception &e)
     {
@@ -5316,33 +5863,30 @@ GEOSPreparedContains_r(GEOSContextHandle_t extHandle,
     {
         handle->ERROR_MESSAGE("Unknown exception thrown");
     }
-    
-    return 2;
+
+    return NULL;
 }
 
-char
-GEOSPreparedContainsProperly_r(GEOSContextHandle_t extHandle,
-        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+GEOSGeoJSONFeatures*
+GEOSGeoJSONReader_readFeatures_r(GEOSContextHandle_t extHandle, GEOSGeoJSONReader *reader, const char *json, size_t size)
 {
-    assert(0 != pg);
-    assert(0 != g);
+    assert(0 != reader);
 
     if ( 0 == extHandle )
     {
-        return 2;
+        return NULL;
     }
 
     GEOSContextHandleInternal_t *handle = 0;
     handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
     if ( 0 == handle->initialized )
     {
-        return 2;
+        return NULL;
     }
 
-    try 
+    try
     {
-        bool result = pg->containsProperly(g);
-        return result;
+        return reader->readFeatures(json, size).release();
     }
     catch (const std::exception &e)
     {
@@ -5352,33 +5896,30 @@ GEOSPreparedContainsProperly_r(GEOSContextHandle_t extHandle,
     {
         handle->ERROR_MESSAGE("Unknown exception thrown");
     }
-    
-    return 2;
+
+    return NULL;
 }
 
-char
-GEOSPreparedCoveredBy_r(GEOSContextHandle_t extHandle,
-        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+int
+GEOSGeoJSONFeatures_getNumFeatures_r(GEOSContextHandle_t extHandle, const GEOSGeoJSONFeatures *features)
 {
-    assert(0 != pg);
-    assert(0 != g);
+    assert(0 != features);
 
     if ( 0 == extHandle )
     {
-        return 2;
+        return -1;
     }
 
     GEOSContextHandleInternal_t *handle = 0;
     handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
     if ( 0 == handle->initialized )
     {
-        return 2;
+        return -1;
     }
 
-    try 
+    try
     {
-        bool result = pg->coveredBy(g);
-        return result;
+        return static_cast<int>(features->getSize());
     }
     catch (const std::exception &e)
     {
@@ -5388,33 +5929,30 @@ GEOSPreparedCoveredBy_r(GEOSContextHandle_t extHandle,
     {
         handle->ERROR_MESSAGE("Unknown exception thrown");
     }
-    
-    return 2;
+
+    return -1;
 }
 
-char
-GEOSPreparedCovers_r(GEOSContextHandle_t extHandle,
-        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+const Geometry*
+GEOSGeoJSONFeatures_getGeometry_r(GEOSContextHandle_t extHandle, const GEOSGeoJSONFeatures *features, int n)
 {
-    assert(0 != pg);
-    assert(0 != g);
+    assert(0 != features);
 
     if ( 0 == extHandle )
     {
-        return 2;
+        return NULL;
     }
 
     GEOSContextHandleInternal_t *handle = 0;
     handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
     if ( 0 == handle->initialized )
     {
-        return 2;
+        return NULL;
     }
 
-    try 
+    try
     {
-        bool result = pg->covers(g);
-        return result;
+        return getGeoJSONFeature(features, n).getGeometry();
     }
     catch (const std::exception &e)
     {
@@ -5424,33 +5962,32 @@ GEOSPreparedCovers_r(GEOSContextHandle_t extHandle,
     {
         handle->ERROR_MESSAGE("Unknown exception thrown");
     }
-    
-    return 2;
+
+    return NULL;
 }
 
-char
-GEOSPreparedCrosses_r(GEOSContextHandle_t extHandle,
-        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+Geometry*
+GEOSGeoJSONFeatures_releaseGeometry_r(GEOSContextHandle_t extHandle, GEOSGeoJSONFeatures *features, int n)
 {
-    assert(0 != pg);
-    assert(0 != g);
+    assert(0 != features);
 
     if ( 0 == extHandle )
     {
-        return 2;
+        return NULL;
     }
 
     GEOSContextHandleInternal_t *handle = 0;
     handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
     if ( 0 == handle->initialized )
     {
-        return 2;
+        return NULL;
     }
 
-    try 
+    try
     {
-        bool result = pg->crosses(g);
-        return result;
+        // bounds checked by the const lookup
+        getGeoJSONFeature(features, n);
+        return features->getFeature(n).releaseGeometry().release();
     }
     catch (const std::exception &e)
     {
@@ -5460,33 +5997,33 @@ GEOSPreparedCrosses_r(GEOSContextHandle_t extHandle,
     {
         handle->ERROR_MESSAGE("Unknown exception thrown");
     }
-    
-    return 2;
+
+    return NULL;
 }
 
-char
-GEOSPreparedDisjoint_r(GEOSContextHandle_t extHandle,
-        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+const char*
+GEOSGeoJSONFeatures_getProperties_r(GEOSContextHandle_t extHandle, const GEOSGeoJSONFeatures *features, int n, size_t *size)
 {
-    assert(0 != pg);
-    assert(0 != g);
+    assert(0 != features);
 
     if ( 0 == extHandle )
     {
-        return 2;
+        return NULL;
     }
 
     GEOSContextHandleInternal_t *handle = 0;
     handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
     if ( 0 == handle->initialized )
     {
-        return 2;
+        return NULL;
     }
 
-    try 
+    try
     {
-        bool result = pg->disjoint(g);
-        return result;
+        const std::string &properties =
+            getGeoJSONFeature(features, n).getProperties();
+        if ( size ) *size = properties.size();
+        return properties.c_str();
     }
     catch (const std::exception &e)
     {
@@ -5496,33 +6033,32 @@ GEOSPreparedDisjoint_r(GEOSContextHandle_t extHandle,
     {
         handle->ERROR_MESSAGE("Unknown exception thrown");
     }
-    
-    return 2;
+
+    return NULL;
 }
 
-char
-GEOSPreparedIntersects_r(GEOSContextHandle_t extHandle,
-        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+const char*
+GEOSGeoJSONFeatures_getId_r(GEOSContextHandle_t extHandle, const GEOSGeoJSONFeatures *features, int n, size_t *size)
 {
-    assert(0 != pg);
-    assert(0 != g);
+    assert(0 != features);
 
     if ( 0 == extHandle )
     {
-        return 2;
+        return NULL;
     }
 
     GEOSContextHandleInternal_t *handle = 0;
     handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
     if ( 0 == handle->initialized )
     {
-        return 2;
+        return NULL;
     }
 
-    try 
+    try
     {
-        bool result = pg->intersects(g);
-        return result;
+        const std::string &id = getGeoJSONFeature(features, n).getId();
+        if ( size ) *size = id.size();
+        return id.c_str();
     }
     catch (const std::exception &e)
     {
@@ -5532,9 +6068,1124 @@ GEOSPreparedIntersects_r(GEOSContextHandle_t extHandle,
     {
         handle->ERROR_MESSAGE("Unknown exception thrown");
     }
-    
-    return 2;
-}
+
+    return NULL;
+}
+
+void
+GEOSGeoJSONFeatures_destroy_r(GEOSContextHandle_t extHandle, GEOSGeoJSONFeatures *features)
+{
+    GEOSContextHandleInternal_t *handle = 0;
+
+    try
+    {
+        delete features;
+    }
+    catch (const std::exception &e)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+}
+
+/* GeoJSON Writer */
+GEOSGeoJSONWriter*
+GEOSGeoJSONWriter_create_r(GEOSContextHandle_t extHandle)
+{
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        return new GeoJSONWriter();
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return NULL;
+}
+
+void
+GEOSGeoJSONWriter_destroy_r(GEOSContextHandle_t extHandle, GEOSGeoJSONWriter *writer)
+{
+    GEOSContextHandleInternal_t *handle = 0;
+
+    try
+    {
+        delete writer;
+    }
+    catch (const std::exception &e)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+}
+
+char*
+GEOSGeoJSONWriter_write_r(GEOSContextHandle_t extHandle, GEOSGeoJSONWriter *writer, const Geometry *geom)
+{
+    assert(0 != writer);
+
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        std::string sgeom(writer->write(geom));
+        char *result = gstrdup(sgeom);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return NULL;
+}
+
+void
+GEOSGeoJSONWriter_setOutputDimension_r(GEOSContextHandle_t extHandle, GEOSGeoJSONWriter *writer, int dim)
+{
+    assert(0 != writer);
+
+    if ( 0 == extHandle )
+    {
+        return;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return;
+    }
+
+    try
+    {
+        writer->setOutputDimension(dim);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+}
+
+
+/* TWKB Reader */
+GEOSTWKBReader*
+GEOSTWKBReader_create_r(GEOSContextHandle_t extHandle)
+{
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        return new TWKBReader(*(GeometryFactory*)handle->geomFactory);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return NULL;
+}
+
+void
+GEOSTWKBReader_destroy_r(GEOSContextHandle_t extHandle, GEOSTWKBReader *reader)
+{
+    GEOSContextHandleInternal_t *handle = 0;
+
+    try
+    {
+        delete reader;
+    }
+    catch (const std::exception &e)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+}
+
+Geometry*
+GEOSTWKBReader_read_r(GEOSContextHandle_t extHandle, GEOSTWKBReader *reader, const unsigned char *twkb, size_t size)
+{
+    assert(0 != reader);
+    assert(0 != twkb);
+
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        return reader->read(twkb, size);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return NULL;
+}
+
+Geometry*
+GEOSTWKBReader_readWithIds_r(GEOSContextHandle_t extHandle, GEOSTWKBReader *reader, const unsigned char *twkb, size_t size, int64_t **ids, size_t *numIds)
+{
+    assert(0 != reader);
+    assert(0 != twkb);
+    assert(0 != ids);
+    assert(0 != numIds);
+
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        std::vector<int64> idList;
+        std::auto_ptr<Geometry> g(reader->read(twkb, size, idList));
+
+        int64_t *result = NULL;
+        if ( ! idList.empty() )
+        {
+            result = (int64_t*) malloc(idList.size() * sizeof(int64_t));
+            if ( 0 == result )
+            {
+                throw std::runtime_error("Failed to allocate memory for TWKB ids");
+            }
+            std::copy(idList.begin(), idList.end(), result);
+        }
+        *ids = result;
+        *numIds = idList.size();
+        return g.release();
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return NULL;
+}
+
+/* TWKB Writer */
+GEOSTWKBWriter*
+GEOSTWKBWriter_create_r(GEOSContextHandle_t extHandle)
+{
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        return new TWKBWriter();
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return NULL;
+}
+
+void
+GEOSTWKBWriter_destroy_r(GEOSContextHandle_t extHandle, GEOSTWKBWriter *writer)
+{
+    GEOSContextHandleInternal_t *handle = 0;
+
+    try
+    {
+        delete writer;
+    }
+    catch (const std::exception &e)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+}
+
+/* The caller owns the result */
+unsigned char*
+GEOSTWKBWriter_write_r(GEOSContextHandle_t extHandle, GEOSTWKBWriter *writer, const Geometry *geom, size_t *size)
+{
+    assert(0 != writer);
+    assert(0 != geom);
+    assert(0 != size);
+
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        std::vector<unsigned char> buf;
+        writer->write(*geom, buf);
+        return bufdup(buf, size);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return NULL;
+}
+
+/* The caller owns the result */
+unsigned char*
+GEOSTWKBWriter_writeWithIds_r(GEOSContextHandle_t extHandle, GEOSTWKBWriter *writer, const Geometry *geom, const int64_t *ids, size_t *size)
+{
+    assert(0 != writer);
+    assert(0 != geom);
+    assert(0 != size);
+
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        std::size_t n = geom->getNumGeometries();
+        if ( n && 0 == ids )
+        {
+            throw IllegalArgumentException("TWKB id list must have one id per component");
+        }
+        std::vector<int64> idList(ids, ids + n);
+        std::vector<unsigned char> buf;
+        writer->write(*geom, idList, buf);
+        return bufdup(buf, size);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return NULL;
+}
+
+int
+GEOSTWKBWriter_getOutputDimension_r(GEOSContextHandle_t extHandle, const GEOSTWKBWriter* writer)
+{
+    assert(0 != writer);
+
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    int ret = 0;
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 != handle->initialized )
+    {
+        try
+        {
+            ret = writer->getOutputDimension();
+        }
+        catch (...)
+        {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+    }
+
+    return ret;
+}
+
+void
+GEOSTWKBWriter_setOutputDimension_r(GEOSContextHandle_t extHandle, GEOSTWKBWriter* writer, int newDimension)
+{
+    assert(0 != writer);
+
+    if ( 0 == extHandle )
+    {
+        return;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 != handle->initialized )
+    {
+        try
+        {
+            writer->setOutputDimension(newDimension);
+        }
+        catch (const std::exception &e)
+        {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch (...)
+        {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+    }
+}
+
+int
+GEOSTWKBWriter_getPrecision_r(GEOSContextHandle_t extHandle, const GEOSTWKBWriter* writer)
+{
+    assert(0 != writer);
+
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    int ret = 0;
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 != handle->initialized )
+    {
+        try
+        {
+            ret = writer->getPrecision();
+        }
+        catch (...)
+        {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+    }
+
+    return ret;
+}
+
+void
+GEOSTWKBWriter_setPrecision_r(GEOSContextHandle_t extHandle, GEOSTWKBWriter* writer, int precision)
+{
+    assert(0 != writer);
+
+    if ( 0 == extHandle )
+    {
+        return;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 != handle->initialized )
+    {
+        try
+        {
+            writer->setPrecision(precision);
+        }
+        catch (const std::exception &e)
+        {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch (...)
+        {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+    }
+}
+
+int
+GEOSTWKBWriter_getPrecisionZ_r(GEOSContextHandle_t extHandle, const GEOSTWKBWriter* writer)
+{
+    assert(0 != writer);
+
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    int ret = 0;
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 != handle->initialized )
+    {
+        try
+        {
+            ret = writer->getPrecisionZ();
+        }
+        catch (...)
+        {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+    }
+
+    return ret;
+}
+
+void
+GEOSTWKBWriter_setPrecisionZ_r(GEOSContextHandle_t extHandle, GEOSTWKBWriter* writer, int precision)
+{
+    assert(0 != writer);
+
+    if ( 0 == extHandle )
+    {
+        return;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 != handle->initialized )
+    {
+        try
+        {
+            writer->setPrecisionZ(precision);
+        }
+        catch (const std::exception &e)
+        {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch (...)
+        {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+    }
+}
+
+char
+GEOSTWKBWriter_getIncludeBBox_r(GEOSContextHandle_t extHandle, const GEOSTWKBWriter* writer)
+{
+    assert(0 != writer);
+
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    char ret = 0;
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 != handle->initialized )
+    {
+        try
+        {
+            ret = static_cast<char>(writer->getIncludeBBox());
+        }
+        catch (...)
+        {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+    }
+
+    return ret;
+}
+
+void
+GEOSTWKBWriter_setIncludeBBox_r(GEOSContextHandle_t extHandle, GEOSTWKBWriter* writer, const char newIncludeBBox)
+{
+    assert(0 != writer);
+
+    if ( 0 == extHandle )
+    {
+        return;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 != handle->initialized )
+    {
+        try
+        {
+            writer->setIncludeBBox(0 != newIncludeBBox);
+        }
+        catch (const std::exception &e)
+        {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch (...)
+        {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+    }
+}
+
+char
+GEOSTWKBWriter_getIncludeSize_r(GEOSContextHandle_t extHandle, const GEOSTWKBWriter* writer)
+{
+    assert(0 != writer);
+
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    char ret = 0;
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 != handle->initialized )
+    {
+        try
+        {
+            ret = static_cast<char>(writer->getIncludeSize());
+        }
+        catch (...)
+        {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+    }
+
+    return ret;
+}
+
+void
+GEOSTWKBWriter_setIncludeSize_r(GEOSContextHandle_t extHandle, GEOSTWKBWriter* writer, const char newIncludeSize)
+{
+    assert(0 != writer);
+
+    if ( 0 == extHandle )
+    {
+        return;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 != handle->initialized )
+    {
+        try
+        {
+            writer->setIncludeSize(0 != newIncludeSize);
+        }
+        catch (const std::exception &e)
+        {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch (...)
+        {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+    }
+}
+
+
+//-----------------------------------------------------------------
+// Prepared Geometry 
+//-----------------------------------------------------------------
+
+const geos::geom::prep::PreparedGeometry*
+GEOSPrepare_r(GEOSContextHandle_t extHandle, const Geometry *g)
+{
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    const geos::geom::prep::PreparedGeometry* prep = 0;
+
+    try
+    {
+        prep = geos::geom::prep::PreparedGeometryFactory::prepare(g);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return prep;
+}
+
+void
+GEOSPreparedGeom_destroy_r(GEOSContextHandle_t extHandle, const geos::geom::prep::PreparedGeometry *a)
+{
+    GEOSContextHandleInternal_t *handle = 0;
+
+    try
+    {
+        delete a;
+    }
+    catch (const std::exception &e)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+}
+
+char
+GEOSPreparedContains_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+{
+    assert(0 != pg);
+    assert(0 != g);
+
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try 
+    {
+        bool result = pg->contains(g);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+char
+GEOSPreparedContainsProperly_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+{
+    assert(0 != pg);
+    assert(0 != g);
+
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try 
+    {
+        bool result = pg->containsProperly(g);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+char
+GEOSPreparedCoveredBy_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+{
+    assert(0 != pg);
+    assert(0 != g);
+
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try 
+    {
+        bool result = pg->coveredBy(g);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+char
+GEOSPreparedCovers_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+{
+    assert(0 != pg);
+    assert(0 != g);
+
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try 
+    {
+        bool result = pg->covers(g);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+char
+GEOSPreparedCrosses_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+{
+    assert(0 != pg);
+    assert(0 != g);
+
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try 
+    {
+        bool result = pg->crosses(g);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+char
+GEOSPreparedDisjoint_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+{
+    assert(0 != pg);
+    assert(0 != g);
+
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try 
+    {
+        bool result = pg->disjoint(g);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+char
+GEOSPreparedIntersects_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+{
+    assert(0 != pg);
+    assert(0 != g);
+
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try 
+    {
+        bool result = pg->intersects(g);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
 
 char
 GEOSPreparedOverlaps_r(GEOSContextHandle_t extHandle,
@@ -5644,13 +7295,89 @@ GEOSPreparedWithin_r(GEOSContextHandle_t extHandle,
     return 2;
 }
 
-//-----------------------------------------------------------------
-// STRtree
-//-----------------------------------------------------------------
+//-----------------------------------------------------------------
+// STRtree
+//-----------------------------------------------------------------
+
+geos::index::SpatialIndex *
+GEOSSTRtree_create_r(GEOSContextHandle_t extHandle,
+                                  size_t nodeCapacity)
+{
+    return GEOSSTRtree_createThreaded_r(extHandle, nodeCapacity, 1);
+}
+
+geos::index::SpatialIndex *
+GEOSSTRtree_createThreaded_r(GEOSContextHandle_t extHandle,
+                             size_t nodeCapacity,
+                             size_t numThreads)
+{
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    geos::index::SpatialIndex *tree = 0;
+
+    try
+    {
+        tree = new geos::index::strtree::STRtree(nodeCapacity, numThreads);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return tree;
+}
+
+geos::index::SpatialIndex *
+GEOSSTRtree_createHilbert_r(GEOSContextHandle_t extHandle,
+                            size_t nodeCapacity)
+{
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    geos::index::SpatialIndex *tree = 0;
+
+    try
+    {
+        tree = new geos::index::hilbertrtree::HilbertRtree(nodeCapacity);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return tree;
+}
 
-geos::index::strtree::STRtree *
-GEOSSTRtree_create_r(GEOSContextHandle_t extHandle,
-                                  size_t nodeCapacity)
+geos::index::SpatialIndex *
+GEOSSTRtree_createRStar_r(GEOSContextHandle_t extHandle,
+                          size_t maxEntries)
 {
     if ( 0 == extHandle )
     {
@@ -5664,11 +7391,11 @@ GEOSSTRtree_create_r(GEOSContextHandle_t extHandle,
         return 0;
     }
 
-    geos::index::strtree::STRtree *tree = 0;
+    geos::index::SpatialIndex *tree = 0;
 
     try
     {
-        tree = new geos::index::strtree::STRtree(nodeCapacity);
+        tree = new geos::index::rstartree::RStarTree(maxEntries);
     }
     catch (const std::exception &e)
     {
@@ -5678,13 +7405,13 @@ GEOSSTRtree_create_r(GEOSContextHandle_t extHandle,
     {
         handle->ERROR_MESSAGE("Unknown exception thrown");
     }
-    
+
     return tree;
 }
 
 void
 GEOSSTRtree_insert_r(GEOSContextHandle_t extHandle,
-                     geos::index::strtree::STRtree *tree,
+                     geos::index::SpatialIndex *tree,
                      const geos::geom::Geometry *g,
                      void *item)
 {
@@ -5730,7 +7457,7 @@ GEOSSTRtree_insert_r(GEOSContextHandle_t extHandle,
 
 void 
 GEOSSTRtree_query_r(GEOSContextHandle_t extHandle,
-                    geos::index::strtree::STRtree *tree,
+                    geos::index::SpatialIndex *tree,
                     const geos::geom::Geometry *g,
                     GEOSQueryCallback callback,
                     void *userdata)
@@ -5777,9 +7504,141 @@ GEOSSTRtree_query_r(GEOSContextHandle_t extHandle,
     }
 }
 
+GEOSQueryHit *
+GEOSSTRtree_queryBatch_r(GEOSContextHandle_t extHandle,
+                         geos::index::SpatialIndex *tree,
+                         const geos::geom::Geometry *const *geoms,
+                         size_t numGeoms,
+                         size_t numThreads,
+                         size_t *numHits)
+{
+    assert(0 != tree);
+    assert(0 != geoms || 0 == numGeoms);
+    assert(0 != numHits);
+
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        std::vector<const geos::geom::Envelope*> envs(numGeoms);
+        for ( std::size_t i = 0; i < numGeoms; ++i )
+        {
+            envs[i] = geoms[i] ? geoms[i]->getEnvelopeInternal() : 0;
+        }
+
+        std::vector<geos::index::BatchQueryHit> hits;
+        using geos::index::strtree::STRtree;
+        if ( STRtree *s = dynamic_cast<STRtree*>(tree) )
+        {
+            s->queryBatch(envs, hits, numThreads);
+        }
+        else
+        {
+            // No shared traversal for other index types
+            std::vector<void*> found;
+            for ( std::size_t i = 0; i < numGeoms; ++i )
+            {
+                if ( ! envs[i] ) continue;
+                found.clear();
+                tree->query(envs[i], found);
+                for ( std::size_t j = 0, n = found.size(); j < n; ++j )
+                {
+                    hits.push_back(geos::index::BatchQueryHit(i, found[j]));
+                }
+            }
+        }
+
+        // never ask malloc for 0 bytes, so NULL always means failure
+        std::size_t n = hits.size();
+        GEOSQueryHit *result = static_cast<GEOSQueryHit*>(
+            std::malloc(sizeof(GEOSQueryHit) * (n ? n : 1)));
+        if ( 0 == result )
+        {
+            throw std::bad_alloc();
+        }
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            result[i].queryIndex = hits[i].first;
+            result[i].item = hits[i].second;
+        }
+        *numHits = n;
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return NULL;
+}
+
+int
+GEOSSTRtree_join_r(GEOSContextHandle_t extHandle,
+                   geos::index::SpatialIndex *tree1,
+                   geos::index::SpatialIndex *tree2,
+                   size_t numThreads,
+                   GEOSJoinCallback callback,
+                   void *userdata)
+{
+    assert(0 != tree1);
+    assert(0 != tree2);
+    assert(0 != callback);
+
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    try
+    {
+        using geos::index::strtree::STRtree;
+        STRtree *s1 = dynamic_cast<STRtree*>(tree1);
+        STRtree *s2 = dynamic_cast<STRtree*>(tree2);
+        if ( ! s1 || ! s2 )
+        {
+            throw geos::util::UnsupportedOperationException(
+                "Only trees made by GEOSSTRtree_create can be joined");
+        }
+        CAPI_ItemPairVisitor visitor(callback, userdata);
+        s1->join(*s2, visitor, numThreads);
+        return 1;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 0;
+}
+
 void 
 GEOSSTRtree_iterate_r(GEOSContextHandle_t extHandle,
-                    geos::index::strtree::STRtree *tree,
+                    geos::index::SpatialIndex *tree,
                     GEOSQueryCallback callback,
                     void *userdata)
 {
@@ -5790,7 +7649,26 @@ GEOSSTRtree_iterate_r(GEOSContextHandle_t extHandle,
     try
     {
         CAPI_ItemVisitor visitor(callback, userdata);
-        tree->iterate(visitor);
+        using geos::index::strtree::STRtree;
+        using geos::index::hilbertrtree::HilbertRtree;
+        using geos::index::rstartree::RStarTree;
+        if ( STRtree *s = dynamic_cast<STRtree*>(tree) )
+        {
+            s->iterate(visitor);
+        }
+        else if ( HilbertRtree *h = dynamic_cast<HilbertRtree*>(tree) )
+        {
+            h->iterate(visitor);
+        }
+        else if ( RStarTree *r = dynamic_cast<RStarTree*>(tree) )
+        {
+            r->iterate(visitor);
+        }
+        else
+        {
+            throw geos::util::UnsupportedOperationException(
+                "GEOSSTRtree_iterate: unsupported index type");
+        }
     }
     catch (const std::exception &e)
     {
@@ -5826,7 +7704,7 @@ GEOSSTRtree_iterate_r(GEOSContextHandle_t extHandle,
 
 char
 GEOSSTRtree_remove_r(GEOSContextHandle_t extHandle,
-                     geos::index::strtree::STRtree *tree,
+                     geos::index::SpatialIndex *tree,
                      const geos::geom::Geometry *g,
                      void *item)
 {
@@ -5862,9 +7740,104 @@ GEOSSTRtree_remove_r(GEOSContextHandle_t extHandle,
     return 2;
 }
 
+const void *
+GEOSSTRtree_nearest_r(GEOSContextHandle_t extHandle,
+                      geos::index::SpatialIndex *tree,
+                      const void *item,
+                      const geos::geom::Geometry *itemEnvelope,
+                      GEOSDistanceCallback distancefn,
+                      void *userdata)
+{
+    const void *result = 0;
+    int n = GEOSSTRtree_nearestK_r(extHandle, tree, item, itemEnvelope, 1,
+                                   distancefn, userdata, &result);
+    if ( n != 1 )
+    {
+        return 0;
+    }
+    return result;
+}
+
+int
+GEOSSTRtree_nearestK_r(GEOSContextHandle_t extHandle,
+                       geos::index::SpatialIndex *tree,
+                       const void *item,
+                       const geos::geom::Geometry *itemEnvelope,
+                       size_t k,
+                       GEOSDistanceCallback distancefn,
+                       void *userdata,
+                       const void **results)
+{
+    assert(0 != tree);
+    assert(0 != itemEnvelope);
+    assert(0 != results || 0 == k);
+
+    if ( 0 == extHandle )
+    {
+        return -1;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return -1;
+    }
+
+    try
+    {
+        std::vector<void*> neighbours;
+        CAPI_ItemDistance callbackDist(distancefn, userdata);
+        geos::index::strtree::GeometryItemDistance geometryDist;
+        geos::index::strtree::ItemDistance *itemDist = &geometryDist;
+        if ( distancefn )
+        {
+            itemDist = &callbackDist;
+        }
+
+        using geos::index::strtree::STRtree;
+        using geos::index::hilbertrtree::HilbertRtree;
+        using geos::index::rstartree::RStarTree;
+        const geos::geom::Envelope *env = itemEnvelope->getEnvelopeInternal();
+        if ( STRtree *s = dynamic_cast<STRtree*>(tree) )
+        {
+            s->nearestNeighbours(env, item, itemDist, k, neighbours);
+        }
+        else if ( HilbertRtree *h = dynamic_cast<HilbertRtree*>(tree) )
+        {
+            h->nearestNeighbours(env, item, itemDist, k, neighbours);
+        }
+        else if ( RStarTree *r = dynamic_cast<RStarTree*>(tree) )
+        {
+            r->nearestNeighbours(env, item, itemDist, k, neighbours);
+        }
+        else
+        {
+            throw geos::util::UnsupportedOperationException(
+                "GEOSSTRtree_nearestK: unsupported index type");
+        }
+
+        for ( std::size_t i = 0, n = neighbours.size(); i < n; ++i )
+        {
+            results[i] = neighbours[i];
+        }
+        return static_cast<int>(neighbours.size());
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return -1;
+}
+
 void
 GEOSSTRtree_destroy_r(GEOSContextHandle_t extHandle,
-                      geos::index::strtree::STRtree *tree)
+                      geos::index::SpatialIndex *tree)
 {
     GEOSContextHandleInternal_t *handle = 0;
 
@@ -5904,6 +7877,157 @@ GEOSSTRtree_destroy_r(GEOSContextHandle_t extHandle,
     }
 }
 
+int
+GEOSSTRtree_writeSnapshot_r(GEOSContextHandle_t extHandle,
+                            geos::index::SpatialIndex *tree,
+                            const char *filename,
+                            GEOSItemIdCallback idfn,
+                            void *userdata)
+{
+    assert(0 != tree);
+    assert(0 != filename);
+    assert(0 != idfn);
+
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    try
+    {
+        using geos::index::strtree::STRtree;
+        using geos::index::strtree::STRtreeSnapshot;
+        STRtree *s = dynamic_cast<STRtree*>(tree);
+        if ( ! s )
+        {
+            throw geos::util::UnsupportedOperationException(
+                "Only trees made by GEOSSTRtree_create can be saved");
+        }
+
+        std::ofstream os(filename, std::ios::out | std::ios::binary);
+        if ( ! os )
+        {
+            throw geos::util::GEOSException(
+                std::string("Cannot create ") + filename);
+        }
+        CAPI_ItemIdentifier ids(idfn, userdata);
+        STRtreeSnapshot::write(s->getPackedTree(), ids, os);
+        os.close();
+        if ( ! os )
+        {
+            throw geos::util::GEOSException(
+                std::string("Cannot write ") + filename);
+        }
+        return 1;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 0;
+}
+
+geos::index::strtree::STRtreeSnapshot *
+GEOSSTRtreeSnapshot_open_r(GEOSContextHandle_t extHandle,
+                           const char *filename)
+{
+    assert(0 != filename);
+
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        using geos::index::strtree::STRtreeSnapshot;
+        return STRtreeSnapshot::open(filename).release();
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return NULL;
+}
+
+int
+GEOSSTRtreeSnapshot_query_r(GEOSContextHandle_t extHandle,
+                            const geos::index::strtree::STRtreeSnapshot *snapshot,
+                            const geos::geom::Geometry *g,
+                            GEOSSnapshotQueryCallback callback,
+                            void *userdata)
+{
+    assert(0 != snapshot);
+    assert(0 != g);
+    assert(0 != callback);
+
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    try
+    {
+        std::vector<int64> ids;
+        snapshot->query(*g->getEnvelopeInternal(), ids);
+        for ( std::size_t i = 0, n = ids.size(); i < n; ++i )
+        {
+            callback(ids[i], userdata);
+        }
+        return 1;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 0;
+}
+
+void
+GEOSSTRtreeSnapshot_destroy_r(GEOSContextHandle_t extHandle,
+                              geos::index::strtree::STRtreeSnapshot *snapshot)
+{
+    assert(0 != extHandle);
+
+    delete snapshot;
+}
+
 double
 GEOSProject_r(GEOSContextHandle_t extHandle,
               const Geometry *g,
@@ -17,7 +17,8 @@
 #define GEOS_ALGORITHM_LOCATE_INDEXEDPOINTINAREALOCATOR_H
 
 #include <geos/algorithm/locate/PointOnGeometryLocator.h> // inherited
-#include <geos/index/ItemVisitor.h> // inherited
+#include <geos/index/intervalrtree/ArrayIntervalRTree.h> // composition
+#include <geos/geom/LineSegment.h> // composition
 
 #include <vector> // composition
 
@@ -29,12 +30,6 @@ namespace geos {
 		class Geometry;
 		class Coordinate; 
 		class CoordinateSequence; 
-		class LineSegment;
-	}
-	namespace index {
-		namespace intervalrtree {
-			class SortedPackedIntervalRTree;
-		}
 	}
 }
 
@@ -58,23 +53,29 @@ private:
 	class IntervalIndexedGeometry
 	{
 	private:
-		index::intervalrtree::SortedPackedIntervalRTree * index;
+		// Built once, then only read: locate() can run concurrently
+		index::intervalrtree::ArrayIntervalRTree index;
 
 		void init( const geom::Geometry & g);
-		void addLine( geom::CoordinateSequence * pts);
+		void addLine( const geom::CoordinateSequence * pts);
 
-		// To keep track of allocated LineSegments
-		std::vector< geom::LineSegment* > allocatedSegments;
+		// The indexed segments, stored contiguously
+		std::vector< geom::LineSegment > segments;
 
 	public:
 		IntervalIndexedGeometry( const geom::Geometry & g);
 		~IntervalIndexedGeometry();
 
-		void query(double min, double max, index::ItemVisitor * visitor);
+		template <class Visitor>
+		void query(double min, double max, Visitor & visitor) const
+		{
+			index.query( min, max, visitor);
+		}
 	};
 
 
-	class SegmentVisitor : public index::ItemVisitor
+	// Not an ItemVisitor, so that the index calls it directly
+	class SegmentVisitor
 	{
 	private:
 		algorithm::RayCrossingCounter * counter;
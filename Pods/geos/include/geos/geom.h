@@ -115,12 +115,14 @@ namespace geom { // geos::geom
 } // namespace geos::geom
 } // namespace geos
 
+#include <geos/geom/BorrowedCoordinateSequence.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/CoordinateArraySequence.h>
 #include <geos/geom/CoordinateArraySequenceFactory.h>
 #include <geos/geom/CoordinateFilter.h>
 #include <geos/geom/CoordinateSequence.h>
 #include <geos/geom/CoordinateSequenceFactory.h>
+#include <geos/geom/CoordinateVectorCache.h>
 #include <geos/geom/Dimension.h>
 #include <geos/geom/Envelope.h>
 #include <geos/geom/Geometry.h>
@@ -133,9 +135,14 @@ namespace geom { // geos::geom
 #include <geos/geom/MultiLineString.h>
 #include <geos/geom/MultiPoint.h>
 #include <geos/geom/MultiPolygon.h>
+#include <geos/geom/PackedXYCoordinateSequence.h>
+#include <geos/geom/PackedXYCoordinateSequenceFactory.h>
 #include <geos/geom/Point.h>
+#include <geos/geom/PointCoordinateSequence.h>
 #include <geos/geom/Polygon.h>
 #include <geos/geom/PrecisionModel.h>
+#include <geos/geom/QuantizedCoordinateSequence.h>
+#include <geos/geom/QuantizedCoordinateSequenceFactory.h>
 #include <geos/geom/LineSegment.h>
 #include <geos/geom/IntersectionMatrix.h>
 #include <geos/geom/Location.h>
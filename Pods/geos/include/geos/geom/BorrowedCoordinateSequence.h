@@ -0,0 +1,173 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOM_BORROWEDCOORDINATESEQUENCE_H
+#define GEOS_GEOM_BORROWEDCOORDINATESEQUENCE_H
+
+#include <geos/export.h>
+#include <vector>
+#include <string>
+#include <cstddef>
+
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/CoordinateVectorCache.h> // for composition
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Coordinate;
+	}
+}
+
+namespace geos {
+namespace geom { // geos.geom
+
+/** \brief
+ * A read-only CoordinateSequence over an interleaved array of
+ * doubles owned by someone else, x0, y0[, z0], ...
+ *
+ * The array is not copied: it must stay alive and unchanged for as
+ * long as the sequence, and any Geometry built on it, is in use.
+ *
+ * Mutators throw UnsupportedOperationException. clone() copies the
+ * points into a CoordinateArraySequence, so clones own their data
+ * and can be changed.
+ *
+ * getX(), getY(), getOrdinate(), getAt(std::size_t, Coordinate&)
+ * and expandEnvelope() read the array. getAt(std::size_t),
+ * toVector() and apply_ro() hand out references to Coordinates, so
+ * the first of those calls builds a Coordinate copy of the points,
+ * see CoordinateVectorCache.
+ */
+class GEOS_DLL BorrowedCoordinateSequence : public CoordinateSequence {
+public:
+
+	/**
+	 * @param buf the first ordinate of the first point
+	 * @param size the number of points
+	 * @param dims the number of ordinates of a point, 2 or 3
+	 * @param stride the number of doubles from one point to the
+	 *        next, at least dims
+	 *
+	 * @throw IllegalArgumentException if dims or stride are invalid
+	 */
+	BorrowedCoordinateSequence(const double* buf, std::size_t size,
+			std::size_t dims=2, std::size_t stride=0);
+
+	~BorrowedCoordinateSequence();
+
+	/// Returns a CoordinateArraySequence copy of the points
+	CoordinateSequence *clone() const;
+
+	/// Builds the Coordinate copy of the sequence, see class dox
+	const Coordinate& getAt(std::size_t pos) const;
+
+	/// Copy Coordinate at position i to Coordinate c
+	void getAt(std::size_t i, Coordinate& c) const;
+
+	std::size_t getSize() const { return size; }
+
+	/// Builds the Coordinate copy of the sequence, see class dox
+	const std::vector<Coordinate>* toVector() const;
+
+	void toVector(std::vector<Coordinate>& coords) const;
+
+	bool isEmpty() const { return size == 0; }
+
+	/// @throw UnsupportedOperationException
+	void add(const Coordinate& c);
+
+	/// @throw UnsupportedOperationException
+	void add(const Coordinate& c, bool allowRepeated);
+
+	/// @throw UnsupportedOperationException
+	void add(std::size_t i, const Coordinate& coord, bool allowRepeated);
+
+	/// @throw UnsupportedOperationException
+	void setAt(const Coordinate& c, std::size_t pos);
+
+	/// @throw UnsupportedOperationException
+	void deleteAt(std::size_t pos);
+
+	std::string toString() const;
+
+	/// @throw UnsupportedOperationException
+	void setPoints(const std::vector<Coordinate> &v);
+
+	double getOrdinate(std::size_t index, std::size_t ordinateIndex) const;
+
+	double getX(std::size_t index) const { return buf[stride * index]; }
+
+	double getY(std::size_t index) const { return buf[stride * index + 1]; }
+
+	/// @throw UnsupportedOperationException
+	void setOrdinate(std::size_t index, std::size_t ordinateIndex,
+			double value);
+
+	void expandEnvelope(Envelope &env) const;
+
+	std::size_t getDimension() const { return dims; }
+
+	/// @throw UnsupportedOperationException
+	void apply_rw(const CoordinateFilter *filter);
+
+	/// Builds the Coordinate copy of the sequence, see class dox
+	void apply_ro(CoordinateFilter *filter) const;
+
+	/// @throw UnsupportedOperationException if there are repeated points
+	CoordinateSequence& removeRepeatedPoints();
+
+	const double* getOrdinateArray(std::size_t& s) const
+	{
+		s = stride;
+		return buf;
+	}
+
+	/// The borrowed array, as given to the constructor
+	const double* data() const { return buf; }
+
+	/// The number of doubles from one point to the next
+	std::size_t getStride() const { return stride; }
+
+private:
+
+	static void throwReadOnly();
+
+	const double* buf;
+
+	std::size_t size;
+
+	std::size_t dims;
+
+	std::size_t stride;
+
+	// Coordinate copy of buf, built when needed
+	CoordinateVectorCache coords;
+
+	// Declare type as noncopyable
+	BorrowedCoordinateSequence(const BorrowedCoordinateSequence& other);
+	BorrowedCoordinateSequence& operator=(const BorrowedCoordinateSequence& rhs);
+};
+
+} // namespace geos.geom
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // ndef GEOS_GEOM_BORROWEDCOORDINATESEQUENCE_H
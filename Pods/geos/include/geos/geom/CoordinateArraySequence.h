@@ -33,8 +33,22 @@ namespace geos {
 namespace geos {
 namespace geom { // geos.geom
 
-/// The default implementation of CoordinateSequence
+/** \brief
+ * The default implementation of CoordinateSequence
+ *
+ * Copies, as made by clone(), share the coordinates of the sequence
+ * they are copied from, which are only copied by the first change
+ * made to either of them. Copying is thus cheap, and can be done
+ * from several threads at once.
+ *
+ * As with a std::vector, changing a sequence invalidates references
+ * to its Coordinates obtained before, as from getAt(std::size_t)
+ * or toVector().
+ */
 class GEOS_DLL CoordinateArraySequence : public CoordinateSequence {
+
+	friend class CoordinateArraySequenceFactory;
+
 public:
 
 	CoordinateArraySequence(const CoordinateArraySequence &cl);
@@ -75,7 +89,7 @@ public:
 	bool empty() const { return vect->empty(); }
 
 	/// Reset this CoordinateArraySequence to the empty state
-	void clear() { vect->clear(); }
+	void clear() { detach(); vect->clear(); }
 
 	void add(const Coordinate& c);
 
@@ -105,11 +119,27 @@ public:
 	double getOrdinate(std::size_t index,
 			size_t ordinateIndex) const;
 
+	double getX(std::size_t index) const { return (*vect)[index].x; }
+
+	double getY(std::size_t index) const { return (*vect)[index].y; }
+
 	void setOrdinate(std::size_t index, std::size_t ordinateIndex,
 			double value);
 
 	void expandEnvelope(Envelope &env) const;
 
+	const double* getOrdinateArray(std::size_t& stride) const
+	{
+		if ( vect->empty() ) return 0;
+		stride = sizeof(Coordinate) / sizeof(double);
+		return &(*vect)[0].x;
+	}
+
+	const Coordinate* getCoordinateArray() const
+	{
+		return vect->empty() ? 0 : &(*vect)[0];
+	}
+
     std::size_t getDimension() const;
 
 	void apply_rw(const CoordinateFilter *filter); 
@@ -119,8 +149,27 @@ public:
 	virtual CoordinateSequence& removeRepeatedPoints();
 
 private:
+
+	/// Adds a reference to the coordinates, for a copy to share them
+	long *share() const;
+
+	/// Gives this sequence coordinates of its own, before a change
+	void detach();
+
+	/// Drops this sequence's reference to the coordinates
+	void unshare();
+
 	std::vector<Coordinate> *vect;
-    mutable std::size_t dimension;
+
+	// 0, 2 or 3; not a size_t, to leave room for inArena
+	mutable unsigned int dimension;
+
+	/// Whether the factory placed this sequence in its Arena,
+	/// see util::ArenaAllocated
+	bool inArena;
+
+	// Number of sequences sharing vect, NULL if it never was shared
+	mutable long *refs;
 };
 
 /// This is for backward API compatibility
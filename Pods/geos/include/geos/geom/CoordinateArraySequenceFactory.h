@@ -20,6 +20,7 @@
 #include <vector>
 
 #include <geos/geom/CoordinateSequenceFactory.h> // for inheritance
+#include <geos/util/Arena.h> // for Arena::own
 
 #include <geos/inline.h>
 
@@ -27,6 +28,7 @@
 namespace geos {
 	namespace geom { 
 		class Coordinate;
+		class CoordinateArraySequence;
 	}
 }
 
@@ -39,10 +41,22 @@ namespace geom { // geos::geom
  * \brief
  * Creates CoordinateSequences internally represented as an array of
  * Coordinates.
+ *
+ * A factory given an Arena places the sequence objects there, and
+ * registers them with it; their Coordinates stay on the heap.
  */
 class GEOS_DLL CoordinateArraySequenceFactory: public CoordinateSequenceFactory {
 
 public:
+	CoordinateArraySequenceFactory() : arena(0) {}
+
+	/// @param arena the Arena to use, NULL for the heap; not copied
+	explicit CoordinateArraySequenceFactory(geos::util::Arena *arena)
+		: arena(arena) {}
+
+	/// Sets the Arena to use from now on, NULL for the heap
+	void setArena(geos::util::Arena *newArena) { arena = newArena; }
+
 	CoordinateSequence *create() const;
 
 	CoordinateSequence *create(std::vector<Coordinate> *coords, std::size_t dims=0) const;
@@ -56,6 +70,13 @@ public:
 	 * Returns the singleton instance of CoordinateArraySequenceFactory
 	 */
 	static const CoordinateSequenceFactory *instance();
+
+private:
+
+	geos::util::Arena *arena;
+
+	/// Registers and tags cs with the arena, if any, and returns it
+	CoordinateArraySequence* adopt(CoordinateArraySequence *cs) const;
 };
 
 /// This is for backward API compatibility
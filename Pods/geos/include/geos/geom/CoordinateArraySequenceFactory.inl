@@ -22,32 +22,43 @@
 namespace geos {
 namespace geom { // geos::geom
 
+INLINE CoordinateArraySequence *
+CoordinateArraySequenceFactory::adopt(CoordinateArraySequence *cs) const
+{
+	if ( arena )
+	{
+		arena->own(cs);
+		cs->inArena = true;
+	}
+	return cs;
+}
+
 INLINE CoordinateSequence *
 CoordinateArraySequenceFactory::create() const
 {
-    return new CoordinateArraySequence(
-                reinterpret_cast<std::vector<Coordinate>*>(0), 0);
+    return adopt(new (arena) CoordinateArraySequence(
+                reinterpret_cast<std::vector<Coordinate>*>(0), 0));
 }
 
 INLINE CoordinateSequence *
 CoordinateArraySequenceFactory::create(std::vector<Coordinate> *coords,
 		size_t dimension ) const
 {
-	return new CoordinateArraySequence(coords,dimension);
+	return adopt(new (arena) CoordinateArraySequence(coords,dimension));
 }
 
 INLINE CoordinateSequence *
 CoordinateArraySequenceFactory::create(std::size_t size, std::size_t dimension)
 		const
 {
-	return new CoordinateArraySequence(size,dimension);
+	return adopt(new (arena) CoordinateArraySequence(size,dimension));
 }
 
 INLINE CoordinateSequence *
 CoordinateArraySequenceFactory::create(const CoordinateSequence& seq)
 		const
 {
-	return new CoordinateArraySequence(seq);
+	return adopt(new (arena) CoordinateArraySequence(seq));
 }
 
 
@@ -20,6 +20,7 @@
 #include <geos/inline.h>
 
 #include <geos/geom/Coordinate.h> // for applyCoordinateFilter
+#include <geos/util/Arena.h> // for inheritance
 
 #include <vector>
 #include <iosfwd> // ostream
@@ -56,7 +57,7 @@ namespace geom { // geos::geom
  * will use your CoordinateSequence implementation.
  * 
  */
-class GEOS_DLL CoordinateSequence {
+class GEOS_DLL CoordinateSequence : public geos::util::ArenaAllocated {
 
 protected:
 
@@ -357,6 +358,36 @@ public:
 	 */
 	virtual void expandEnvelope(Envelope &env) const;
 
+	/**
+	 * Gives access to the ordinates of sequences which keep them in
+	 * one array of doubles, point after point.
+	 * Allows algorithms to read coordinate values without going
+	 * through Coordinate references.
+	 *
+	 * @param stride set to the number of doubles from one point
+	 *        to the next, if the array is returned
+	 * @return the X ordinate of the first point, followed by its Y;
+	 *         NULL if the sequence is not stored that way
+	 */
+	virtual const double* getOrdinateArray(std::size_t& stride) const
+	{
+		(void)stride;
+		return 0;
+	}
+
+	/**
+	 * Gives access to the Coordinates of sequences which keep them
+	 * in one array.
+	 *
+	 * @return the first Coordinate of the sequence, followed by the
+	 *         others; NULL if the sequence is empty or not stored
+	 *         that way
+	 */
+	virtual const Coordinate* getCoordinateArray() const
+	{
+		return 0;
+	}
+
 	virtual void apply_rw(const CoordinateFilter *filter)=0; //Abstract
 	virtual void apply_ro(CoordinateFilter *filter) const=0; //Abstract
 
@@ -380,6 +411,75 @@ public:
 		}
 	}
 
+	/** \brief
+	 * Calls f(x, y) for each point of this sequence, in order.
+	 *
+	 * Unlike apply_ro(), which makes a virtual call per point, this
+	 * looks once for the array returned by getOrdinateArray(), and
+	 * reads it in a loop into which f can be inlined. Sequences
+	 * without one are read through getAt(std::size_t, Coordinate&).
+	 */
+	template <class F>
+	void forEachXY(F& f) const
+	{
+		std::size_t n = getSize();
+		std::size_t stride;
+		if ( const double* xy = getOrdinateArray(stride) )
+		{
+			for (std::size_t i=0; i<n; ++i, xy+=stride)
+				f(xy[0], xy[1]);
+			return;
+		}
+
+		Coordinate c;
+		for (std::size_t i=0; i<n; ++i)
+		{
+			getAt(i, c);
+			f(c.x, c.y);
+		}
+	}
+
+	/** \brief
+	 * Calls f(const Coordinate&) for each point of this sequence,
+	 * in order.
+	 *
+	 * Like forEachXY(), but with Z. Sequences returning a
+	 * getCoordinateArray() pass their own Coordinates to f.
+	 */
+	template <class F>
+	void forEachCoordinate(F& f) const
+	{
+		std::size_t n = getSize();
+		if ( const Coordinate* pts = getCoordinateArray() )
+		{
+			for (std::size_t i=0; i<n; ++i)
+				f(pts[i]);
+			return;
+		}
+
+		Coordinate c;
+		std::size_t stride;
+		if ( const double* xy = getOrdinateArray(stride) )
+		{
+			// Z is only there for three-dimensional sequences
+			bool hasZ = stride > 2 && getDimension() > 2;
+			for (std::size_t i=0; i<n; ++i, xy+=stride)
+			{
+				c.x = xy[0];
+				c.y = xy[1];
+				if ( hasZ ) c.z = xy[2];
+				f(static_cast<const Coordinate&>(c));
+			}
+			return;
+		}
+
+		for (std::size_t i=0; i<n; ++i)
+		{
+			getAt(i, c);
+			f(static_cast<const Coordinate&>(c));
+		}
+	}
+
 };
 
 GEOS_DLL std::ostream& operator<< (std::ostream& os, const CoordinateSequence& cs);
@@ -22,6 +22,7 @@
 
 #include <geos/export.h>
 #include <vector>
+#include <memory> // for auto_ptr
 
 //#include <geos/geom/Coordinate.h>
 #include <geos/inline.h>
@@ -72,6 +73,17 @@ public:
             std::vector<Coordinate> *coordinates,
             std::size_t dimension=0 ) const=0;
 
+	/** \brief
+	 * Returns a CoordinateSequence based on the given vector,
+	 * of which it takes ownership.
+	 *
+	 * Same as above: a CoordinateArraySequenceFactory keeps the
+	 * vector rather than copying it.
+	 */
+	std::auto_ptr<CoordinateSequence> create(
+            std::auto_ptr< std::vector<Coordinate> > coordinates,
+            std::size_t dimension=0 ) const;
+
 	/** \brief
 	 * Creates a CoordinateSequence of the specified size and dimension.
 	 *
@@ -0,0 +1,78 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOM_COORDINATEVECTORCACHE_H
+#define GEOS_GEOM_COORDINATEVECTORCACHE_H
+
+#include <geos/export.h>
+#include <geos/geom/Coordinate.h> // for std::vector<Coordinate>
+
+#include <vector>
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class CoordinateSequence;
+	}
+}
+
+namespace geos {
+namespace geom { // geos.geom
+
+/** \brief
+ * The Coordinate copy of a CoordinateSequence which stores its points
+ * in another form.
+ *
+ * CoordinateSequence::getAt(std::size_t), toVector() and apply_ro()
+ * hand out references to Coordinates, which such a sequence takes from
+ * this copy. It is built by the first call to get(), and kept in step
+ * by the changes of the sequence afterwards.
+ *
+ * get() may be called from several threads at once: each may build a
+ * copy, but the first one published is the one all of them use, and
+ * the others are dropped. Changes to the sequence are not synchronised,
+ * as for any Geometry.
+ */
+class GEOS_DLL CoordinateVectorCache {
+
+public:
+
+	CoordinateVectorCache() : vect(0) {}
+
+	~CoordinateVectorCache();
+
+	/**
+	 * \brief
+	 * Returns the copy of seq, building it with
+	 * CoordinateSequence::toVector(std::vector<Coordinate>&) if needed.
+	 */
+	const std::vector<Coordinate>& get(const CoordinateSequence& seq) const;
+
+	/// Returns the copy if it was built, for changes to keep it in step
+	std::vector<Coordinate>* getIfBuilt() { return vect; }
+
+	/// Drops the copy, which the next get() builds again
+	void clear();
+
+private:
+
+	mutable std::vector<Coordinate>* vect;
+
+	// Declare type as noncopyable
+	CoordinateVectorCache(const CoordinateVectorCache& other);
+	CoordinateVectorCache& operator=(const CoordinateVectorCache& rhs);
+};
+
+} // namespace geos.geom
+} // namespace geos
+
+#endif // ndef GEOS_GEOM_COORDINATEVECTORCACHE_H
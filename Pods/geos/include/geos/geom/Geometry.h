@@ -27,6 +27,7 @@
 #include <geos/geom/Envelope.h>
 #include <geos/geom/Dimension.h> // for Dimension::DimensionType
 #include <geos/geom/GeometryComponentFilter.h> // for inheritance
+#include <geos/util/Arena.h> // for inheritance
 
 #include <string>
 #include <iostream>
@@ -164,7 +165,7 @@ enum GeometryTypeId {
  *  remain distinct. This behaviour is desired in many cases.
  *
  */
-class GEOS_DLL Geometry {
+class GEOS_DLL Geometry : public geos::util::ArenaAllocated {
 
 public:
 
@@ -247,6 +248,16 @@ public:
 	 */
 	const PrecisionModel* getPrecisionModel() const;
 
+	/**
+	 * \brief
+	 * Get the Arena this Geometry was allocated from, NULL if it
+	 * was allocated from the heap.
+	 *
+	 * Only Geometries of a GeometryFactory with an Arena can be in
+	 * one.
+	 */
+	geos::util::Arena* getArena() const;
+
 	/// \brief
 	/// Returns a vertex of this Geometry,
 	/// or NULL if this is the empty geometry
@@ -333,6 +344,17 @@ public:
 	 */
 	virtual const Envelope* getEnvelopeInternal() const;
 
+	/** \brief
+	 * Computes the envelopes of this Geometry and of all its
+	 * components, where not computed yet.
+	 *
+	 * getEnvelopeInternal() then makes no change to any of them,
+	 * so that they can be read from several threads at once.
+	 *
+	 * @see GeometryFactory::setEagerEnvelopes
+	 */
+	void computeEnvelopes() const;
+
 	/**
 	 * Tests whether this geometry is disjoint from the specified geometry.
 	 * 
@@ -764,8 +786,15 @@ public:
 
 protected:
 
-	/// The bounding box of this Geometry
-	mutable std::auto_ptr<Envelope> envelope;
+	/// The bounding box of this Geometry, valid if envelopeComputed
+	mutable Envelope envelope;
+
+	/// Whether envelope is up to date with the coordinates
+	mutable bool envelopeComputed;
+
+	/// Whether the factory placed this Geometry in its Arena,
+	/// see util::ArenaAllocated
+	bool inArena;
 	
 	/// Returns true if the array contains any non-empty Geometrys.
 	static bool hasNonEmptyElements(const std::vector<Geometry *>* geometries);
@@ -794,7 +823,7 @@ protected:
 
 	//virtual void checkEqualPrecisionModel(Geometry *other);
 
-	virtual Envelope::AutoPtr computeEnvelopeInternal() const=0; //Abstract
+	virtual Envelope computeEnvelopeInternal() const=0; //Abstract
 
 	virtual int compareToSameClass(const Geometry *geom) const=0; //Abstract
 
@@ -840,6 +869,14 @@ private:
 
 	static GeometryChangedFilter geometryChangedFilter;
 
+	class GEOS_DLL EnvelopeFilter : public GeometryComponentFilter
+	{
+	public:
+		void filter_ro(const Geometry* geom);
+	};
+
+	static EnvelopeFilter envelopeFilter;
+
 	/// The GeometryFactory used to create this Geometry
 	//
 	/// Externally owned
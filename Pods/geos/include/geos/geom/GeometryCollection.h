@@ -190,7 +190,7 @@ protected:
 
 	std::vector<Geometry *>* geometries;
 
-	Envelope::AutoPtr computeEnvelopeInternal() const;
+	Envelope computeEnvelopeInternal() const;
 
 	int compareToSameClass(const Geometry *gc) const;
 
@@ -25,6 +25,7 @@
 #include <geos/geom/MultiPoint.h>
 #include <geos/geom/MultiLineString.h>
 #include <geos/geom/MultiPolygon.h>
+#include <geos/util/Arena.h> // for Arena::own
 #include <geos/export.h>
 #include <geos/inline.h>
 
@@ -34,6 +35,7 @@
 
 namespace geos {
 	namespace geom { 
+		class CoordinateArraySequenceFactory;
 		class CoordinateSequenceFactory;
 		class Coordinate;
 		class CoordinateSequence;
@@ -117,6 +119,28 @@ public:
 	 */
 	GeometryFactory(const PrecisionModel* pm, int newSRID);
 
+	/**
+	 * \brief
+	 * Constructs a GeometryFactory that creates the Geometries of
+	 * base in an Arena.
+	 *
+	 * Geometries are allocated from the arena and registered with
+	 * it, so that releasing the arena destroys those not deleted
+	 * yet. Their coordinate sequences are placed there too if base
+	 * uses the default CoordinateArraySequenceFactory.
+	 *
+	 * Clones of these Geometries are allocated from the heap and
+	 * belong to base, so that they stay valid, and keep allocating
+	 * from the heap, after the arena is released.
+	 *
+	 * The PrecisionModel is copied; base and the arena are not, and
+	 * base must outlive the factory. The arena must be released
+	 * before the factory is destroyed.
+	 *
+	 * @param arena the arena, or NULL to allocate from the heap
+	 */
+	GeometryFactory(const GeometryFactory *base, geos::util::Arena *arena);
+
 	/**
 	 * \brief Copy constructor
 	 *
@@ -161,6 +185,10 @@ public:
 	/// Creates a Point taking ownership of the given CoordinateSequence
 	Point* createPoint(CoordinateSequence *coordinates) const;
 
+	/// Creates a Point taking ownership of the given CoordinateSequence
+	std::auto_ptr<Geometry> createPoint(
+			std::auto_ptr<CoordinateSequence> coordinates) const;
+
 	/// Creates a Point with a deep-copy of the given CoordinateSequence.
 	Point* createPoint(const CoordinateSequence &coordinates) const;
 
@@ -174,6 +202,12 @@ public:
 	GeometryCollection* createGeometryCollection(
 			std::vector<Geometry *> *newGeoms) const;
 
+	/// \brief
+	/// Construct a GeometryCollection taking ownership of given
+	/// vector and Geometries, deleted if construction fails
+	std::auto_ptr<Geometry> createGeometryCollection(
+			std::auto_ptr< std::vector<Geometry *> > newGeoms) const;
+
 	/// Constructs a GeometryCollection with a deep-copy of args
 	GeometryCollection* createGeometryCollection(
 			const std::vector<Geometry *> &newGeoms) const;
@@ -185,6 +219,12 @@ public:
 	MultiLineString* createMultiLineString(
 			std::vector<Geometry *> *newLines) const;
 
+	/// \brief
+	/// Construct a MultiLineString taking ownership of given
+	/// vector and Geometries, deleted if construction fails
+	std::auto_ptr<Geometry> createMultiLineString(
+			std::auto_ptr< std::vector<Geometry *> > newLines) const;
+
 	/// Construct a MultiLineString with a deep-copy of given arguments
 	MultiLineString* createMultiLineString(
 			const std::vector<Geometry *> &fromLines) const;
@@ -195,6 +235,12 @@ public:
 	/// Construct a MultiPolygon taking ownership of given arguments
 	MultiPolygon* createMultiPolygon(std::vector<Geometry *> *newPolys) const;
 
+	/// \brief
+	/// Construct a MultiPolygon taking ownership of given
+	/// vector and Geometries, deleted if construction fails
+	std::auto_ptr<Geometry> createMultiPolygon(
+			std::auto_ptr< std::vector<Geometry *> > newPolys) const;
+
 	/// Construct a MultiPolygon with a deep-copy of given arguments
 	MultiPolygon* createMultiPolygon(
 			const std::vector<Geometry *> &fromPolys) const;
@@ -218,6 +264,12 @@ public:
 	/// Construct a MultiPoint taking ownership of given arguments
 	MultiPoint* createMultiPoint(std::vector<Geometry *> *newPoints) const;
 
+	/// \brief
+	/// Construct a MultiPoint taking ownership of given
+	/// vector and Geometries, deleted if construction fails
+	std::auto_ptr<Geometry> createMultiPoint(
+			std::auto_ptr< std::vector<Geometry *> > newPoints) const;
+
 	/// Construct a MultiPoint with a deep-copy of given arguments
 	MultiPoint* createMultiPoint(
 			const std::vector<Geometry *> &fromPoints) const;
@@ -241,6 +293,12 @@ public:
 	Polygon* createPolygon(LinearRing *shell,
 			std::vector<Geometry *> *holes) const;
 
+	/// \brief
+	/// Construct a Polygon taking ownership of given shell, holes
+	/// vector and holes, deleted if construction fails
+	std::auto_ptr<Geometry> createPolygon(std::auto_ptr<LinearRing> shell,
+			std::auto_ptr< std::vector<Geometry *> > holes) const;
+
 	/// Construct a Polygon with a deep-copy of given arguments
 	Polygon* createPolygon(const LinearRing &shell,
 			const std::vector<Geometry *> &holes) const;
@@ -294,6 +352,12 @@ public:
 	 */
 	Geometry* buildGeometry(std::vector<Geometry *> *geoms) const;
 
+	/// \brief
+	/// As buildGeometry(std::vector<Geometry *>*), deleting the
+	/// vector and its elements if construction fails
+	std::auto_ptr<Geometry> buildGeometry(
+			std::auto_ptr< std::vector<Geometry *> > geoms) const;
+
   /// See buildGeometry(std::vector<Geometry *>&) for semantics
   //
   /// Will clone the geometries accessible trough the iterator.
@@ -377,6 +441,46 @@ public:
 	/// with this GeometryFactory
 	const CoordinateSequenceFactory* getCoordinateSequenceFactory() const;
 
+	/// The Arena Geometries are created in, NULL if none
+	geos::util::Arena* getArena() const { return arena; }
+
+	/**
+	 * \brief
+	 * Sets the Arena Geometries are created in from now on, NULL
+	 * for the heap.
+	 *
+	 * Only for a GeometryFactory constructed for an Arena, which
+	 * is thus detached from it when the arena is released.
+	 */
+	void setArena(geos::util::Arena *newArena);
+
+	/**
+	 * \brief
+	 * Returns the GeometryFactory clones of the Geometries of this
+	 * one belong to: the base of a GeometryFactory constructed for
+	 * an Arena, this one otherwise.
+	 */
+	const GeometryFactory* getCloneFactory() const
+	{
+		return cloneFactory ? cloneFactory : this;
+	}
+
+	/** \brief
+	 * Sets whether Geometries created from now on have their
+	 * envelopes computed on creation, rather than on first use.
+	 *
+	 * Such Geometries are not changed by reading them, so they can
+	 * be read from several threads at once. Changing them and
+	 * calling Geometry::geometryChanged() computes their envelopes
+	 * again.
+	 *
+	 * @see Geometry::computeEnvelopes
+	 */
+	void setEagerEnvelopes(bool eager) { eagerEnvelopes = eager; }
+
+	/// Whether Geometries have their envelopes computed on creation
+	bool hasEagerEnvelopes() const { return eagerEnvelopes; }
+
 	/// Returns a clone of given Geometry.
 	Geometry* createGeometry(const Geometry *g) const;
 
@@ -387,6 +491,24 @@ private:
 	const PrecisionModel* precisionModel;
 	int SRID;
 	const CoordinateSequenceFactory *coordinateListFactory;
+	geos::util::Arena *arena;
+	const GeometryFactory *cloneFactory;
+	CoordinateArraySequenceFactory *arenaSeqFactory;
+	bool eagerEnvelopes;
+
+	/// Registers and tags g with the arena, if any, computes its
+	/// envelopes if eager, and returns it
+	template <class T>
+	T* adopt(T* g) const
+	{
+		if ( arena )
+		{
+			arena->own(g);
+			g->inArena = true;
+		}
+		if ( eagerEnvelopes ) g->computeEnvelopes();
+		return g;
+	}
 };
 
 } // namespace geos::geom
@@ -197,7 +197,7 @@ protected:
 	LineString(CoordinateSequence::AutoPtr pts,
 			const GeometryFactory *newFactory);
 
-	Envelope::AutoPtr computeEnvelopeInternal() const;
+	Envelope computeEnvelopeInternal() const;
 
 	CoordinateSequence::AutoPtr points;
 
@@ -0,0 +1,155 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOM_PACKEDXYCOORDINATESEQUENCE_H
+#define GEOS_GEOM_PACKEDXYCOORDINATESEQUENCE_H
+
+#include <geos/export.h>
+#include <vector>
+#include <string>
+#include <cstddef>
+
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/CoordinateVectorCache.h> // for composition
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Coordinate;
+	}
+}
+
+namespace geos {
+namespace geom { // geos.geom
+
+/** \brief
+ * A two-dimensional CoordinateSequence stored as a packed array of
+ * doubles, x0, y0, x1, y1, ...
+ *
+ * It takes 16 bytes per point instead of the 24 of a Coordinate.
+ * Z is not stored: it reads as NaN and writes to it are ignored.
+ *
+ * getX(), getY(), getOrdinate() and getAt(std::size_t, Coordinate&)
+ * read the packed array. Code which knows it has such a sequence
+ * can read the array itself through data().
+ *
+ * getAt(std::size_t), toVector() and apply_ro() hand out references
+ * to Coordinates, so the first of those calls builds a Coordinate
+ * copy of the whole sequence, see CoordinateVectorCache. Code reading
+ * sequences of unknown type should use the other accessors, or
+ * forEachXY(), to keep the memory saving.
+ *
+ * Predicates, overlay, distance, buffer and the WKT and WKB writers
+ * do so. Methods returning a Coordinate by reference or pointer,
+ * such as LineString::getCoordinateN(), still build the copy, and
+ * so do prepared geometries, convexHull() and IsValidOp, which use
+ * them.
+ */
+class GEOS_DLL PackedXYCoordinateSequence : public CoordinateSequence {
+public:
+
+	/// Construct an empty sequence
+	PackedXYCoordinateSequence();
+
+	/// Construct a sequence of n coordinates at the origin
+	PackedXYCoordinateSequence(std::size_t n);
+
+	/// Construct a sequence copying n points from xy, x0, y0, ...
+	PackedXYCoordinateSequence(const double* xy, std::size_t n);
+
+	PackedXYCoordinateSequence(const PackedXYCoordinateSequence &cl);
+
+	PackedXYCoordinateSequence(const CoordinateSequence &cl);
+
+	~PackedXYCoordinateSequence();
+
+	CoordinateSequence *clone() const;
+
+	/// Builds the Coordinate copy of the sequence, see class dox
+	const Coordinate& getAt(std::size_t pos) const;
+
+	/// Copy Coordinate at position i to Coordinate c
+	void getAt(std::size_t i, Coordinate& c) const;
+
+	std::size_t getSize() const { return xy.size() / 2; }
+
+	/// Builds the Coordinate copy of the sequence, see class dox
+	const std::vector<Coordinate>* toVector() const;
+
+	void toVector(std::vector<Coordinate>& coords) const;
+
+	bool isEmpty() const { return xy.empty(); }
+
+	void add(const Coordinate& c);
+
+	void add(const Coordinate& c, bool allowRepeated);
+
+	void add(std::size_t i, const Coordinate& coord, bool allowRepeated);
+
+	void setAt(const Coordinate& c, std::size_t pos);
+
+	void deleteAt(std::size_t pos);
+
+	std::string toString() const;
+
+	void setPoints(const std::vector<Coordinate> &v);
+
+	double getOrdinate(std::size_t index, std::size_t ordinateIndex) const;
+
+	double getX(std::size_t index) const { return xy[2 * index]; }
+
+	double getY(std::size_t index) const { return xy[2 * index + 1]; }
+
+	void setOrdinate(std::size_t index, std::size_t ordinateIndex,
+			double value);
+
+	void expandEnvelope(Envelope &env) const;
+
+	std::size_t getDimension() const { return 2; }
+
+	void apply_rw(const CoordinateFilter *filter);
+
+	/// Builds the Coordinate copy of the sequence, see class dox
+	void apply_ro(CoordinateFilter *filter) const;
+
+	CoordinateSequence& removeRepeatedPoints();
+
+	const double* getOrdinateArray(std::size_t& s) const
+	{
+		s = 2;
+		return data();
+	}
+
+	/// The packed coordinates, x0, y0, x1, y1, ...; NULL if empty
+	const double* data() const { return xy.empty() ? 0 : &xy[0]; }
+
+private:
+
+	std::vector<double> xy;
+
+	// Coordinate copy of xy, built when needed
+	CoordinateVectorCache coords;
+};
+
+} // namespace geos.geom
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // ndef GEOS_GEOM_PACKEDXYCOORDINATESEQUENCE_H
@@ -0,0 +1,61 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOM_PACKEDXYCOORDINATESEQUENCEFACTORY_H
+#define GEOS_GEOM_PACKEDXYCOORDINATESEQUENCEFACTORY_H
+
+#include <geos/export.h>
+#include <vector>
+
+#include <geos/geom/CoordinateSequenceFactory.h> // for inheritance
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Coordinate;
+	}
+}
+
+namespace geos {
+namespace geom { // geos::geom
+
+/**
+ * \brief
+ * Creates CoordinateSequences holding two-dimensional points in a
+ * packed array of doubles.
+ *
+ * The requested dimension is ignored: Z values are always dropped.
+ *
+ * @see PackedXYCoordinateSequence
+ */
+class GEOS_DLL PackedXYCoordinateSequenceFactory: public CoordinateSequenceFactory {
+
+public:
+	CoordinateSequence *create() const;
+
+	/// Copies the coordinates and deletes the vector
+	CoordinateSequence *create(std::vector<Coordinate> *coords, std::size_t dims=0) const;
+
+	CoordinateSequence *create(std::size_t size, std::size_t dimension=0) const;
+
+	CoordinateSequence *create(const CoordinateSequence &coordSeq) const;
+
+	/** \brief
+	 * Returns the singleton instance of PackedXYCoordinateSequenceFactory
+	 */
+	static const CoordinateSequenceFactory *instance();
+};
+
+} // namespace geos::geom
+} // namespace geos
+
+#endif // ndef GEOS_GEOM_PACKEDXYCOORDINATESEQUENCEFACTORY_H
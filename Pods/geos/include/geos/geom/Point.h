@@ -25,7 +25,7 @@
 #include <geos/platform.h>
 #include <geos/geom/Geometry.h> // for inheritance
 #include <geos/geom/Puntal.h> // for inheritance
-#include <geos/geom/CoordinateSequence.h> // for proper use of auto_ptr<>
+#include <geos/geom/PointCoordinateSequence.h> // for composition
 #include <geos/geom/Envelope.h> // for proper use of auto_ptr<>
 #include <geos/geom/Dimension.h> // for Dimension::DimensionType
 
@@ -44,7 +44,6 @@
 namespace geos {
 	namespace geom { // geos::geom
 		class Coordinate;
-		class CoordinateArraySequence;
 		class CoordinateFilter;
 		class CoordinateSequenceFilter;
 		class GeometryComponentFilter;
@@ -63,6 +62,8 @@ namespace geom { // geos::geom
  * - the coordinate which defines it is a valid coordinate
  *   (i.e does not have an NaN X or Y ordinate)
  *
+ * The coordinate is stored in the Point itself, in a
+ * PointCoordinateSequence: a Point makes no allocation of its own.
  */
 class GEOS_DLL Point : public virtual Geometry, public Puntal 
 {
@@ -144,6 +145,9 @@ protected:
 	 * Creates a Point taking ownership of the given CoordinateSequence
 	 * (must have 1 element)
 	 *
+	 * The coordinate is copied into the Point, and the sequence
+	 * deleted.
+	 *
 	 * @param  newCoords
 	 *	contains the single coordinate on which to base this
 	 *	<code>Point</code> or <code>null</code> to create
@@ -153,9 +157,12 @@ protected:
 	 */  
 	Point(CoordinateSequence *newCoords, const GeometryFactory *newFactory);
 
+	/// Creates a Point of the given non-null coordinate
+	Point(const Coordinate& c, const GeometryFactory *newFactory);
+
 	Point(const Point &p); 
 
-	Envelope::AutoPtr computeEnvelopeInternal() const;
+	Envelope computeEnvelopeInternal() const;
 
 	int compareToSameClass(const Geometry *p) const;
 
@@ -164,7 +171,7 @@ private:
 	/**
 	 *  The <code>Coordinate</code> wrapped by this <code>Point</code>.
 	 */
-	std::auto_ptr<CoordinateSequence> coordinates;
+	PointCoordinateSequence coordinates;
 };
 
 } // namespace geos::geom
@@ -0,0 +1,166 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOM_POINTCOORDINATESEQUENCE_H
+#define GEOS_GEOM_POINTCOORDINATESEQUENCE_H
+
+#include <geos/export.h>
+#include <vector>
+#include <string>
+#include <cstddef>
+
+#include <geos/geom/CoordinateSequence.h> // for inheritance
+#include <geos/geom/Coordinate.h> // for composition
+#include <geos/geom/CoordinateVectorCache.h> // for composition
+
+#include <cassert>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+namespace geos {
+namespace geom { // geos.geom
+
+/** \brief
+ * The CoordinateSequence of a Point: no Coordinate, or a single one,
+ * stored in place.
+ *
+ * Changes which would make the sequence longer than one Coordinate
+ * throw UnsupportedOperationException. clone() copies the sequence
+ * into a CoordinateArraySequence, which has no such limit.
+ *
+ * toVector() builds a std::vector copy of the Coordinate on its
+ * first call, see CoordinateVectorCache.
+ */
+class GEOS_DLL PointCoordinateSequence : public CoordinateSequence {
+public:
+
+	/// Constructs an empty sequence
+	PointCoordinateSequence();
+
+	/**
+	 * @param c the coordinate
+	 * @param dimension the coordinate dimension, or 0 to take it
+	 *        from the Z of c
+	 */
+	explicit PointCoordinateSequence(const Coordinate& c,
+			std::size_t dimension=0);
+
+	PointCoordinateSequence(const PointCoordinateSequence& other);
+
+	~PointCoordinateSequence();
+
+	/// Replaces the content of the sequence by c
+	void init(const Coordinate& c, std::size_t dimension=0);
+
+	/// Returns a CoordinateArraySequence copy of the sequence
+	CoordinateSequence *clone() const;
+
+	const Coordinate& getAt(std::size_t pos) const
+	{
+		assert(pos < size);
+		return coord;
+	}
+
+	void getAt(std::size_t pos, Coordinate& c) const
+	{
+		assert(pos < size);
+		c = coord;
+	}
+
+	std::size_t getSize() const { return size; }
+
+	/// Builds the vector copy of the sequence, see class dox
+	const std::vector<Coordinate>* toVector() const;
+
+	void toVector(std::vector<Coordinate>& coords) const;
+
+	bool isEmpty() const { return size == 0; }
+
+	/// @throw UnsupportedOperationException if not empty
+	void add(const Coordinate& c);
+
+	/// @throw UnsupportedOperationException if c is added to a
+	///        non-empty sequence
+	void add(const Coordinate& c, bool allowRepeated);
+
+	/// @throw UnsupportedOperationException if c is added to a
+	///        non-empty sequence
+	void add(std::size_t i, const Coordinate& coord, bool allowRepeated);
+
+	void setAt(const Coordinate& c, std::size_t pos);
+
+	void deleteAt(std::size_t pos);
+
+	std::string toString() const;
+
+	/// @throw UnsupportedOperationException if v has more than one
+	///        Coordinate
+	void setPoints(const std::vector<Coordinate> &v);
+
+	double getOrdinate(std::size_t index, std::size_t ordinateIndex) const;
+
+	double getX(std::size_t) const { return coord.x; }
+
+	double getY(std::size_t) const { return coord.y; }
+
+	void setOrdinate(std::size_t index, std::size_t ordinateIndex,
+			double value);
+
+	void expandEnvelope(Envelope &e) const;
+
+	const Coordinate* getCoordinateArray() const
+	{
+		return size ? &coord : 0;
+	}
+
+	std::size_t getDimension() const;
+
+	void apply_rw(const CoordinateFilter *filter);
+
+	void apply_ro(CoordinateFilter *filter) const;
+
+	CoordinateSequence& removeRepeatedPoints() { return *this; }
+
+private:
+
+	/// Updates vect after a change of coord or size
+	void changed();
+
+	/// The dimension of c, 2 if its Z is NaN
+	static std::size_t dimensionOf(const Coordinate& c);
+
+	static void throwTooLong();
+
+	Coordinate coord;
+
+	std::size_t size;
+
+	std::size_t dimension;
+
+	// Vector copy of the sequence, built when asked for
+	CoordinateVectorCache vect;
+
+	// Declare type as unassignable
+	PointCoordinateSequence& operator=(const PointCoordinateSequence& rhs);
+};
+
+} // namespace geos.geom
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // ndef GEOS_GEOM_POINTCOORDINATESEQUENCE_H
@@ -182,7 +182,7 @@ protected:
 
 	std::vector<Geometry *> *holes; //Actually vector<LinearRing *>
 
-	Envelope::AutoPtr computeEnvelopeInternal() const;
+	Envelope computeEnvelopeInternal() const;
 
 private:
 
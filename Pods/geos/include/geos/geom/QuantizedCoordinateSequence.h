@@ -0,0 +1,205 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOM_QUANTIZEDCOORDINATESEQUENCE_H
+#define GEOS_GEOM_QUANTIZEDCOORDINATESEQUENCE_H
+
+#include <geos/export.h>
+#include <geos/platform.h> // for int64
+#include <vector>
+#include <string>
+#include <cstddef>
+
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/CoordinateVectorCache.h> // for composition
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Coordinate;
+	}
+}
+
+namespace geos {
+namespace geom { // geos.geom
+
+/** \brief
+ * A two-dimensional CoordinateSequence on the grid of a FIXED
+ * PrecisionModel, stored as 32-bit integer offsets from an origin.
+ *
+ * A point is stored as qx, qy such that x = (originX + qx) / scale
+ * and y = (originY + qy) / scale, originX and originY being in grid
+ * units. It takes 8 bytes per point instead of the 24 of a
+ * Coordinate. Z is not stored: it reads as NaN and writes to it are
+ * ignored.
+ *
+ * Coordinates are snapped to the grid as they are stored, rounding
+ * as PrecisionModel::makePrecise() does, so that reading them back
+ * gives the same doubles as makePrecise(). Storing a point further
+ * than 2^31 grid units from the origin throws
+ * IllegalArgumentException.
+ *
+ * The grid values can be read as they are through data() and
+ * getGridX()/getGridY(), and decoded in bulk with decode().
+ *
+ * getAt(std::size_t), toVector() and apply_ro() hand out references
+ * to Coordinates, so the first of those calls builds a Coordinate
+ * copy of the whole sequence, see CoordinateVectorCache.
+ *
+ * This only saves memory, a third of that of a CoordinateArraySequence.
+ * No operation uses the grid values yet: snap-rounding and overlay
+ * read the coordinates as doubles, like those of any other sequence,
+ * and make their own scaled copies of them.
+ */
+class GEOS_DLL QuantizedCoordinateSequence : public CoordinateSequence {
+public:
+
+	/**
+	 * Constructs an empty sequence
+	 *
+	 * @param scale the scale of the grid, as in PrecisionModel
+	 * @param originX the X of the origin, in grid units
+	 * @param originY the Y of the origin, in grid units
+	 */
+	QuantizedCoordinateSequence(double scale, int64 originX=0,
+			int64 originY=0);
+
+	/// Construct a sequence of n coordinates at the origin
+	QuantizedCoordinateSequence(std::size_t n, double scale,
+			int64 originX=0, int64 originY=0);
+
+	QuantizedCoordinateSequence(const QuantizedCoordinateSequence &cl);
+
+	/// Construct a sequence snapping the coordinates of cl to the grid
+	QuantizedCoordinateSequence(const CoordinateSequence &cl, double scale,
+			int64 originX=0, int64 originY=0);
+
+	~QuantizedCoordinateSequence();
+
+	CoordinateSequence *clone() const;
+
+	/// Builds the Coordinate copy of the sequence, see class dox
+	const Coordinate& getAt(std::size_t pos) const;
+
+	/// Copy Coordinate at position i to Coordinate c
+	void getAt(std::size_t i, Coordinate& c) const;
+
+	std::size_t getSize() const { return q.size() / 2; }
+
+	/// Builds the Coordinate copy of the sequence, see class dox
+	const std::vector<Coordinate>* toVector() const;
+
+	void toVector(std::vector<Coordinate>& coords) const;
+
+	bool isEmpty() const { return q.empty(); }
+
+	void add(const Coordinate& c);
+
+	void add(const Coordinate& c, bool allowRepeated);
+
+	void add(std::size_t i, const Coordinate& coord, bool allowRepeated);
+
+	void setAt(const Coordinate& c, std::size_t pos);
+
+	void deleteAt(std::size_t pos);
+
+	std::string toString() const;
+
+	void setPoints(const std::vector<Coordinate> &v);
+
+	double getOrdinate(std::size_t index, std::size_t ordinateIndex) const;
+
+	double getX(std::size_t index) const
+	{
+		return (ox + q[2 * index]) / scale;
+	}
+
+	double getY(std::size_t index) const
+	{
+		return (oy + q[2 * index + 1]) / scale;
+	}
+
+	void setOrdinate(std::size_t index, std::size_t ordinateIndex,
+			double value);
+
+	void expandEnvelope(Envelope &env) const;
+
+	std::size_t getDimension() const { return 2; }
+
+	void apply_rw(const CoordinateFilter *filter);
+
+	/// Builds the Coordinate copy of the sequence, see class dox
+	void apply_ro(CoordinateFilter *filter) const;
+
+	CoordinateSequence& removeRepeatedPoints();
+
+	/**
+	 * Writes points [start, start+count) to xy as x0, y0, x1, y1, ...
+	 *
+	 * This is how to read many points: the loop has no branch
+	 * and no virtual call.
+	 */
+	void decode(double* xy, std::size_t start, std::size_t count) const;
+
+	/// The X of point index on the grid, in grid units
+	int64 getGridX(std::size_t index) const
+	{
+		return static_cast<int64>(ox) + q[2 * index];
+	}
+
+	/// The Y of point index on the grid, in grid units
+	int64 getGridY(std::size_t index) const
+	{
+		return static_cast<int64>(oy) + q[2 * index + 1];
+	}
+
+	/// The offsets from the origin, qx0, qy0, qx1, qy1, ...; NULL if empty
+	const int* data() const { return q.empty() ? 0 : &q[0]; }
+
+	double getScale() const { return scale; }
+
+	int64 getOriginX() const { return static_cast<int64>(ox); }
+
+	int64 getOriginY() const { return static_cast<int64>(oy); }
+
+private:
+
+	/// Snaps v to the grid, as an offset from origin
+	int quantize(double v, double origin) const;
+
+	double scale;
+
+	// The origin, in grid units: as doubles, they are added to
+	// the offsets without conversion from int64
+	double ox;
+
+	double oy;
+
+	std::vector<int> q;
+
+	// Coordinate copy of q, built when needed
+	CoordinateVectorCache coords;
+};
+
+} // namespace geos.geom
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // ndef GEOS_GEOM_QUANTIZEDCOORDINATESEQUENCE_H
@@ -0,0 +1,86 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOM_QUANTIZEDCOORDINATESEQUENCEFACTORY_H
+#define GEOS_GEOM_QUANTIZEDCOORDINATESEQUENCEFACTORY_H
+
+#include <geos/export.h>
+#include <geos/platform.h> // for int64
+#include <vector>
+
+#include <geos/geom/CoordinateSequenceFactory.h> // for inheritance
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Coordinate;
+		class PrecisionModel;
+	}
+}
+
+namespace geos {
+namespace geom { // geos::geom
+
+/**
+ * \brief
+ * Creates CoordinateSequences holding two-dimensional points on the
+ * grid of a FIXED PrecisionModel, as 32-bit integers.
+ *
+ * The requested dimension is ignored: Z values are always dropped.
+ * Points further than 2^31 grid units from the origin cannot be
+ * stored. For tiles of a 4096 units grid, the origin can be left at
+ * (0, 0).
+ *
+ * @see QuantizedCoordinateSequence
+ */
+class GEOS_DLL QuantizedCoordinateSequenceFactory: public CoordinateSequenceFactory {
+
+public:
+
+	/**
+	 * @param pm the precision model, which must be FIXED
+	 * @param originX the X of the origin, in grid units
+	 * @param originY the Y of the origin, in grid units
+	 *
+	 * @throw IllegalArgumentException if pm is not FIXED
+	 */
+	QuantizedCoordinateSequenceFactory(const PrecisionModel& pm,
+			int64 originX=0, int64 originY=0);
+
+	CoordinateSequence *create() const;
+
+	/// Copies the coordinates and deletes the vector
+	CoordinateSequence *create(std::vector<Coordinate> *coords, std::size_t dims=0) const;
+
+	CoordinateSequence *create(std::size_t size, std::size_t dimension=0) const;
+
+	CoordinateSequence *create(const CoordinateSequence &coordSeq) const;
+
+	double getScale() const { return scale; }
+
+	int64 getOriginX() const { return originX; }
+
+	int64 getOriginY() const { return originY; }
+
+private:
+
+	double scale;
+
+	int64 originX;
+
+	int64 originY;
+};
+
+} // namespace geos::geom
+} // namespace geos
+
+#endif // ndef GEOS_GEOM_QUANTIZEDCOORDINATESEQUENCEFACTORY_H
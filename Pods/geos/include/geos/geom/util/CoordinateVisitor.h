@@ -0,0 +1,142 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOM_UTIL_COORDINATEVISITOR_H
+#define GEOS_GEOM_UTIL_COORDINATEVISITOR_H
+
+#include <geos/export.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Point.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/Polygon.h>
+
+#include <cstddef>
+
+namespace geos {
+namespace geom { // geos.geom
+namespace util { // geos.geom.util
+
+/**
+ * \brief
+ * Visits the coordinates of a Geometry with a functor, without a
+ * virtual call per coordinate.
+ *
+ * Geometry::apply_ro(CoordinateFilter*) calls a virtual filter_ro()
+ * for each coordinate, which reads it through the virtual
+ * CoordinateSequence::getAt(). These templates find the
+ * CoordinateSequences of the Geometry once per component, then walk
+ * each one with CoordinateSequence::forEachXY() or
+ * CoordinateSequence::forEachCoordinate(), so that the functor is
+ * inlined in the loop over the points.
+ *
+ * Sequences are visited in the order of apply_ro(): components in
+ * order, and for Polygons the exterior ring before the holes.
+ *
+ * Example:
+ * \code
+ * struct SumX {
+ *   double sum;
+ *   SumX() : sum(0.0) {}
+ *   void operator()(double x, double) { sum += x; }
+ * };
+ * SumX f;
+ * CoordinateVisitor::forEachXY(geom, f);
+ * \endcode
+ */
+class GEOS_DLL CoordinateVisitor {
+
+public:
+
+	/**
+	 * Calls f(const CoordinateSequence&) for each CoordinateSequence
+	 * of g, empty ones included.
+	 */
+	template <class F>
+	static void forEachSequence(const Geometry& g, F& f)
+	{
+		// Geometry is a virtual base, so no static_cast here
+		if ( const LineString* l = dynamic_cast<const LineString*>(&g) )
+		{
+			f(*l->getCoordinatesRO());
+		}
+		else if ( const Polygon* p = dynamic_cast<const Polygon*>(&g) )
+		{
+			f(*p->getExteriorRing()->getCoordinatesRO());
+			for (std::size_t i=0, n=p->getNumInteriorRing(); i<n; ++i)
+				f(*p->getInteriorRingN(i)->getCoordinatesRO());
+		}
+		else if ( const Point* pt = dynamic_cast<const Point*>(&g) )
+		{
+			f(*pt->getCoordinatesRO());
+		}
+		else
+		{
+			for (std::size_t i=0, n=g.getNumGeometries(); i<n; ++i)
+				forEachSequence(*g.getGeometryN(i), f);
+		}
+	}
+
+	/// Calls f(x, y) for each coordinate of g
+	template <class F>
+	static void forEachXY(const Geometry& g, F& f)
+	{
+		XYVisitor<F> v(f);
+		forEachSequence(g, v);
+	}
+
+	/// Calls f(const Coordinate&) for each coordinate of g
+	template <class F>
+	static void forEachCoordinate(const Geometry& g, F& f)
+	{
+		CoordinateVisitorAdapter<F> v(f);
+		forEachSequence(g, v);
+	}
+
+private:
+
+	template <class F>
+	struct XYVisitor {
+
+		XYVisitor(F& f) : f_(f) {}
+
+		void operator()(const CoordinateSequence& seq)
+		{
+			seq.forEachXY(f_);
+		}
+
+		F& f_;
+	};
+
+	template <class F>
+	struct CoordinateVisitorAdapter {
+
+		CoordinateVisitorAdapter(F& f) : f_(f) {}
+
+		void operator()(const CoordinateSequence& seq)
+		{
+			seq.forEachCoordinate(f_);
+		}
+
+		F& f_;
+	};
+
+	// Declare type as noncopyable
+	CoordinateVisitor(const CoordinateVisitor& other);
+	CoordinateVisitor& operator=(const CoordinateVisitor& rhs);
+};
+
+} // namespace geos.geom.util
+} // namespace geos.geom
+} // namespace geos
+
+#endif // GEOS_GEOM_UTIL_COORDINATEVISITOR_H
@@ -19,6 +19,7 @@
 #include <geos/geom/util/GeometryEditor.h>
 #include <geos/geom/util/GeometryEditorOperation.h>
 #include <geos/geom/util/CoordinateOperation.h>
+#include <geos/geom/util/CoordinateVisitor.h>
 #include <geos/geom/util/LinearComponentExtracter.h>
 #include <geos/geom/util/PointExtracter.h>
 #include <geos/geom/util/PolygonExtracter.h>
@@ -94,6 +94,14 @@ public:
 	 */
 	geom::Polygon* toPolygon(const geom::GeometryFactory* geometryFactory);
 
+	/**
+	 * Return a Polygon made of the LinearRings of this EdgeRing
+	 * and its holes, rather than of copies of them.
+	 *
+	 * This EdgeRing and its holes can only be deleted afterwards.
+	 */
+	geom::Polygon* releasePolygon(const geom::GeometryFactory* geometryFactory);
+
 	/**
 	 * Compute a LinearRing from the point list previously collected.
 	 * Test if the ring is a hole (i.e. if it is CCW) and set the hole
@@ -122,8 +130,8 @@ public:
 
 	void testInvariant()
 	{
-		// pts are never NULL
-		assert(pts);
+		// pts are never NULL, unless given away by releasePolygon()
+		assert(pts || released);
 
 #ifndef NDEBUG
 		// If this is not an hole, check that
@@ -191,6 +199,9 @@ private:
 
 	bool isHoleVar;
 
+	/// true once ring and pts were given away by releasePolygon()
+	bool released;
+
 	/// if non-null, the ring is a hole and this EdgeRing is its containing shell
 	EdgeRing *shell;  
 
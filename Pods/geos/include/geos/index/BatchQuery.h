@@ -0,0 +1,85 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_BATCHQUERY_H
+#define GEOS_INDEX_BATCHQUERY_H
+
+#include <geos/export.h>
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Envelope;
+	}
+}
+
+namespace geos {
+namespace index { // geos::index
+
+/// A (query index, item) result of a batch query
+typedef std::pair<std::size_t, void*> BatchQueryHit;
+
+/** \brief
+ * Runs many envelope queries against one index at once.
+ *
+ * Queries are reordered along a Hilbert curve over their centres
+ * and split into groups of nearby queries. Each group is handed to
+ * queryGroup(), which can walk the index once for the whole group
+ * instead of once per query. Groups can run on several threads.
+ *
+ * Hits are returned ordered by query index; the hits of each query
+ * are in the order a single query would have returned them.
+ */
+class GEOS_DLL BatchQuery {
+public:
+
+	/// Maximum number of queries passed to one queryGroup() call
+	static const std::size_t groupSize = 32;
+
+	virtual ~BatchQuery() {}
+
+	/**
+	 * Runs the queries and appends the hits.
+	 *
+	 * NULL and null envelopes match nothing.
+	 *
+	 * @param searchEnvs the query envelopes; ownership left to caller
+	 * @param hits the vector to append (query index, item) pairs to
+	 * @param numThreads the maximum number of threads to use
+	 */
+	void run(const std::vector<const geom::Envelope*>& searchEnvs,
+	         std::vector<BatchQueryHit>& hits,
+	         std::size_t numThreads=1) const;
+
+	/**
+	 * Runs the queries searchEnvs[queryIds[i]] for i in [0, count),
+	 * appending their hits.
+	 *
+	 * The hits of each query must be appended in the order a
+	 * single query would have returned them; hits of different
+	 * queries may be interleaved.
+	 *
+	 * Must be safe to call concurrently.
+	 */
+	virtual void queryGroup(const std::vector<const geom::Envelope*>& searchEnvs,
+	                        const std::size_t* queryIds, std::size_t count,
+	                        std::vector<BatchQueryHit>& hits) const=0;
+};
+
+} // namespace geos::index
+} // namespace geos
+
+#endif // GEOS_INDEX_BATCHQUERY_H
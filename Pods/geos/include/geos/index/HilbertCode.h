@@ -0,0 +1,48 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_HILBERTCODE_H
+#define GEOS_INDEX_HILBERTCODE_H
+
+#include <geos/export.h>
+
+namespace geos {
+namespace index { // geos::index
+
+/** \brief
+ * Positions of the cells of a grid along a Hilbert curve.
+ *
+ * Sorting items by the code of the cell of their centre keeps
+ * nearby items together, which indexes use to group items, or
+ * queries, into compact runs.
+ */
+class GEOS_DLL HilbertCode {
+
+public:
+
+	/// The largest cell column or row of the grid
+	static const unsigned int maxOrdinate = 65535;
+
+	/**
+	 * Computes the index of a cell along a Hilbert curve
+	 * filling a 2^16 x 2^16 grid.
+	 *
+	 * @param x the cell column, in [0, maxOrdinate]
+	 * @param y the cell row, in [0, maxOrdinate]
+	 */
+	static unsigned int encode(unsigned int x, unsigned int y);
+};
+
+} // namespace geos::index
+} // namespace geos
+
+#endif // GEOS_INDEX_HILBERTCODE_H
@@ -0,0 +1,168 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_HILBERTRTREE_HILBERTRTREE_H
+#define GEOS_INDEX_HILBERTRTREE_HILBERTRTREE_H
+
+#include <geos/export.h>
+#include <geos/index/SpatialIndex.h> // for inheritance
+
+#include <vector>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Envelope;
+	}
+	namespace index {
+		class ItemVisitor;
+		namespace strtree {
+			class ItemDistance;
+		}
+	}
+}
+
+namespace geos {
+namespace index { // geos::index
+namespace hilbertrtree { // geos::index::hilbertrtree
+
+/**
+ * \brief
+ * A query-only R-tree packed by sorting items along a Hilbert curve.
+ *
+ * Items are ordered by the Hilbert index of the centre of their
+ * envelope (on a 2^16 x 2^16 grid over the extent of all centres),
+ * then packed bottom-up into levels of nodeCapacity entries each.
+ * Building takes a single sort and no recursive slicing; the Hilbert
+ * order keeps clustered data in fewer, tighter nodes than
+ * Sort-Tile-Recursive packing.
+ *
+ * Items and nodes are stored in flat arrays, items first and the root
+ * last, with bounds in structure-of-arrays form.
+ *
+ * The tree is built on the first query (or an explicit build()).
+ * Inserting or removing items afterwards is allowed but makes the
+ * next query rebuild the tree.
+ */
+class GEOS_DLL HilbertRtree: public SpatialIndex
+{
+public:
+
+	/**
+	 * Constructs a HilbertRtree with the given maximum number of
+	 * children per node
+	 */
+	HilbertRtree(std::size_t nodeCapacity=12);
+
+	~HilbertRtree();
+
+	/// Bounds are copied; items are held by reference only
+	void insert(const geom::Envelope *itemEnv, void* item);
+
+	///  Also builds the tree, if necessary.
+	void query(const geom::Envelope *searchEnv, std::vector<void*>& matches);
+
+	///  Also builds the tree, if necessary.
+	void query(const geom::Envelope *searchEnv, ItemVisitor& visitor);
+
+	bool remove(const geom::Envelope *itemEnv, void* item);
+
+	/// Sorts and packs the items inserted so far
+	void build();
+
+	/**
+	 * Iterate over all items added thus far, in insertion order.
+	 * Explicitly does not build the tree.
+	 */
+	void iterate(ItemVisitor& visitor);
+
+	/// Number of items in the index
+	std::size_t size() const { return entries.size(); }
+
+	std::size_t getNodeCapacity() const { return nodeCapacity; }
+
+	/**
+	 * Finds the item in this tree which is nearest to the given item,
+	 * using ItemDistance as the distance metric.
+	 *
+	 * Also builds the tree, if necessary.
+	 *
+	 * @return the nearest item, or NULL if the tree is empty
+	 * @see strtree::STRtree::nearestNeighbour
+	 */
+	const void* nearestNeighbour(const geom::Envelope *env, const void* item,
+			strtree::ItemDistance* itemDist);
+
+	/**
+	 * Finds up to k items in this tree which are nearest to the
+	 * given item, appending them to neighbours in order of
+	 * increasing distance.
+	 *
+	 * Also builds the tree, if necessary.
+	 */
+	void nearestNeighbours(const geom::Envelope *env, const void* item,
+			strtree::ItemDistance* itemDist, std::size_t k,
+			std::vector<void*>& neighbours);
+
+private:
+
+	/// An inserted item
+	struct Entry {
+		double minX, minY, maxX, maxY;
+		void* item;
+	};
+
+	template <class Sink>
+	void queryImpl(const geom::Envelope& searchEnv, Sink& sink);
+
+	std::size_t nodeCapacity;
+
+	bool built;
+
+	/// Items in insertion order
+	std::vector<Entry> entries;
+
+	// Bounds of the items (in Hilbert order) followed by the
+	// bounds of the nodes, level by level up to the root.
+	// Padded at the end for the overlap kernel.
+	std::vector<double> minX;
+	std::vector<double> minY;
+	std::vector<double> maxX;
+	std::vector<double> maxY;
+
+	/// Items in Hilbert order
+	std::vector<void*> items;
+
+	/// levelBounds[i] is the index one past the last entry of level i
+	/// (level 0 holds the items)
+	std::vector<std::size_t> levelBounds;
+
+	// Declare type as noncopyable
+	HilbertRtree(const HilbertRtree& other);
+	HilbertRtree& operator=(const HilbertRtree& rhs);
+};
+
+} // namespace geos::index::hilbertrtree
+} // namespace geos::index
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_INDEX_HILBERTRTREE_HILBERTRTREE_H
@@ -0,0 +1,169 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_INTERVALRTREE_ARRAYINTERVALRTREE_H
+#define GEOS_INDEX_INTERVALRTREE_ARRAYINTERVALRTREE_H
+
+#include <geos/export.h>
+
+#include <vector>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// forward declarations
+namespace geos {
+	namespace index {
+		class ItemVisitor;
+	}
+}
+
+namespace geos {
+namespace index {
+namespace intervalrtree {
+
+/** \brief
+ * A static index on a set of 1-dimensional intervals, stored in
+ * flat arrays.
+ *
+ * Like SortedPackedIntervalRTree, items are sorted by interval
+ * midpoint and packed bottom-up, but nodes are implicit: node i of
+ * a level covers nodes [i*nodeCapacity, (i+1)*nodeCapacity) of the
+ * level below, and the bounds of all levels are kept in two
+ * contiguous arrays. Queries walk the levels iteratively, with no
+ * allocation and no virtual call per node.
+ *
+ * Items are inserted, then build() is called once; the index is
+ * immutable from then on and can be queried from several threads.
+ */
+class GEOS_DLL ArrayIntervalRTree
+{
+public:
+
+	/**
+	 * @param nodeCapacity the number of children of a node,
+	 *        at least 2
+	 */
+	ArrayIntervalRTree(std::size_t nodeCapacity=16);
+
+	/**
+	 * Adds an item to the index which is associated with the given interval
+	 *
+	 * @param min the lower bound of the item interval
+	 * @param max the upper bound of the item interval
+	 * @param item the item to insert, ownership left to caller
+	 *
+	 * @throw IllegalStateException if the index has been built
+	 */
+	void insert(double min, double max, void * item);
+
+	/**
+	 * Sorts and packs the items. Must be called once, after the
+	 * last insertion and before the first query.
+	 *
+	 * @throw IllegalStateException if the index has been built
+	 */
+	void build();
+
+	bool isBuilt() const { return built; }
+
+	std::size_t size() const { return items.size(); }
+
+	/**
+	 * Search for intervals in the index which intersect the given
+	 * closed interval and pass their items to visitor.visitItem().
+	 *
+	 * Any type with a visitItem(void*) member can be used as the
+	 * visitor; a non-virtual one is called directly.
+	 *
+	 * @throw IllegalStateException if the index has not been built
+	 */
+	template <class Visitor>
+	void query(double min, double max, Visitor& visitor) const
+	{
+		if ( ! built ) throwNotBuilt();
+		if ( items.empty() ) return;
+
+		// One cursor per level; a level has at most half the nodes
+		// of the level below, so the depth fits the bits of size_t
+		std::size_t cursor[sizeof(std::size_t) * 8 + 1];
+		std::size_t end[sizeof(std::size_t) * 8 + 1];
+
+		const std::size_t top = levelStart.size() - 2;
+		std::size_t level = top;
+		cursor[level] = 0;
+		end[level] = 1;
+
+		for (;;)
+		{
+			if ( cursor[level] == end[level] )
+			{
+				if ( level == top ) return;
+				++level;
+				continue;
+			}
+
+			const std::size_t i = cursor[level]++;
+			const std::size_t k = levelStart[level] + i;
+			if ( mins[k] > max || maxs[k] < min ) continue;
+
+			if ( level == 0 )
+			{
+				visitor.visitItem(items[i]);
+				continue;
+			}
+
+			--level;
+			cursor[level] = i * nodeCapacity;
+			std::size_t e = cursor[level] + nodeCapacity;
+			std::size_t n = levelStart[level + 1] - levelStart[level];
+			end[level] = e < n ? e : n;
+		}
+	}
+
+	void query(double min, double max, ItemVisitor * visitor) const;
+
+private:
+
+	static void throwNotBuilt();
+
+	std::size_t nodeCapacity;
+
+	bool built;
+
+	// Bounds of the items (level 0, in item order), then of the
+	// nodes of each level up to the root
+	std::vector<double> mins;
+	std::vector<double> maxs;
+
+	// Offset of each level in mins and maxs, plus the total size
+	std::vector<std::size_t> levelStart;
+
+	std::vector<void*> items;
+
+	// Declare type as noncopyable
+	ArrayIntervalRTree(const ArrayIntervalRTree& other);
+	ArrayIntervalRTree& operator=(const ArrayIntervalRTree& rhs);
+};
+
+} // geos::intervalrtree
+} // geos::index
+} // geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_INDEX_INTERVALRTREE_ARRAYINTERVALRTREE_H
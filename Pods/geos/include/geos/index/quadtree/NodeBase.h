@@ -20,6 +20,7 @@
 #define GEOS_IDX_QUADTREE_NODEBASE_H
 
 #include <geos/export.h>
+#include <geos/index/BatchQuery.h> // for BatchQueryHit
 #include <vector>
 #include <string>
 
@@ -79,6 +80,17 @@ public:
 	virtual void addAllItemsFromOverlapping(const geom::Envelope& searchEnv,
 			std::vector<void*>& resultItems) const;
 
+	/**
+	 * Runs the queries searchEnvs[i], for each i in queryIds,
+	 * visiting each node once for all the queries that reach it.
+	 * The hits of each query are in the order
+	 * addAllItemsFromOverlapping would push them.
+	 */
+	void addAllItemsFromOverlapping(
+			const std::vector<const geom::Envelope*>& searchEnvs,
+			const std::vector<std::size_t>& queryIds,
+			std::vector<BatchQueryHit>& hits) const;
+
 	unsigned int depth() const;
 
 	unsigned int size() const;
@@ -21,6 +21,7 @@
 
 #include <geos/export.h>
 #include <geos/index/SpatialIndex.h> // for inheritance
+#include <geos/index/BatchQuery.h> // for BatchQueryHit
 #include <geos/index/quadtree/Root.h> // for composition
 
 #include <vector>
@@ -168,6 +169,23 @@ public:
 		root.visit(searchEnv, visitor);
 	}
 
+	/** \brief
+	 * Runs a batch of envelope queries.
+	 *
+	 * Appends a (query index, item) pair to hits for each item
+	 * query(searchEnvs[i], ...) would return. Hits are ordered by
+	 * query index, then in query() order. Nearby queries share
+	 * their walks of the tree.
+	 *
+	 * @param searchEnvs the query envelopes; NULL entries match nothing
+	 * @param hits the vector to append the hits to
+	 * @param numThreads the maximum number of threads to use
+	 * @see BatchQuery
+	 */
+	void queryBatch(const std::vector<const geom::Envelope*>& searchEnvs,
+			std::vector<BatchQueryHit>& hits,
+			std::size_t numThreads=1);
+
 	/**
 	 * Removes a single item from the tree.
 	 *
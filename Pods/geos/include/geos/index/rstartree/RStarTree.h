@@ -0,0 +1,192 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_RSTARTREE_RSTARTREE_H
+#define GEOS_INDEX_RSTARTREE_RSTARTREE_H
+
+#include <geos/export.h>
+#include <geos/index/SpatialIndex.h> // for inheritance
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Envelope;
+	}
+	namespace index {
+		class ItemVisitor;
+		namespace strtree {
+			class ItemDistance;
+		}
+	}
+}
+
+namespace geos {
+namespace index { // geos::index
+namespace rstartree { // geos::index::rstartree
+
+/**
+ * \brief
+ * A dynamic R-tree using the R*-tree insertion heuristics.
+ *
+ * Unlike STRtree, items can be inserted and removed at any time,
+ * and queries never rebuild the tree. Each change touches a single
+ * root-to-leaf path, plus the entries it reinserts.
+ *
+ * Insertion follows Beckmann et al., "The R*-tree: An Efficient and
+ * Robust Access Method for Points and Rectangles" (SIGMOD 1990):
+ *
+ * - a subtree is chosen by least overlap enlargement just above
+ *   the leaves, and by least area enlargement higher up;
+ * - the first overflow at each level of an insertion reinserts the
+ *   30% of entries farthest from the node centre, instead of
+ *   splitting;
+ * - splits pick the axis with the least total margin, then the
+ *   distribution with the least overlap.
+ *
+ * Removal reinserts the entries of nodes left underfull.
+ */
+class GEOS_DLL RStarTree: public SpatialIndex
+{
+public:
+
+	/**
+	 * Constructs an empty RStarTree.
+	 *
+	 * @param maxEntries the maximum number of entries of a node,
+	 *        at least 4. Nodes other than the root hold at least
+	 *        40% of this.
+	 */
+	RStarTree(std::size_t maxEntries=16);
+
+	~RStarTree();
+
+	/// Bounds are copied; items are held by reference only
+	void insert(const geom::Envelope *itemEnv, void* item);
+
+	void query(const geom::Envelope *searchEnv, std::vector<void*>& matches);
+
+	void query(const geom::Envelope *searchEnv, ItemVisitor& visitor);
+
+	/**
+	 * Removes a single item from the tree.
+	 *
+	 * @param itemEnv the Envelope of the item to remove
+	 * @param item the item to remove
+	 * @return <code>true</code> if the item was found
+	 */
+	bool remove(const geom::Envelope *itemEnv, void* item);
+
+	/// Visits all items in the tree
+	void iterate(ItemVisitor& visitor);
+
+	/// Number of items in the tree
+	std::size_t size() const { return numItems; }
+
+	/// Number of levels of the tree, 1 for a tree with just a root
+	std::size_t depth() const;
+
+	std::size_t getMaxEntries() const { return maxEntries; }
+
+	/**
+	 * Finds the item in this tree which is nearest to the given item,
+	 * using ItemDistance as the distance metric.
+	 *
+	 * @return the nearest item, or NULL if the tree is empty
+	 * @see strtree::STRtree::nearestNeighbour
+	 */
+	const void* nearestNeighbour(const geom::Envelope *env, const void* item,
+			strtree::ItemDistance* itemDist);
+
+	/**
+	 * Finds up to k items in this tree which are nearest to the
+	 * given item, appending them to neighbours in order of
+	 * increasing distance.
+	 */
+	void nearestNeighbours(const geom::Envelope *env, const void* item,
+			strtree::ItemDistance* itemDist, std::size_t k,
+			std::vector<void*>& neighbours);
+
+private:
+
+	struct Node;
+
+	/// An item (in leaves) or a child node, with its bounds
+	struct Entry {
+		double minX, minY, maxX, maxY;
+		Node* child;
+		void* item;
+	};
+
+	/// An entry waiting to be inserted at the given level
+	typedef std::pair<Entry, std::size_t> PendingEntry;
+
+	template <class Sink>
+	void queryImpl(const geom::Envelope& searchEnv, Sink& sink);
+
+	void insertEntry(const Entry& e, std::size_t level);
+
+	Node* insertRecursive(Node* node, const Entry& e, std::size_t level,
+			std::vector<bool>& reinserted,
+			std::vector<PendingEntry>& pending);
+
+	Node* overflow(Node* node, std::vector<bool>& reinserted,
+			std::vector<PendingEntry>& pending);
+
+	void reinsertFarthest(Node* node, std::vector<PendingEntry>& pending);
+
+	Node* split(Node* node);
+
+	std::size_t chooseSubtree(const Node* node, const Entry& e) const;
+
+	bool removeRecursive(Node* node, const geom::Envelope& env, void* item,
+			std::vector<PendingEntry>& orphans);
+
+	static void collectItems(Node* node, std::vector<Entry>& items);
+
+	static void setBounds(Entry& e, const Node* node);
+
+	static void deleteTree(Node* node);
+
+	std::size_t maxEntries;
+
+	std::size_t minEntries;
+
+	/// Number of entries moved by a forced reinsertion
+	std::size_t reinsertCount;
+
+	std::size_t numItems;
+
+	Node* root;
+
+	// Declare type as noncopyable
+	RStarTree(const RStarTree& other);
+	RStarTree& operator=(const RStarTree& rhs);
+};
+
+} // namespace geos::index::rstartree
+} // namespace geos::index
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_INDEX_RSTARTREE_RSTARTREE_H
@@ -193,6 +193,13 @@ protected:
 	virtual std::auto_ptr<BoundableList> createParentBoundables(
 			BoundableList* childBoundables, int newLevel);
 
+	/**
+	 * Divides already sorted childBoundables into groups of size M,
+	 * where M is the node capacity, creating a parent node per group.
+	 */
+	std::auto_ptr<BoundableList> createParentBoundablesFromSorted(
+			const BoundableList& sortedChildBoundables, int newLevel);
+
 	virtual AbstractNode* lastNode(BoundableList* nodes)
 	{
 		assert(!nodes->empty());
@@ -200,8 +207,9 @@ protected:
 		return static_cast<AbstractNode*>( nodes->back() );
 	}
 
+	///  Also builds the tree, if necessary.
 	virtual AbstractNode* getRoot() {
-                assert(built);
+		if (!built) build();
 		return root;
 	}
 
@@ -271,7 +279,7 @@ public:
 	 * Creates parent nodes, grandparent nodes, and so forth up to the root
 	 * node, for the data that has been inserted into the tree. Can only be
 	 * called once, and thus can be called only after all of the data has been
-	 * inserted into the tree.
+	 * inserted into the tree. Subsequent calls are no-ops.
 	 */
 	virtual void build();
 
@@ -0,0 +1,141 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: index/strtree/BoundablePair.java (JTS-1.13)
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_STRTREE_BOUNDABLEPAIR_H
+#define GEOS_INDEX_STRTREE_BOUNDABLEPAIR_H
+
+#include <geos/export.h>
+
+#include <vector>
+#include <queue>
+
+// Forward declarations
+namespace geos {
+	namespace index {
+		namespace strtree {
+			class Boundable;
+			class ItemDistance;
+		}
+	}
+}
+
+namespace geos {
+namespace index { // geos::index
+namespace strtree { // geos::index::strtree
+
+/** \brief
+ * A pair of {@link Boundable}s, whose leaf items
+ * support a distance metric between them.
+ *
+ * Used to compute the distance between the members,
+ * and to expand a member relative to the other
+ * in order to produce new branches of the
+ * Branch-and-Bound evaluation tree.
+ * Provides an ordering based on the distance between the members,
+ * which allows building a priority queue by minimum distance.
+ *
+ * The Boundables of a pair are expected to carry Envelope bounds,
+ * that is they come from an STRtree.
+ */
+class GEOS_DLL BoundablePair {
+private:
+	const Boundable* boundable1;
+	const Boundable* boundable2;
+	ItemDistance* itemDistance;
+	double mDistance;
+
+	/**
+	 * Computes the distance between the {@link Boundable}s in this pair.
+	 * The boundables are either composites or leaves.
+	 * If either is composite, the distance is computed as the minimum
+	 * distance between the bounds.
+	 * If both are leaves, the distance is computed by the ItemDistance.
+	 */
+	double distance();
+
+public:
+
+	struct GEOS_DLL BoundablePairQueueCompare {
+		bool operator()(const BoundablePair* a, const BoundablePair* b) {
+			return a->getDistance() > b->getDistance();
+		}
+	};
+
+	/// Priority queue of BoundablePairs, closest pair on top
+	typedef std::priority_queue<BoundablePair*,
+	                            std::vector<BoundablePair*>,
+	                            BoundablePairQueueCompare> BoundablePairQueue;
+
+	BoundablePair(const Boundable* boundable1,
+	              const Boundable* boundable2,
+	              ItemDistance* itemDistance);
+
+	/**
+	 * Gets one of the member {@link Boundable}s in the pair
+	 * (indexed by [0, 1]).
+	 *
+	 * @param i the index of the member to return (0 or 1)
+	 * @return the chosen member
+	 */
+	const Boundable* getBoundable(int i) const;
+
+	/**
+	 * Gets the minimum possible distance between the Boundables in
+	 * this pair.
+	 * If the members are both items, this will be the
+	 * exact distance between them.
+	 * Otherwise, this distance will be a lower bound on
+	 * the distances between the items in the members.
+	 *
+	 * @return the exact or lower bound distance for this pair
+	 */
+	double getDistance() const;
+
+	/**
+	 * Tests if both elements of the pair are leaf nodes
+	 */
+	bool isLeaves() const;
+
+	/// Tests whether the given Boundable is an AbstractNode
+	static bool isComposite(const Boundable* item);
+
+	/// Area of the Envelope bounds of the given Boundable
+	static double area(const Boundable* b);
+
+	/**
+	 * For a pair which is not a leaf
+	 * (i.e. has at least one composite boundable)
+	 * computes a list of new pairs
+	 * from the expansion of the larger boundable
+	 * and pushes those whose distance is below minDistance
+	 * onto the given queue.
+	 *
+	 * Ownership of the pushed pairs is transferred to the caller.
+	 */
+	void expandToQueue(BoundablePairQueue& priQ, double minDistance);
+
+private:
+
+	void expand(const Boundable* bndComposite, const Boundable* bndOther,
+	            bool isFlipped, BoundablePairQueue& priQ,
+	            double minDistance);
+};
+
+} // namespace geos::index::strtree
+} // namespace geos::index
+} // namespace geos
+
+#endif // GEOS_INDEX_STRTREE_BOUNDABLEPAIR_H
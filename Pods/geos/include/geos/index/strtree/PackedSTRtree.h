@@ -0,0 +1,247 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_STRTREE_PACKEDSTRTREE_H
+#define GEOS_INDEX_STRTREE_PACKEDSTRTREE_H
+
+#include <geos/export.h>
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Envelope;
+	}
+	namespace index {
+		class ItemVisitor;
+		class ItemPairVisitor;
+		namespace strtree {
+			class AbstractNode;
+		}
+	}
+}
+
+namespace geos {
+namespace index { // geos::index
+namespace strtree { // geos::index::strtree
+
+/** \brief
+ * A flat, contiguous copy of the nodes of a built STRtree.
+ *
+ * Nodes are stored in level order (the root is node 0) in a single
+ * array. The children of each node occupy a contiguous run of
+ * "slots"; the bounds of all slots are stored in structure-of-arrays
+ * form (minX[], minY[], maxX[], maxY[]), so scanning a node reads a few
+ * cache lines instead of chasing a pointer per child.
+ *
+ * A slot of an internal node refers to a child node index, a slot of a
+ * leaf node refers to an item index.
+ *
+ * Each node's run of slots is padded to a multiple of slotGroupSize,
+ * so the overlap kernel (see overlapMask) always works on whole
+ * vector registers.
+ *
+ * The packed copy can be queried concurrently. Once built it is only
+ * changed by remove(), which must not run during queries.
+ */
+class GEOS_DLL PackedSTRtree {
+
+public:
+
+	/// A node of the packed tree
+	struct Node {
+		/// Index of the first slot of this node
+		std::size_t childStart;
+
+		/// Number of slots of this node
+		std::size_t childCount;
+
+		/// Whether the slots refer to items rather than nodes
+		bool isLeaf;
+	};
+
+	/**
+	 * Number of slots tested per step by the widest overlap kernel
+	 * (four doubles per AVX register). Slot runs are padded to a
+	 * multiple of this.
+	 */
+	static const std::size_t slotGroupSize = 4;
+
+	/// Maximum number of slots tested by one overlapMask call
+	static const std::size_t maxMaskSlots = 32;
+
+	/**
+	 * Number of node pairs the top of a join is split into, at
+	 * least, before the pairs are walked independently (see join).
+	 */
+	static const std::size_t joinSplitSize = 64;
+
+	PackedSTRtree();
+
+	/**
+	 * Discards the current contents and packs the tree rooted at
+	 * the given node, which must have Envelope bounds.
+	 */
+	void build(const AbstractNode& root);
+
+	/// Discards the current contents
+	void clear();
+
+	/**
+	 * Makes the slot of item, found under itemEnv, match no
+	 * query. Node bounds are left as they are, and the item stays
+	 * counted by getNumItems().
+	 *
+	 * The slot is the one AbstractSTRtree::remove() takes out of the
+	 * tree this was built from, if an item was inserted more than
+	 * once: the last one of the first leaf holding the item, leaves
+	 * being searched depth first, in order, under the nodes whose
+	 * bounds intersect itemEnv.
+	 *
+	 * @return whether the item was found
+	 */
+	bool remove(const geom::Envelope& itemEnv, void* item);
+
+	bool isEmpty() const { return items.empty(); }
+
+	std::size_t getNumItems() const { return items.size(); }
+
+	std::size_t getNumNodes() const { return nodes.size(); }
+
+	/**
+	 * Visits the items whose bounds intersect the given envelope,
+	 * in the same order as a depth-first walk of the pointer tree.
+	 */
+	void query(const geom::Envelope& searchEnv, ItemVisitor& visitor) const;
+
+	void query(const geom::Envelope& searchEnv,
+	           std::vector<void*>& matches) const;
+
+	/**
+	 * Runs the queries searchEnvs[queryIds[i]], i in [0, count),
+	 * in a single walk of the tree: a node is scanned once for all
+	 * the queries that reach it.
+	 *
+	 * Appends (query index, item) pairs. The hits of each query are
+	 * in the same order as query() returns them.
+	 */
+	void queryBatch(const std::vector<const geom::Envelope*>& searchEnvs,
+	                const std::size_t* queryIds, std::size_t count,
+	                std::vector< std::pair<std::size_t, void*> >& hits) const;
+
+	/**
+	 * Reports each pair of an item of this tree and an item of
+	 * other whose bounds intersect.
+	 *
+	 * Both trees are walked together: a pair of nodes is only
+	 * descended into if their bounds intersect, and only the
+	 * children of each which intersect the other node are paired.
+	 *
+	 * The top of the walk is first split breadth-first into at
+	 * least joinSplitSize node pairs, which are then walked depth
+	 * first, on up to numThreads threads. Pairs found by worker
+	 * threads are buffered and reported from the calling thread,
+	 * so the visitor need not be thread-safe. Pairs are reported in
+	 * the same order for any number of threads.
+	 */
+	void join(const PackedSTRtree& other, ItemPairVisitor& visitor,
+	          std::size_t numThreads=1) const;
+
+	/**
+	 * Tests a query envelope against count consecutive slot bounds,
+	 * given in structure-of-arrays form.
+	 *
+	 * Uses AVX, SSE2 or NEON when the target supports them, and a
+	 * scalar loop otherwise.
+	 *
+	 * @param count number of slots to test, at most maxMaskSlots
+	 * @return a mask with bit i set if slot i intersects the query
+	 */
+	static unsigned int overlapMask(const double* minX, const double* minY,
+	                                const double* maxX, const double* maxY,
+	                                std::size_t count,
+	                                double qMinX, double qMinY,
+	                                double qMaxX, double qMaxY);
+
+private:
+
+	friend class STRtreeSnapshot;
+
+	/// A pair of nodes of a join, with their bounds
+	struct JoinFrame;
+
+	/// Walks part of a join on a worker thread
+	class JoinTask;
+
+	template <class Sink>
+	void queryImpl(const geom::Envelope& searchEnv, Sink& sink) const;
+
+	/**
+	 * Reports the item pairs of a pair of leaves, or appends the
+	 * intersecting child node pairs of the frame to next.
+	 */
+	template <class Sink>
+	void joinStep(const PackedSTRtree& other, const JoinFrame& frame,
+	              std::vector<JoinFrame>& next, Sink& sink) const;
+
+	/// Walks a node pair depth first, reporting its item pairs
+	template <class Sink>
+	void joinFrom(const PackedSTRtree& other, const JoinFrame& frame,
+	              Sink& sink) const;
+
+	/**
+	 * Mask of the slots in [first, first+count) intersecting the
+	 * query. count is at most maxMaskSlots.
+	 */
+	unsigned int slotMask(std::size_t first, std::size_t count,
+	                      double qMinX, double qMinY,
+	                      double qMaxX, double qMaxY) const;
+
+	std::vector<Node> nodes;
+
+	// Per-slot bounds, structure-of-arrays
+	std::vector<double> minX;
+	std::vector<double> minY;
+	std::vector<double> maxX;
+	std::vector<double> maxY;
+
+	// Per-slot child node index (internal nodes) or
+	// item index (leaf nodes)
+	std::vector<std::size_t> childRef;
+
+	std::vector<void*> items;
+
+	// Bounds of the root, used to reject queries early
+	double rootMinX, rootMinY, rootMaxX, rootMaxY;
+
+	// Declare type as noncopyable
+	PackedSTRtree(const PackedSTRtree& other);
+	PackedSTRtree& operator=(const PackedSTRtree& rhs);
+};
+
+} // namespace geos::index::strtree
+} // namespace geos::index
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_INDEX_STRTREE_PACKEDSTRTREE_H
@@ -21,7 +21,9 @@
 
 #include <geos/export.h>
 #include <geos/index/strtree/AbstractSTRtree.h> // for inheritance
+#include <geos/index/strtree/PackedSTRtree.h> // for composition
 #include <geos/index/SpatialIndex.h> // for inheritance
+#include <geos/index/BatchQuery.h> // for BatchQueryHit
 #include <geos/geom/Envelope.h> // for inlines
 
 #include <vector>
@@ -34,8 +36,11 @@
 // Forward declarations
 namespace geos {
 	namespace index { 
+		class ItemPairVisitor;
 		namespace strtree { 
 			class Boundable;
+			class BoundablePair;
+			class ItemDistance;
 		}
 	}
 }
@@ -76,6 +81,10 @@ private:
 	 * For each slice, orders the items by the y-values of the midpoints, and
 	 * group them into runs of size M (the node capacity). For each run, creates
 	 * a new (parent) node.
+	 *
+	 * The sorts are stable, and run in parallel with more than one
+	 * build thread, so the result does not depend on the number of
+	 * threads.
 	 */
 	std::auto_ptr<BoundableList> createParentBoundables(BoundableList* childBoundables, int newLevel);
 
@@ -83,8 +92,26 @@ private:
 
 	STRIntersectsOp intersectsOp;
 
+	/// Flat copy of the built tree, used by query
+	PackedSTRtree packed;
+
+	/// Whether packed reflects the current pointer tree
+	bool packedValid;
+
+	/// Whether items were removed from packed since it was built
+	bool packedHasRemovals;
+
+	/// Number of threads used by build()
+	std::size_t buildThreads;
+
+	/// Sorts by the y-values of the midpoints, stably, in
+	/// parallel with more than one build thread
 	std::auto_ptr<BoundableList> sortBoundables(const BoundableList* input);
 
+	/**
+	 * @param childBoundables Must be sorted by the y-value of
+	 *        the envelope midpoints
+	 */
 	std::auto_ptr<BoundableList> createParentBoundablesFromVerticalSlice(
 			BoundableList* childBoundables,
 			int newLevel);
@@ -98,6 +125,14 @@ private:
 			BoundableList* childBoundables,
 			size_t sliceCount);
 
+	/**
+	 * Runs the Branch-and-Bound search starting from initBndPair,
+	 * collecting up to k leaf pairs in order of increasing distance.
+	 * Takes ownership of initBndPair.
+	 */
+	void nearestNeighbours(BoundablePair* initBndPair, std::size_t k,
+			std::vector<void*>& neighbours);
+
 
 protected:
 
@@ -113,13 +148,31 @@ public:
 
 	/**
 	 * Constructs an STRtree with the given maximum number of child nodes that
-	 * a node may have
+	 * a node may have.
+	 *
+	 * The default capacity is a multiple of
+	 * PackedSTRtree::slotGroupSize, so that full nodes are scanned
+	 * with no padding.
+	 *
+	 * @param nodeCapacity the maximum number of children of a node
+	 * @param buildThreads the number of threads used to sort items
+	 *        while building the tree. The tree built is the same
+	 *        for any number of threads.
 	 */
-	STRtree(std::size_t nodeCapacity=10);
+	STRtree(std::size_t nodeCapacity=12, std::size_t buildThreads=1);
 
 	void insert(const geom::Envelope *itemEnv,void* item);
 
-	//static double centreX(const geom::Envelope *e);
+	/**
+	 * Builds the pointer tree, then packs it into a flat,
+	 * level-ordered layout which query() walks by index.
+	 * Packs it again if items were removed since.
+	 */
+	void build();
+
+	static double centreX(const geom::Envelope *e) {
+		return STRtree::avg(e->getMinX(), e->getMaxX());
+	}
 
 	static double avg(double a, double b) {
 		return (a + b) / 2.0;
@@ -129,17 +182,110 @@ public:
 		return STRtree::avg(e->getMinY(), e->getMaxY());
 	}
 
+	/**
+	 * Returns the packed copy of this tree which queries walk.
+	 *
+	 * The reference is invalidated by the next insertion or removal.
+	 * Also builds the tree, if necessary, and packs it again if
+	 * items were removed, so that it holds no removed items.
+	 */
+	const PackedSTRtree& getPackedTree() {
+		if (!packedValid || packedHasRemovals) build();
+		return packed;
+	}
+
+	///  Also builds the tree, if necessary.
 	void query(const geom::Envelope *searchEnv, std::vector<void*>& matches) {
-		AbstractSTRtree::query(searchEnv, matches);
+		if (!packedValid) build();
+		packed.query(*searchEnv, matches);
 	}
 
+	///  Also builds the tree, if necessary.
 	void query(const geom::Envelope *searchEnv, ItemVisitor& visitor) {
-		return AbstractSTRtree::query(searchEnv, visitor);
+		if (!packedValid) build();
+		packed.query(*searchEnv, visitor);
 	}
 
-	bool remove(const geom::Envelope *itemEnv, void* item) {
-		return AbstractSTRtree::remove(itemEnv, item);
-	}
+	/**
+	 * Runs a batch of envelope queries.
+	 *
+	 * Appends a (query index, item) pair to hits for each item
+	 * query(searchEnvs[i], ...) would return. Hits are ordered by
+	 * query index, then in query() order. Nearby queries share
+	 * their walks of the tree.
+	 *
+	 * Also builds the tree, if necessary.
+	 *
+	 * @param searchEnvs the query envelopes; NULL entries match nothing
+	 * @param hits the vector to append the hits to
+	 * @param numThreads the maximum number of threads to use
+	 * @see BatchQuery
+	 */
+	void queryBatch(const std::vector<const geom::Envelope*>& searchEnvs,
+			std::vector<BatchQueryHit>& hits,
+			std::size_t numThreads=1);
+
+	/**
+	 * Reports each pair of an item of this tree and an item of
+	 * other whose envelopes intersect, by walking both trees
+	 * together. Node pairs whose envelopes are disjoint are
+	 * skipped whole.
+	 *
+	 * Also builds both trees, if necessary.
+	 *
+	 * @param other the tree to join with, which may be this tree
+	 * @param visitor receives (item of this tree, item of other)
+	 *        pairs, always from the calling thread
+	 * @param numThreads the maximum number of threads to use
+	 * @see PackedSTRtree::join
+	 */
+	void join(STRtree& other, ItemPairVisitor& visitor,
+			std::size_t numThreads=1);
+
+	/**
+	 * Also builds the tree, if necessary.
+	 *
+	 * The item is dropped from the packed copy in place, which
+	 * queries keep walking without packing the tree again.
+	 */
+	bool remove(const geom::Envelope *itemEnv, void* item);
+
+	/**
+	 * Finds the item in this tree which is nearest to the given item,
+	 * using ItemDistance as the distance metric.
+	 *
+	 * A Branch-and-Bound tree traversal algorithm is used
+	 * to provide an efficient search.
+	 *
+	 * The query item does not have to be contained in the tree,
+	 * but it does have to be compatible with the itemDist
+	 * distance metric.
+	 *
+	 * Also builds the tree, if necessary.
+	 *
+	 * @param env the envelope of the query item
+	 * @param item the item to find the nearest neighbour of
+	 * @param itemDist a distance metric applicable to the items in
+	 *        this tree and the query item
+	 * @return the nearest item in this tree, or NULL if the tree is empty
+	 */
+	const void* nearestNeighbour(const geom::Envelope *env, const void* item,
+			ItemDistance* itemDist);
+
+	/**
+	 * Finds up to k items in this tree which are nearest to the
+	 * given item, using ItemDistance as the distance metric.
+	 *
+	 * Items are appended to neighbours in order of increasing distance.
+	 * Fewer than k items are returned if the tree holds less than k.
+	 *
+	 * Also builds the tree, if necessary.
+	 *
+	 * @see nearestNeighbour(const geom::Envelope*, const void*, ItemDistance*)
+	 */
+	void nearestNeighbours(const geom::Envelope *env, const void* item,
+			ItemDistance* itemDist, std::size_t k,
+			std::vector<void*>& neighbours);
 };
 
 } // namespace geos::index::strtree
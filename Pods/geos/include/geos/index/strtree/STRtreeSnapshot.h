@@ -0,0 +1,187 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_STRTREE_STRTREESNAPSHOT_H
+#define GEOS_INDEX_STRTREE_STRTREESNAPSHOT_H
+
+#include <geos/export.h>
+#include <geos/platform.h> // for int64
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <iosfwd>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Envelope;
+	}
+	namespace index {
+		namespace strtree {
+			class PackedSTRtree;
+		}
+	}
+}
+
+namespace geos {
+namespace index { // geos::index
+namespace strtree { // geos::index::strtree
+
+/** \brief
+ * A read-only STRtree stored in a flat binary image, which can be
+ * queried in place.
+ *
+ * write() saves the packed form of a built STRtree (see
+ * PackedSTRtree) with a 64-bit identifier per item, since item
+ * pointers mean nothing outside the writing process. open() maps
+ * such a file into memory; nothing is decoded, queries read the
+ * node and slot arrays straight from the mapping, so opening costs
+ * the same for any size of tree.
+ *
+ * The image holds, after a fixed header, 8-byte aligned arrays of
+ * node records, slot bounds (structure-of-arrays), slot references,
+ * item identifiers and item slots. Values are in the byte order of
+ * the writing host; an image of the other byte order is rejected.
+ *
+ * Images are only checked structurally when opened. References read
+ * during a query are range-checked, so a damaged image makes queries
+ * throw rather than read outside the image.
+ *
+ * Snapshots are immutable and can be queried concurrently.
+ */
+class GEOS_DLL STRtreeSnapshot {
+
+public:
+
+	/// Maps the items of a tree being saved to their identifiers
+	class GEOS_DLL ItemIdentifier {
+	public:
+		virtual ~ItemIdentifier() {}
+
+		virtual int64 getId(void* item)=0;
+	};
+
+	/**
+	 * Writes an image of the given packed tree.
+	 *
+	 * @param tree the tree to save, see STRtree::getPackedTree()
+	 * @param ids gives the identifier stored for each item
+	 * @param os the stream to write to, opened in binary mode
+	 * @throws util::GEOSException if the stream fails
+	 */
+	static void write(const PackedSTRtree& tree, ItemIdentifier& ids,
+	                  std::ostream& os);
+
+	/**
+	 * Opens an image file written by write().
+	 *
+	 * The file is memory-mapped where the platform supports it,
+	 * and read into memory otherwise.
+	 *
+	 * @throws util::GEOSException if the file cannot be read or is
+	 *         not a valid image
+	 */
+	static std::auto_ptr<STRtreeSnapshot> open(const std::string& filename);
+
+	/**
+	 * Wraps an image held in memory by the caller, which must
+	 * outlive the snapshot.
+	 *
+	 * @param data the image, aligned to 8 bytes
+	 * @param size the size of the image in bytes
+	 * @throws util::GEOSException if the image is not valid
+	 */
+	STRtreeSnapshot(const void* data, std::size_t size);
+
+	~STRtreeSnapshot();
+
+	std::size_t getNumItems() const { return numItems; }
+
+	/// Identifier of the i-th item, 0 <= i < getNumItems()
+	int64 getItemId(std::size_t i) const;
+
+	/// Bounds of the i-th item, 0 <= i < getNumItems()
+	void getItemEnvelope(std::size_t i, geom::Envelope& env) const;
+
+	/**
+	 * Appends the identifiers of the items whose bounds intersect
+	 * the given envelope, in the order STRtree::query() would
+	 * return the items.
+	 */
+	void query(const geom::Envelope& searchEnv, std::vector<int64>& ids) const;
+
+private:
+
+	STRtreeSnapshot();
+
+	/// Locates the arrays of the image, checking its header
+	void attach(const void* data, std::size_t size);
+
+	/// Releases the mapping or buffer opened by open()
+	void release();
+
+	unsigned int slotMask(std::size_t first, std::size_t count,
+	                      double qMinX, double qMinY,
+	                      double qMaxX, double qMaxY) const;
+
+	std::size_t numNodes;
+	std::size_t numSlots;
+	std::size_t numItems;
+
+	double rootMinX, rootMinY, rootMaxX, rootMaxY;
+
+	// Per-node childStart, childCount and isLeaf
+	const int64* nodes;
+
+	// Per-slot bounds, structure-of-arrays
+	const double* minX;
+	const double* minY;
+	const double* maxX;
+	const double* maxY;
+
+	// Per-slot child node index (internal nodes) or
+	// item index (leaf nodes)
+	const int64* childRef;
+
+	const int64* itemIds;
+
+	// Slot holding the bounds of each item
+	const int64* itemSlots;
+
+	// Memory mapping, when opened from a file
+	void* mapping;
+	std::size_t mappingSize;
+
+	// Copy of the file, where it cannot be mapped
+	std::vector<int64> buffer;
+
+	// Declare type as noncopyable
+	STRtreeSnapshot(const STRtreeSnapshot& other);
+	STRtreeSnapshot& operator=(const STRtreeSnapshot& rhs);
+};
+
+} // namespace geos::index::strtree
+} // namespace geos::index
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_INDEX_STRTREE_STRTREESNAPSHOT_H
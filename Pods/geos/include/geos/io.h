@@ -47,8 +47,15 @@ namespace io { // geos.io
 
 #include <geos/io/ByteOrderDataInStream.h>
 #include <geos/io/ByteOrderValues.h>
+#include <geos/io/DoubleConversion.h>
+#include <geos/io/GeoJSON.h>
+#include <geos/io/GeoJSONReader.h>
+#include <geos/io/GeoJSONWriter.h>
 #include <geos/io/ParseException.h>
 //#include <geos/io/StringTokenizer.h>
+#include <geos/io/TWKBConstants.h>
+#include <geos/io/TWKBReader.h>
+#include <geos/io/TWKBWriter.h>
 #include <geos/io/WKBConstants.h>
 #include <geos/io/WKBReader.h>
 #include <geos/io/WKBWriter.h>
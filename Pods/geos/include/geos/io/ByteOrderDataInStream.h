@@ -28,6 +28,7 @@
 #include <geos/inline.h>
 
 #include <iosfwd> // ostream, istream (if we remove inlines)
+#include <cstddef> // for size_t
 
 namespace geos {
 namespace io {
@@ -36,7 +37,10 @@ namespace io {
  * \class ByteOrderDataInStream io.h geos.h
  * 
  * Allows reading an stream of primitive datatypes from an underlying
- * istream, with the representation being in either common byte ordering.
+ * istream, or from a byte array, with the representation being in
+ * either common byte ordering.
+ *
+ * The byte array is read in place: it must outlive the reads.
  *
  */
 class GEOS_DLL ByteOrderDataInStream {
@@ -53,6 +57,12 @@ public:
 	 */
 	void setInStream(std::istream *s);
 
+	/**
+	 * Reads from the size bytes at buf from now on, rather than
+	 * from an istream.
+	 */
+	void setInBuffer(const unsigned char *buf, std::size_t size);
+
 	void setOrder(int order);
 
 	unsigned char readByte(); // throws ParseException
@@ -63,10 +73,31 @@ public:
 
 	double readDouble(); // throws ParseException
 
+	/**
+	 * Reads n doubles into out, copying them at once and
+	 * swapping their bytes if the order is not the machine's.
+	 */
+	void readDoubles(double *out, std::size_t n); // throws ParseException
+
+	/**
+	 * Throws ParseException if reading a byte array with less than
+	 * count items of itemSize bytes left, which allows checking a
+	 * count read from the input before allocating for it.
+	 * Does nothing for an istream.
+	 */
+	void checkAvailable(std::size_t count, std::size_t itemSize=1); // throws ParseException
+
 private:
 	int byteOrder;
 	std::istream *stream;
 
+	// byte array being read, when stream is NULL
+	const unsigned char *data;
+	const unsigned char *dataEnd;
+
+	/// Returns the next n bytes of the array and skips them
+	const unsigned char *take(std::size_t n); // throws ParseException
+
 	// buffers to hold primitive datatypes
 	unsigned char buf[8];
 
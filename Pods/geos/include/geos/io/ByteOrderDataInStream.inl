@@ -26,6 +26,8 @@
 #include <geos/util/Machine.h> // for getMachineByteOrder
 
 #include <iostream> // ostream, istream 
+#include <cstring> // for memcpy
+#include <algorithm> // for swap
 
 namespace geos {
 namespace io {
@@ -34,7 +36,9 @@ INLINE
 ByteOrderDataInStream::ByteOrderDataInStream(std::istream *s)
 	:
 	byteOrder(getMachineByteOrder()),
-	stream(s)
+	stream(s),
+	data(0),
+	dataEnd(0)
 {
 }
 
@@ -47,6 +51,32 @@ INLINE void
 ByteOrderDataInStream::setInStream(std::istream *s)
 {
 	stream=s;
+	data=dataEnd=0;
+}
+
+INLINE void 
+ByteOrderDataInStream::setInBuffer(const unsigned char *buf, std::size_t size)
+{
+	stream=0;
+	data=buf;
+	dataEnd=buf+size;
+}
+
+INLINE const unsigned char *
+ByteOrderDataInStream::take(std::size_t n)
+{
+	checkAvailable(n);
+	const unsigned char *p=data;
+	data+=n;
+	return p;
+}
+
+INLINE void
+ByteOrderDataInStream::checkAvailable(std::size_t count, std::size_t itemSize)
+{
+	if ( stream ) return;
+	if ( static_cast<std::size_t>(dataEnd-data)/itemSize < count )
+		throw  ParseException("Unexpected EOF parsing WKB");
 }
 
 INLINE void
@@ -58,6 +88,7 @@ ByteOrderDataInStream::setOrder(int order)
 INLINE unsigned char
 ByteOrderDataInStream::readByte() // throws ParseException
 {
+	if ( ! stream ) return *take(1);
 	stream->read(reinterpret_cast<char *>(buf), 1);
 	if ( stream->eof() )
 		throw  ParseException("Unexpected EOF parsing WKB");
@@ -67,6 +98,7 @@ ByteOrderDataInStream::readByte() // throws ParseException
 INLINE int
 ByteOrderDataInStream::readInt() 
 {
+	if ( ! stream ) return ByteOrderValues::getInt(take(4), byteOrder);
 	stream->read(reinterpret_cast<char *>(buf), 4);
 	if ( stream->eof() )
 		throw  ParseException("Unexpected EOF parsing WKB");
@@ -76,6 +108,7 @@ ByteOrderDataInStream::readInt()
 INLINE long
 ByteOrderDataInStream::readLong() 
 {
+	if ( ! stream ) return static_cast<long>(ByteOrderValues::getLong(take(8), byteOrder));
 	stream->read(reinterpret_cast<char *>(buf), 8);
 	if ( stream->eof() )
 		throw  ParseException("Unexpected EOF parsing WKB");
@@ -85,12 +118,44 @@ ByteOrderDataInStream::readLong()
 INLINE double
 ByteOrderDataInStream::readDouble() 
 {
+	if ( ! stream ) return ByteOrderValues::getDouble(take(8), byteOrder);
 	stream->read(reinterpret_cast<char *>(buf), 8);
 	if ( stream->eof() )
 		throw  ParseException("Unexpected EOF parsing WKB");
 	return ByteOrderValues::getDouble(buf, byteOrder);
 }
 
+INLINE void
+ByteOrderDataInStream::readDoubles(double *out, std::size_t n)
+{
+	if ( ! n ) return;
+
+	checkAvailable(n, 8);
+	std::size_t nbytes=n*8;
+	if ( stream )
+	{
+		stream->read(reinterpret_cast<char *>(out), nbytes);
+		if ( stream->eof() )
+			throw  ParseException("Unexpected EOF parsing WKB");
+	}
+	else
+	{
+		std::memcpy(out, take(nbytes), nbytes);
+	}
+
+	if ( byteOrder != getMachineByteOrder() )
+	{
+		unsigned char *p=reinterpret_cast<unsigned char *>(out);
+		for (std::size_t i=0; i<n; ++i, p+=8)
+		{
+			std::swap(p[0], p[7]);
+			std::swap(p[1], p[6]);
+			std::swap(p[2], p[5]);
+			std::swap(p[3], p[4]);
+		}
+	}
+}
+
 } // namespace io
 } // namespace geos
 
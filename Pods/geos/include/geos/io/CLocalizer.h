@@ -33,6 +33,14 @@ namespace io {
 
 /**
  * \class CLocalizer io.h geos.h
+ *
+ * Used to switch LC_NUMERIC to "C" for the lifetime of the object.
+ *
+ * This is now a no-op: WKTReader and WKTWriter no longer depend on
+ * the locale, and setlocale() is not thread-safe. Kept for source
+ * compatibility only.
+ *
+ * @deprecated there is no need for it any more
  */
 class GEOS_DLL CLocalizer
 {
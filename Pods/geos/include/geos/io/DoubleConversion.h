@@ -0,0 +1,87 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_IO_DOUBLECONVERSION_H
+#define GEOS_IO_DOUBLECONVERSION_H
+
+#include <geos/export.h>
+
+#include <cstddef>
+
+namespace geos {
+namespace io {
+
+/*
+ * \class DoubleConversion io.h geos.h
+ *
+ * Conversions between doubles and their decimal text, which do not
+ * depend on the locale.
+ *
+ * Unlike strtod() and iostreams, these always use '.' as the decimal
+ * separator, whatever setlocale() or std::locale::global() were told,
+ * so they need no locale switching and are safe to use while other
+ * threads change the locale.
+ */
+class GEOS_DLL DoubleConversion {
+
+public:
+
+	/**
+	 * Parses the text from begin to end as a double.
+	 *
+	 * Accepts what strtod() accepts in the "C" locale, except
+	 * hexadecimal numbers and leading spaces: an optional sign,
+	 * digits with an optional '.', an optional exponent, or
+	 * "inf", "infinity" or "nan" in any case.
+	 *
+	 * The result is the double nearest to the decimal value, ties
+	 * to even, as with strtod(): the text of any double written
+	 * with 17 significant digits reads back as the same double.
+	 *
+	 * @param begin the first character of the number
+	 * @param end one past the last character of the number
+	 * @param value set to the number read, if any
+	 * @return false if the text is not entirely a number, in which
+	 *         case value is unchanged
+	 */
+	static bool parse(const char *begin, const char *end, double &value);
+
+	/// Size of the buffers given to toShortest(), null included
+	enum { SHORTEST_BUFFER_SIZE = 32 };
+
+	/**
+	 * Writes value with the fewest digits that parse() and strtod()
+	 * read back as the same double.
+	 *
+	 * Uses Grisu2 from F. Loitsch, "Printing Floating-Point Numbers
+	 * Quickly and Accurately with Integers" (PLDI 2010), which needs
+	 * no big integers. The text always reads back as value, but in
+	 * rare cases has more digits than needed, as 9.999999999999999e+22
+	 * for 1e+23.
+	 *
+	 * The digits are laid out as printf("%.17g") would, without
+	 * trailing zeros: "0.1", "-120", "1e-05", "1.5e+300".
+	 * Infinities and NaN are written "inf", "-inf" and "nan".
+	 *
+	 * @param value the number to write
+	 * @param buffer at least SHORTEST_BUFFER_SIZE chars, the text is
+	 *        null terminated
+	 * @return the length of the text
+	 */
+	static std::size_t toShortest(double value, char *buffer);
+
+};
+
+} // namespace io
+} // namespace geos
+
+#endif // #ifndef GEOS_IO_DOUBLECONVERSION_H
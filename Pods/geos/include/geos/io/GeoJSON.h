@@ -0,0 +1,131 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_IO_GEOJSON_H
+#define GEOS_IO_GEOJSON_H
+
+#include <geos/export.h>
+
+#include <memory> // for auto_ptr
+#include <string>
+#include <vector>
+#include <cstddef> // for size_t
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Geometry;
+	}
+}
+
+namespace geos {
+namespace io {
+
+/**
+ * \class GeoJSONFeature io.h geos.h
+ *
+ * \brief A GeoJSON Feature: a Geometry, with its id and properties
+ * kept as JSON text.
+ *
+ * The id and the properties are the exact text of the input, so
+ * they can be handed to any JSON library, or written back as they
+ * were, without GEOS knowing anything of their content.
+ *
+ * See GeoJSONReader and GeoJSONWriter.
+ */
+class GEOS_DLL GeoJSONFeature {
+
+public:
+
+	/**
+	 * @param geometry the geometry, NULL for a null geometry
+	 * @param id the JSON text of the id, empty if none
+	 * @param properties the JSON text of the properties, empty
+	 *        if none
+	 */
+	GeoJSONFeature(std::auto_ptr<geom::Geometry> geometry,
+			const std::string &id, const std::string &properties);
+
+	~GeoJSONFeature();
+
+	/// The geometry, NULL for a null geometry or once released
+	const geom::Geometry* getGeometry() const { return geometry; }
+
+	/// Gives the geometry to the caller, leaving NULL here
+	std::auto_ptr<geom::Geometry> releaseGeometry();
+
+	/// The JSON text of the "id" member, as "12" or "\"a\"", empty if none
+	const std::string& getId() const { return id; }
+
+	/// The JSON text of the "properties" member, "null" if none
+	const std::string& getProperties() const { return properties; }
+
+private:
+
+	geom::Geometry* geometry;
+
+	std::string id;
+
+	std::string properties;
+
+	// Declare type as noncopyable
+	GeoJSONFeature(const GeoJSONFeature& other);
+	GeoJSONFeature& operator=(const GeoJSONFeature& rhs);
+};
+
+/**
+ * \class GeoJSONFeatureCollection io.h geos.h
+ *
+ * \brief The features of a GeoJSON FeatureCollection, which it owns.
+ */
+class GEOS_DLL GeoJSONFeatureCollection {
+
+public:
+
+	GeoJSONFeatureCollection();
+
+	~GeoJSONFeatureCollection();
+
+	/// Appends a feature, taking ownership of it
+	void add(std::auto_ptr<GeoJSONFeature> feature);
+
+	std::size_t getSize() const { return features.size(); }
+
+	const GeoJSONFeature& getFeature(std::size_t i) const
+	{
+		return *features[i];
+	}
+
+	GeoJSONFeature& getFeature(std::size_t i) { return *features[i]; }
+
+private:
+
+	std::vector<GeoJSONFeature*> features;
+
+	// Declare type as noncopyable
+	GeoJSONFeatureCollection(const GeoJSONFeatureCollection& other);
+	GeoJSONFeatureCollection& operator=(const GeoJSONFeatureCollection& rhs);
+};
+
+} // namespace geos.io
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // #ifndef GEOS_IO_GEOJSON_H
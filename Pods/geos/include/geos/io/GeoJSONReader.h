@@ -0,0 +1,117 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_IO_GEOJSONREADER_H
+#define GEOS_IO_GEOJSONREADER_H
+
+#include <geos/export.h>
+
+#include <memory> // for auto_ptr
+#include <string>
+#include <cstddef> // for size_t
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Geometry;
+		class GeometryFactory;
+	}
+	namespace io {
+		class GeoJSONFeatureCollection;
+	}
+}
+
+namespace geos {
+namespace io {
+
+/**
+ * \class GeoJSONReader io.h geos.h
+ *
+ * \brief Reads Geometries and Features from GeoJSON (RFC 7946).
+ *
+ * The text is parsed in a single pass, without building a JSON tree:
+ * positions go straight into the coordinates of the geometries, and
+ * the members GEOS has no use for, such as the properties of the
+ * features, are only scanned. Members may come in any order.
+ *
+ * Positions may have a third ordinate, read as z; any more are
+ * ignored. Coordinates are rounded to the precision model of the
+ * factory. Syntax errors, objects nested more than 256 deep, and
+ * coordinates which do not match the geometry type, throw
+ * ParseException.
+ *
+ * This class is not thread-safe; each thread should create its own
+ * instance. See also GeoJSONWriter.
+ */
+class GEOS_DLL GeoJSONReader {
+
+public:
+
+	/**
+	 * \brief Initialize parser with given GeometryFactory.
+	 *
+	 * The factory must outlive the reader and the geometries read.
+	 */
+	GeoJSONReader(const geom::GeometryFactory &f);
+
+	/// Initialize parser with default GeometryFactory.
+	GeoJSONReader();
+
+	~GeoJSONReader();
+
+	/**
+	 * \brief Reads a Geometry from GeoJSON.
+	 *
+	 * A Feature gives its geometry, a FeatureCollection a
+	 * GeometryCollection of the geometries of its features, and
+	 * a null geometry an empty GeometryCollection.
+	 *
+	 * @param geoJson the GeoJSON text
+	 * @return the Geometry read, owned by the caller
+	 * @throws ParseException
+	 */
+	geom::Geometry* read(const std::string &geoJson);
+
+	/// Same as above, from size chars at geoJson
+	geom::Geometry* read(const char *geoJson, std::size_t size);
+
+	/**
+	 * \brief Reads the Features of GeoJSON.
+	 *
+	 * A FeatureCollection gives all its features, a Feature a
+	 * collection of itself, and a Geometry a collection of one
+	 * feature without id or properties.
+	 *
+	 * @param geoJson the GeoJSON text
+	 * @return the features read
+	 * @throws ParseException
+	 */
+	std::auto_ptr<GeoJSONFeatureCollection> readFeatures(
+			const std::string &geoJson);
+
+	/// Same as above, from size chars at geoJson
+	std::auto_ptr<GeoJSONFeatureCollection> readFeatures(
+			const char *geoJson, std::size_t size);
+
+private:
+
+	const geom::GeometryFactory &factory;
+
+	// Declare type as noncopyable
+	GeoJSONReader(const GeoJSONReader& other);
+	GeoJSONReader& operator=(const GeoJSONReader& rhs);
+};
+
+} // namespace geos.io
+} // namespace geos
+
+#endif // #ifndef GEOS_IO_GEOJSONREADER_H
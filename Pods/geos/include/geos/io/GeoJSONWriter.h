@@ -0,0 +1,107 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_IO_GEOJSONWRITER_H
+#define GEOS_IO_GEOJSONWRITER_H
+
+#include <geos/export.h>
+
+#include <string>
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class CoordinateSequence;
+		class Geometry;
+		class Polygon;
+	}
+	namespace io {
+		class GeoJSONFeature;
+		class GeoJSONFeatureCollection;
+		class Writer;
+	}
+}
+
+namespace geos {
+namespace io {
+
+/**
+ * \class GeoJSONWriter io.h geos.h
+ *
+ * \brief Outputs Geometries and Features as GeoJSON (RFC 7946).
+ *
+ * Numbers are written with the fewest digits which read back as the
+ * same double, and no spaces. LinearRings are written as LineStrings,
+ * and empty geometries with empty coordinates, as in
+ * {"type":"Point","coordinates":[]}.
+ *
+ * The id and properties of features are written as the JSON text
+ * they hold. GeoJSON has no text for infinite or NaN coordinates,
+ * which throw IllegalArgumentException. See also GeoJSONReader.
+ */
+class GEOS_DLL GeoJSONWriter {
+
+public:
+
+	GeoJSONWriter();
+
+	~GeoJSONWriter();
+
+	/// Returns the GeoJSON Geometry object of the given Geometry
+	std::string write(const geom::Geometry *geometry);
+
+	/// Sends the GeoJSON of the Geometry to the given Writer
+	void write(const geom::Geometry *geometry, Writer *writer);
+
+	/// Returns the GeoJSON FeatureCollection of the given features
+	std::string writeFeatures(const GeoJSONFeatureCollection &features);
+
+	/// Sends the GeoJSON FeatureCollection to the given Writer
+	void writeFeatures(const GeoJSONFeatureCollection &features,
+			Writer *writer);
+
+	/**
+	 * Sets the output dimension.
+	 *
+	 * @param newOutputDimension 2 or 3. With 3, z is written for
+	 *        geometries with three dimensions, where it is not NaN.
+	 */
+	void setOutputDimension(int newOutputDimension);
+
+	int getOutputDimension() const { return defaultOutputDimension; }
+
+private:
+
+	int defaultOutputDimension;
+
+	// for the geometry being written
+	int outputDimension;
+
+	void appendFeature(const GeoJSONFeature &feature, Writer *writer);
+
+	void appendGeometry(const geom::Geometry *geometry, Writer *writer);
+
+	void appendPolygonCoordinates(const geom::Polygon *polygon,
+			Writer *writer);
+
+	void appendSequence(const geom::CoordinateSequence &seq,
+			Writer *writer);
+
+	// Declare type as noncopyable
+	GeoJSONWriter(const GeoJSONWriter& other);
+	GeoJSONWriter& operator=(const GeoJSONWriter& rhs);
+};
+
+} // namespace geos.io
+} // namespace geos
+
+#endif // #ifndef GEOS_IO_GEOJSONWRITER_H
@@ -32,6 +32,16 @@
 namespace geos {
 namespace io {
 
+/*
+ * \class StringTokenizer io.h geos.h
+ *
+ * Splits a string into the tokens of WKT: '(', ')', ',', numbers and
+ * words, in a single pass over the string.
+ *
+ * Numbers are read with DoubleConversion, so the tokenizer does not
+ * depend on the locale. The tokenizer reads its own copy of the
+ * string, so temporaries may be given.
+ */
 class GEOS_DLL StringTokenizer {
 public:
 	enum {
@@ -48,10 +58,19 @@ public:
 	double getNVal();
 	std::string getSVal();
 private:
-	const std::string &str;
+	// iter and end point into it
+	const std::string str;
+
+	const char *iter;
+	const char *end;
+
+	// the token found by peekNextToken(), until nextToken() skips it
+	bool peeked;
+	int peekedType;
+	const char *peekedEnd;
+
 	std::string stok;
 	double ntok;
-	std::string::const_iterator iter;
 
     // Declare type as noncopyable
     StringTokenizer(const StringTokenizer& other);
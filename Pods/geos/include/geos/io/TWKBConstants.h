@@ -0,0 +1,53 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_IO_TWKBCONSTANTS_H
+#define GEOS_IO_TWKBCONSTANTS_H
+
+namespace geos {
+namespace io {
+
+/// Constant values used by the TWKB format
+namespace TWKBConstants {
+
+	/// Geometry types, in the low 4 bits of the first byte
+	const int twkbPoint = 1;
+	const int twkbLineString = 2;
+	const int twkbPolygon = 3;
+	const int twkbMultiPoint = 4;
+	const int twkbMultiLineString = 5;
+	const int twkbMultiPolygon = 6;
+	const int twkbGeometryCollection = 7;
+
+	/// Flags of the metadata byte
+	const int twkbBBox = 0x01;
+	const int twkbSize = 0x02;
+	const int twkbIdList = 0x04;
+	const int twkbExtendedDims = 0x08;
+	const int twkbEmpty = 0x10;
+
+	/// Flags of the extended dimensions byte
+	const int twkbHasZ = 0x01;
+	const int twkbHasM = 0x02;
+
+	/// Range of the XY precision, in decimal digits
+	const int twkbMinPrecision = -8;
+	const int twkbMaxPrecision = 7;
+
+	/// Range of the Z and M precisions
+	const int twkbMaxExtendedPrecision = 7;
+}
+
+} // namespace geos::io
+} // namespace geos
+
+#endif // #ifndef GEOS_IO_TWKBCONSTANTS_H
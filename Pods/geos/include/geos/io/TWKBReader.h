@@ -0,0 +1,99 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_IO_TWKBREADER_H
+#define GEOS_IO_TWKBREADER_H
+
+#include <geos/export.h>
+#include <geos/platform.h> // for int64
+
+#include <vector>
+#include <cstddef> // for size_t
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Geometry;
+		class GeometryFactory;
+	}
+}
+
+namespace geos {
+namespace io {
+
+/**
+ * \class TWKBReader io.h geos.h
+ *
+ * \brief Reads a Geometry from Tiny Well-Known Binary format.
+ *
+ * TWKB stores coordinates as integers, scaled by a power of ten given
+ * in the header of each geometry, and delta encoded as zig-zag
+ * varints; see https://github.com/TWKB/Specification.
+ * Reading it is a single linear scan of the bytes.
+ *
+ * Bounding boxes and sizes are skipped. M values are read and
+ * dropped. X and Y are rounded to the precision model of the factory,
+ * as WKBReader does.
+ *
+ * This class is designed to support reuse of a single instance to read
+ * multiple geometries. This class is not thread-safe; each thread should
+ * create its own instance.
+ *
+ * @see TWKBWriter
+ */
+class GEOS_DLL TWKBReader {
+
+public:
+
+	TWKBReader(geom::GeometryFactory const& f): factory(f) {}
+
+	/// Inizialize parser with default GeometryFactory.
+	TWKBReader();
+
+	/**
+	 * \brief Reads a Geometry from a byte array.
+	 *
+	 * @param buf the TWKB
+	 * @param size the number of bytes at buf
+	 * @return the Geometry read
+	 * @throws ParseException
+	 */
+	geom::Geometry* read(const unsigned char *buf, std::size_t size);
+		// throws ParseException
+
+	/**
+	 * \brief Reads a Geometry and its id list from a byte array.
+	 *
+	 * @param buf the TWKB
+	 * @param size the number of bytes at buf
+	 * @param ids set to the ids of the components of the geometry,
+	 *        or emptied if it has no id list
+	 * @return the Geometry read
+	 * @throws ParseException
+	 */
+	geom::Geometry* read(const unsigned char *buf, std::size_t size,
+			std::vector<int64> &ids);
+		// throws ParseException
+
+private:
+
+	const geom::GeometryFactory &factory;
+
+    // Declare type as noncopyable
+    TWKBReader(const TWKBReader& other);
+    TWKBReader& operator=(const TWKBReader& rhs);
+};
+
+} // namespace io
+} // namespace geos
+
+#endif // #ifndef GEOS_IO_TWKBREADER_H
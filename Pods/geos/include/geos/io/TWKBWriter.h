@@ -0,0 +1,140 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_IO_TWKBWRITER_H
+#define GEOS_IO_TWKBWRITER_H
+
+#include <geos/export.h>
+#include <geos/platform.h> // for int64
+
+#include <vector>
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Geometry;
+	}
+}
+
+namespace geos {
+namespace io {
+
+/**
+ * \class TWKBWriter io.h geos.h
+ *
+ * \brief Writes a Geometry into Tiny Well-Known Binary format.
+ *
+ * Coordinates are rounded to the given number of decimal digits and
+ * delta encoded as zig-zag varints, which usually makes TWKB several
+ * times smaller than WKB; see https://github.com/TWKB/Specification.
+ *
+ * LinearRings are written as LineStrings. Empty Points cannot be
+ * components of MultiPoints in TWKB; an IllegalArgumentException is
+ * thrown if one is written, as it is for infinite or NaN coordinates,
+ * and for coordinates too large for the precision. A NaN z is
+ * written as 0.
+ *
+ * This class is designed to support reuse of a single instance to
+ * write multiple geometries. This class is not thread-safe; each
+ * thread should create its own instance.
+ *
+ * @see TWKBReader
+ */
+class GEOS_DLL TWKBWriter {
+
+public:
+
+	/*
+	 * \brief
+	 * Initializes writer with output dimension and precision.
+	 *
+	 * @param dims Supported values are 2 or 3.  Note that 3 indicates
+	 * up to 3 dimensions will be written but 2D TWKB is still produced
+	 * for 2D geometries.
+	 * @param precision number of decimal digits of x and y kept,
+	 * from -8 to 7. Negative values round to tens, hundreds...
+	 */
+	TWKBWriter(int dims=2, int precision=0);
+
+	~TWKBWriter();
+
+	int getOutputDimension() const { return defaultOutputDimension; }
+
+	/*
+	 * Sets the output dimension.
+	 *
+	 * @param newOutputDimension Supported values are 2 or 3.
+	 */
+	void setOutputDimension(int newOutputDimension);
+
+	int getPrecision() const { return precision; }
+
+	/// Sets the decimal digits of x and y, from -8 to 7
+	void setPrecision(int newPrecision);
+
+	int getPrecisionZ() const { return precisionZ; }
+
+	/// Sets the decimal digits of z, from 0 to 7
+	void setPrecisionZ(int newPrecisionZ);
+
+	bool getIncludeBBox() const { return includeBBox; }
+
+	/// Sets whether the bounding box of each geometry is written
+	void setIncludeBBox(bool newIncludeBBox) { includeBBox = newIncludeBBox; }
+
+	bool getIncludeSize() const { return includeSize; }
+
+	/// Sets whether the byte size of each geometry is written
+	void setIncludeSize(bool newIncludeSize) { includeSize = newIncludeSize; }
+
+	/**
+	 * \brief Write a Geometry to a byte buffer.
+	 *
+	 * @param g the geometry to write
+	 * @param buf the TWKB is appended to it
+	 * @throws IllegalArgumentException
+	 */
+	void write(const geom::Geometry &g, std::vector<unsigned char> &buf);
+
+	/**
+	 * \brief Write a Geometry with an id list to a byte buffer.
+	 *
+	 * @param g a multi geometry or collection
+	 * @param ids one id for each component of g
+	 * @param buf the TWKB is appended to it
+	 * @throws IllegalArgumentException if g is not a collection,
+	 *         or the ids do not match its components
+	 */
+	void write(const geom::Geometry &g, const std::vector<int64> &ids,
+			std::vector<unsigned char> &buf);
+
+private:
+
+	int defaultOutputDimension;
+
+	int precision;
+
+	int precisionZ;
+
+	bool includeBBox;
+
+	bool includeSize;
+
+    // Declare type as noncopyable
+    TWKBWriter(const TWKBWriter& other);
+    TWKBWriter& operator=(const TWKBWriter& rhs);
+};
+
+} // namespace io
+} // namespace geos
+
+#endif // #ifndef GEOS_IO_TWKBWRITER_H
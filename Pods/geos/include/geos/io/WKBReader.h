@@ -28,6 +28,7 @@
 #include <iosfwd> // ostream, istream
 #include <vector>
 #include <string>
+#include <cstddef> // for size_t
 
 #define BAD_GEOM_TYPE_MSG "Bad geometry type encountered in"
 
@@ -96,6 +97,20 @@ public:
 	geom::Geometry* read(std::istream &is);
 		// throws IOException, ParseException
 
+	/**
+	 * \brief Reads a Geometry from a byte array.
+	 *
+	 * The array is parsed in place, with no istream involved, which
+	 * makes this the faster way to read WKB already in memory.
+	 *
+	 * @param buf the WKB
+	 * @param size the number of bytes at buf
+	 * @return the Geometry read
+	 * @throws ParseException
+	 */
+	geom::Geometry* read(const unsigned char *buf, std::size_t size);
+		// throws ParseException
+
 	/**
 	 * \brief Reads a Geometry from an istream in hex format.
 	 *
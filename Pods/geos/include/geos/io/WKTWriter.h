@@ -64,6 +64,10 @@ namespace io {
  * The WKTWriter outputs coordinates rounded to the precision
  * model. No more than the maximum number of necessary decimal places will be
  * output.
+ *
+ * With setTrim(true), the coordinates of a FLOATING precision model
+ * are written with the fewest digits which read back as the same
+ * double, unless a rounding precision is set.
  * 
  * The Well-known Text format is defined in the <A
  * HREF="http://www.opengis.org/techno/specs.htm">OpenGIS Simple Features
@@ -134,6 +138,10 @@ public:
 	/**
 	 * Enables/disables trimming of unnecessary decimals
 	 *
+	 * Trimmed numbers of a FLOATING precision model, with no rounding
+	 * precision set, are written with the fewest digits which read
+	 * back as the same double.
+	 *
 	 * @param p0 the trim boolean
 	 *
 	 */
@@ -251,6 +259,9 @@ private:
 
 	bool trim;
 
+	// Set by writeFormatted(), see setTrim()
+	bool shortestNumbers;
+
 	int level;
 
 	int defaultOutputDimension;
@@ -262,6 +273,8 @@ private:
 			bool isFormatted, Writer *writer);
 
 	void indent(int level, Writer *writer);
+
+	void appendNumber(double d, Writer *writer);
 };
 
 } // namespace geos::io
@@ -38,6 +38,8 @@ public:
 	void reserve(std::size_t capacity);
 	~Writer();
 	void write(const std::string& txt);
+	void write(const char* txt);
+	void write(const char* txt, std::size_t len);
 	const std::string& toString();
 private:
 	std::string str;
@@ -82,6 +82,10 @@ public:
 			const std::vector<geomgraph::Node*> *nodes);
 			// throw(const TopologyException &)
 
+	/**
+	 * Return the Polygons, which take the rings of the
+	 * EdgeRings: call it only once, after all add() calls.
+	 */
   	std::vector<geom::Geometry*>* getPolygons();
 
 	/** \brief
@@ -25,6 +25,9 @@ namespace index {
 } // namespace geos
 
 #include <geos/index/SpatialIndex.h>
+#include <geos/index/BatchQuery.h>
+#include <geos/index/HilbertCode.h>
 #include <geos/index/ItemVisitor.h>
+#include <geos/index/ItemPairVisitor.h>
 
 #endif // GEOS_INDEX_H
@@ -0,0 +1,202 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_UTIL_ARENA_H
+#define GEOS_UTIL_ARENA_H
+
+#include <geos/export.h>
+
+#include <vector>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+namespace geos {
+namespace util { // geos::util
+
+/** \brief
+ * A region of memory from which objects are carved one after the
+ * other, and which is given back all at once by release().
+ *
+ * Objects are placed in an arena with <code>new (arena) T(...)</code>,
+ * which puts a small header before each of them. Those of
+ * ArenaAllocated classes can still be deleted one by one: this runs
+ * their destructor, but their memory is only given back on release().
+ * Their destructor must call deleting(), see ArenaAllocated.
+ *
+ * Objects whose destructor must run (to free memory they own outside
+ * of the arena) are registered with own(). On release(), those not
+ * deleted yet are destroyed, the last registered first. An object
+ * must therefore be registered after any arena object it owns,
+ * which is the case when it is registered once constructed.
+ *
+ * An Arena is not thread-safe, but objects of different arenas, or
+ * of the heap, may be deleted from several threads at once.
+ */
+class GEOS_DLL Arena {
+public:
+
+	/**
+	 * @param blockSize the size of the blocks memory is taken
+	 *        from the heap in; larger objects get a block of
+	 *        their own
+	 */
+	Arena(std::size_t blockSize=65536);
+
+	/// Calls release()
+	~Arena();
+
+	/**
+	 * Returns size bytes of memory, aligned for any type, which
+	 * stays valid until release()
+	 */
+	void* allocate(std::size_t size);
+
+	/**
+	 * Registers an object placed in this arena, to be destroyed
+	 * on release() unless deleted before
+	 */
+	template <class T>
+	void own(T* obj)
+	{
+		addFinalizer(obj, &destroy<T>);
+	}
+
+	/**
+	 * Destroys the registered objects which have not been deleted,
+	 * then gives back all the memory of the arena, which can be
+	 * used again afterwards.
+	 *
+	 * Pointers to objects in the arena are invalid from then on.
+	 */
+	void release();
+
+	/// The number of bytes taken from the heap
+	std::size_t getAllocatedSize() const { return allocatedSize; }
+
+	/// Allocates memory for an object, after its header
+	void* allocateObject(std::size_t size);
+
+	/**
+	 * Called last by the destructor of an object placed in an arena,
+	 * with a pointer to any part of it, so that the freeObject() which
+	 * follows on this thread knows the object is in an arena
+	 */
+	static void deleting(const void* part);
+
+	/**
+	 * Frees the memory of a deleted object of the given size, which
+	 * starts at p: if its destructor called deleting(), the memory
+	 * is only marked as unused, otherwise it is given back to the
+	 * heap, with no lookup
+	 */
+	static void freeObject(void* p, std::size_t size);
+
+	/**
+	 * Frees memory from <code>new (arena)</code> whose object was not
+	 * constructed, arena being NULL for the heap
+	 */
+	static void freeObject(void* p, Arena* arena);
+
+private:
+
+	// Put before each object from allocateObject()
+	struct ObjectHeader {
+		std::size_t live;
+	};
+
+	struct Finalizer {
+		void* obj;
+		void (*destroy)(void*);
+	};
+
+	template <class T>
+	static void destroy(void* obj)
+	{
+		static_cast<T*>(obj)->~T();
+	}
+
+	void addFinalizer(void* obj, void (*destroy)(void*));
+
+	char* addBlock(std::size_t size);
+
+	static ObjectHeader* headerOf(void* obj);
+
+	std::size_t blockSize;
+
+	std::vector<char*> blocks;
+
+	char* next;
+
+	std::size_t left;
+
+	std::size_t allocatedSize;
+
+	std::vector<Finalizer> finalizers;
+
+	// Declare type as noncopyable
+	Arena(const Arena& other);
+	Arena& operator=(const Arena& rhs);
+};
+
+/** \brief
+ * Base of the classes whose objects can be placed in an Arena.
+ *
+ * It adds nothing to the objects, and no operator new: they are
+ * allocated from the heap by <code>new T(...)</code>, and from an
+ * arena by <code>new (arena) T(...)</code>. It gives them an operator
+ * delete which frees either kind.
+ *
+ * That operator delete cannot find out by itself where an object is,
+ * so the derived classes remember it: whoever places an object in an
+ * arena tags it, and the destructor of a tagged object ends with a
+ * call to Arena::deleting(). Untagged objects are given back to the
+ * heap at once.
+ */
+class GEOS_DLL ArenaAllocated {
+public:
+
+	static void operator delete(void* p, std::size_t size)
+	{
+		Arena::freeObject(p, size);
+	}
+
+	// Called if a constructor throws after new (arena)
+	static void operator delete(void* p, Arena* arena)
+	{
+		Arena::freeObject(p, arena);
+	}
+
+protected:
+
+	ArenaAllocated() {}
+
+	~ArenaAllocated() {}
+};
+
+} // namespace geos::util
+} // namespace geos
+
+/// Places an object in arena, or on the heap if arena is NULL
+GEOS_DLL void* operator new(std::size_t size, geos::util::Arena* arena);
+
+// Called if a constructor throws after new (arena)
+GEOS_DLL void operator delete(void* p, geos::util::Arena* arena);
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_UTIL_ARENA_H
@@ -0,0 +1,58 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_UTIL_PARALLELFOR_H
+#define GEOS_UTIL_PARALLELFOR_H
+
+#include <geos/export.h>
+
+#include <cstddef>
+
+namespace geos {
+namespace util { // geos::util
+
+/** \brief
+ * A unit of work that can be run for a range of task indices,
+ * possibly from several threads at once.
+ *
+ * Implementations must make run() safe to call concurrently
+ * for distinct task indices.
+ */
+class GEOS_DLL ParallelTask {
+public:
+	virtual void run(std::size_t taskIndex)=0;
+
+	virtual ~ParallelTask() {}
+};
+
+/** \brief
+ * Runs task.run(i) for every i in [0, numTasks), spread over
+ * at most numThreads threads (the calling thread included).
+ *
+ * Tasks are assigned to threads statically (task i goes to thread
+ * i % numThreads), so which task runs where does not depend on timing.
+ * Returns once all tasks have completed.
+ *
+ * With numThreads <= 1, or where threads are not available,
+ * all tasks run serially on the calling thread, in order.
+ *
+ * @throws GEOSException if a task threw from a worker thread;
+ *         exceptions thrown on the calling thread propagate as-is
+ *         after the workers have been joined.
+ */
+GEOS_DLL void parallelFor(std::size_t numTasks, std::size_t numThreads,
+                          ParallelTask& task);
+
+} // namespace geos::util
+} // namespace geos
+
+#endif // GEOS_UTIL_PARALLELFOR_H
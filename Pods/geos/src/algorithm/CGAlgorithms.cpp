@@ -38,6 +38,70 @@ using namespace geos::geom;
 namespace geos {
 namespace algorithm { // geos.algorithm
 
+namespace {
+
+// Sums the terms of signedArea(), for forEachXY()
+struct SignedAreaSum {
+
+	SignedAreaSum()
+		: i(0), x0(0.0), ppy(0.0), cpx(0.0), cpy(0.0),
+		  npx(0.0), npy(0.0), sum(0.0)
+	{}
+
+	void operator()(double x, double y)
+	{
+		if ( i == 0 )
+		{
+			x0 = x;
+			cpy = y;
+		}
+		else
+		{
+			if ( i == 1 )
+			{
+				npx = x - x0;
+				npy = y;
+			}
+			ppy = cpy;
+			cpx = npx;
+			cpy = npy;
+			npx = x - x0;
+			npy = y;
+			sum += cpx * (npy - ppy);
+		}
+		++i;
+	}
+
+	size_t i;
+	double x0, ppy, cpx, cpy, npx, npy;
+	double sum;
+};
+
+// Sums the lengths of the segments, for forEachXY()
+struct LengthSum {
+
+	LengthSum() : x0(0.0), y0(0.0), len(0.0), started(false) {}
+
+	void operator()(double x1, double y1)
+	{
+		if ( started )
+		{
+			double dx = x1 - x0;
+			double dy = y1 - y0;
+			len += sqrt(dx * dx + dy * dy);
+		}
+		x0 = x1;
+		y0 = y1;
+		started = true;
+	}
+
+	double x0, y0;
+	double len;
+	bool started;
+};
+
+} // anonymous namespace
+
 /*public static*/
 int
 CGAlgorithms::orientationIndex(const Coordinate& p1,const Coordinate& p2,const Coordinate& q)
@@ -84,13 +148,14 @@ CGAlgorithms::isOnLine(const Coordinate& p, const CoordinateSequence* pt)
 	size_t ptsize = pt->getSize();
 	if ( ptsize == 0 ) return false;
 
-	const Coordinate *pp=&(pt->getAt(0));
+	Coordinate p0, p1;
+	pt->getAt(0, p0);
 	for(size_t i=1; i<ptsize; ++i)
 	{
-		const Coordinate &p1=pt->getAt(i);	
-		if ( LineIntersector::hasIntersection(p, *pp, p1) )
+		pt->getAt(i, p1);
+		if ( LineIntersector::hasIntersection(p, p0, p1) )
 			return true;
-		pp=&p1;
+		p0=p1;
 	}
 	return false;
 }
@@ -109,33 +174,40 @@ CGAlgorithms::isCCW(const CoordinateSequence* ring)
 	}
 
 	// find highest point
-	const Coordinate *hiPt=&ring->getAt(0);
+	double hiY=ring->getY(0);
 	int hiIndex=0;
 	for (std::size_t i=1; i<=nPts; ++i)
 	{
-		const Coordinate *p=&ring->getAt(i);
-		if (p->y > hiPt->y) {
-			hiPt = p;
+		double y=ring->getY(i);
+		if (y > hiY) {
+			hiY = y;
 			hiIndex = static_cast<int>(i);
 		}
 	}
+	Coordinate hi;
+	ring->getAt(hiIndex, hi);
+	const Coordinate *hiPt=&hi;
 
 	// find distinct point before highest point
+	Coordinate prevPt;
 	int iPrev = hiIndex;
 	do {
 		iPrev = iPrev - 1;
 		if (iPrev < 0)
             iPrev = static_cast<int>(nPts);
-	} while (ring->getAt(iPrev)==*hiPt && iPrev!=hiIndex);
+		ring->getAt(iPrev, prevPt);
+	} while (prevPt==*hiPt && iPrev!=hiIndex);
 
 	// find distinct point after highest point
+	Coordinate nextPt;
 	int iNext = hiIndex;
 	do {
 		iNext = (iNext + 1) % static_cast<int>(nPts);
-	} while (ring->getAt(iNext)==*hiPt && iNext != hiIndex);
+		ring->getAt(iNext, nextPt);
+	} while (nextPt==*hiPt && iNext != hiIndex);
 
-	const Coordinate *prev=&ring->getAt(iPrev);
-	const Coordinate *next=&ring->getAt(iNext);
+	const Coordinate *prev=&prevPt;
+	const Coordinate *next=&nextPt;
 
 	/*
 	 * This check catches cases where the ring contains an A-B-A
@@ -300,22 +372,9 @@ CGAlgorithms::signedArea(const CoordinateSequence* ring)
 
 	if (npts<3) return 0.0;
 
-	Coordinate pp;
-	Coordinate cp = ring->getAt(0);
-	Coordinate np = ring->getAt(1);
-	double x0 = cp.x;
-        np.x -= x0;
-	double sum=0.0;
-	for (size_t i=1; i<npts; ++i)
-	{
-		pp.y = cp.y;
-		cp.x = np.x;
-		cp.y = np.y;
-		ring->getAt(i, np);
-                np.x -= x0;
-		sum += cp.x * (np.y - pp.y);
-	}
-	return -sum/2.0;
+	SignedAreaSum area;
+	ring->forEachXY(area);
+	return -area.sum/2.0;
 }
 
 /*public static*/
@@ -327,27 +386,9 @@ CGAlgorithms::length(const CoordinateSequence* pts)
 	size_t npts=pts->getSize();
 	if (npts <= 1) return 0.0;
 
-	double len = 0.0;
-
-	const Coordinate& p = pts->getAt(0);
-	double x0 = p.x;
-	double y0 = p.y;
-
-	for(size_t i = 1; i < npts; ++i)
-	{
-		const Coordinate& p = pts->getAt(i);
-		double x1 = p.x;
-		double y1 = p.y;
-		double dx = x1 - x0;
-		double dy = y1 - y0;
-
-		len += sqrt(dx * dx + dy * dy);
-
-		x0 = x1;
-		y0 = y1;
-	}
-
-	return len;
+	LengthSum len;
+	pts->forEachXY(len);
+	return len.len;
 }
 
 
@@ -33,6 +33,77 @@ using namespace geos::geom;
 namespace geos {
 namespace algorithm { // geos.algorithm
 
+namespace {
+
+// Adds the triangles a ring makes with the base point to the area
+// sums, as Centroid::addTriangle() does, for forEachXY()
+struct RingTriangles {
+
+  RingTriangles(const Coordinate& base, bool isPositiveArea,
+                Coordinate& sum, double& area)
+    : bx(base.x), by(base.y), sign(isPositiveArea ? 1.0 : -1.0),
+      cg3(sum), areasum2(area), px(0), py(0), started(false)
+  {}
+
+  void operator()(double x, double y)
+  {
+    if ( started ) {
+      // centroid3() and area2() of (base, previous point, this point)
+      double cx = bx + px + x;
+      double cy = by + py + y;
+      double a2 = (px - bx) * (y - by) - (x - bx) * (py - by);
+      cg3.x += sign * a2 * cx;
+      cg3.y += sign * a2 * cy;
+      areasum2 += sign * a2;
+    }
+    px = x;
+    py = y;
+    started = true;
+  }
+
+  double bx, by, sign;
+  Coordinate& cg3;
+  double& areasum2;
+  double px, py;
+  bool started;
+};
+
+// Adds the midpoints of the segments of a line, weighted by their
+// length, to the line sums, for forEachXY()
+struct SegmentMidpoints {
+
+  SegmentMidpoints(Coordinate& sum)
+    : lineCentSum(sum), lineLen(0.0), px(0), py(0), started(false)
+  {}
+
+  void operator()(double x, double y)
+  {
+    if ( started ) {
+      double dx = px - x;
+      double dy = py - y;
+      double segmentLen = std::sqrt(dx * dx + dy * dy);
+      if (segmentLen != 0.0) {
+        lineLen += segmentLen;
+
+        double midx = (px + x) / 2;
+        lineCentSum.x += segmentLen * midx;
+        double midy = (py + y) / 2;
+        lineCentSum.y += segmentLen * midy;
+      }
+    }
+    px = x;
+    py = y;
+    started = true;
+  }
+
+  Coordinate& lineCentSum;
+  double lineLen;
+  double px, py;
+  bool started;
+};
+
+} // anonymous namespace
+
 /* static public */
 bool
 Centroid::getCentroid(const Geometry& geom, Coordinate& pt)
@@ -108,13 +179,14 @@ Centroid::add(const Polygon& poly)
 void
 Centroid::addShell(const CoordinateSequence& pts)
 {
-  size_t len = pts.size();
-  if (len > 0)
-    setBasePoint(pts[0]);
+  if (pts.isEmpty()) return;
+
+  Coordinate p0;
+  pts.getAt(0, p0);
+  setBasePoint(p0);
   bool isPositiveArea = ! CGAlgorithms::isCCW(&pts);
-  for (size_t i = 0; i < len - 1; ++i) {
-    addTriangle(*areaBasePt, pts[i], pts[i+1], isPositiveArea);
-  }
+  RingTriangles triangles(*areaBasePt, isPositiveArea, cg3, areasum2);
+  pts.forEachXY(triangles);
   addLineSegments(pts);
 }
 
@@ -122,10 +194,11 @@ Centroid::addShell(const CoordinateSequence& pts)
 void
 Centroid::addHole(const CoordinateSequence& pts)
 {
+  if (pts.isEmpty()) return;
+
   bool isPositiveArea = CGAlgorithms::isCCW(&pts);
-  for (size_t i = 0, e = pts.size() - 1; i < e; ++i) {
-    addTriangle(*areaBasePt, pts[i], pts[i+1], isPositiveArea);
-  }
+  RingTriangles triangles(*areaBasePt, isPositiveArea, cg3, areasum2);
+  pts.forEachXY(triangles);
   addLineSegments(pts);
 }
 
@@ -163,23 +236,15 @@ Centroid::area2(const Coordinate& p1, const Coordinate& p2, const Coordinate& p3
 void
 Centroid::addLineSegments(const CoordinateSequence& pts)
 {
-  size_t npts = pts.size();
-  double lineLen = 0.0;
-  for (size_t i = 0; i < npts - 1; i++) {
-    double segmentLen = pts[i].distance(pts[i + 1]);
-    if (segmentLen == 0.0)
-      continue;
-
-    lineLen += segmentLen;
-
-    double midx = (pts[i].x + pts[i + 1].x) / 2;
-    lineCentSum.x += segmentLen * midx;
-    double midy = (pts[i].y + pts[i + 1].y) / 2;
-    lineCentSum.y += segmentLen * midy;
-  }
+  SegmentMidpoints midpoints(lineCentSum);
+  pts.forEachXY(midpoints);
+  double lineLen = midpoints.lineLen;
   totalLength += lineLen;
-  if (lineLen == 0.0 && npts > 0)
-    addPoint(pts[0]);
+  if (lineLen == 0.0 && ! pts.isEmpty()) {
+    Coordinate p0;
+    pts.getAt(0, p0);
+    addPoint(p0);
+  }
 }
 
 /* private */
@@ -55,7 +55,9 @@ CentroidArea::add(const Geometry *geom)
 void
 CentroidArea::add(const CoordinateSequence *ring)
 {
-	setBasePoint(ring->getAt(0));
+	Coordinate c;
+	ring->getAt(0, c);
+	setBasePoint(c);
 	addShell(ring);
 }
 
@@ -102,9 +104,13 @@ CentroidArea::addShell(const CoordinateSequence *pts)
 {
 	bool isPositiveArea=!CGAlgorithms::isCCW(pts);
 	std::size_t const n=pts->getSize()-1;
+	Coordinate p0, p1;
+	if (n) pts->getAt(0, p1);
 	for(std::size_t i=0; i<n; ++i)
 	{
-		addTriangle(basePt, pts->getAt(i), pts->getAt(i+1), isPositiveArea);
+		p0=p1;
+		pts->getAt(i+1, p1);
+		addTriangle(basePt, p0, p1, isPositiveArea);
 	}
 	addLinearSegments(*pts);
 }
@@ -114,9 +120,13 @@ CentroidArea::addHole(const CoordinateSequence *pts)
 {
 	bool isPositiveArea=CGAlgorithms::isCCW(pts);
 	std::size_t const n=pts->getSize()-1;
+	Coordinate p0, p1;
+	if (n) pts->getAt(0, p1);
 	for(std::size_t i=0; i<n; ++i)
 	{
-		addTriangle(basePt, pts->getAt(i), pts->getAt(i+1), isPositiveArea);
+		p0=p1;
+		pts->getAt(i+1, p1);
+		addTriangle(basePt, p0, p1, isPositiveArea);
 	}
 	addLinearSegments(*pts);
 }
@@ -160,13 +170,17 @@ void
 CentroidArea::addLinearSegments(const geom::CoordinateSequence& pts)
 {
 	std::size_t const n = pts.size()-1;
+	Coordinate p0, p1;
+	if (n) pts.getAt(0, p1);
 	for (std::size_t i = 0; i < n; ++i) {
-		double segmentLen = pts[i].distance(pts[i + 1]);
+		p0 = p1;
+		pts.getAt(i + 1, p1);
+		double segmentLen = p0.distance(p1);
 		totalLength += segmentLen;
 
-		double midx = (pts[i].x + pts[i + 1].x) / 2;
+		double midx = (p0.x + p1.x) / 2;
 		centSum.x += segmentLen * midx;
-		double midy = (pts[i].y + pts[i + 1].y) / 2;
+		double midy = (p0.y + p1.y) / 2;
 		centSum.y += segmentLen * midy;
 	}
 }
@@ -115,7 +115,10 @@ PointLocator::locate(const Coordinate& p, const LineString *l)
 {
 	const CoordinateSequence* pt=l->getCoordinatesRO();
 	if (! l->isClosed()) {
-		if ((p==pt->getAt(0)) || (p==pt->getAt(pt->getSize()-1))) {
+		Coordinate first, last;
+		pt->getAt(0, first);
+		pt->getAt(pt->getSize()-1, last);
+		if ((p==first) || (p==last)) {
 			return Location::BOUNDARY;
 		}
 	}
@@ -43,6 +43,27 @@ RayCrossingCounter::locatePointInRing(const geom::Coordinate& point,
 {
 	RayCrossingCounter rcc(point);
 
+	// Read packed rings directly, without building Coordinates
+	std::size_t stride;
+	const double * xy = ring.getOrdinateArray(stride);
+	if ( xy )
+	{
+		geom::Coordinate p1, p2;
+		for (std::size_t i = 1, ni = ring.size(); i < ni; i++) 
+		{
+			p1.x = xy[ stride * ( i - 1 ) ];
+			p1.y = xy[ stride * ( i - 1 ) + 1 ];
+			p2.x = xy[ stride * i ];
+			p2.y = xy[ stride * i + 1 ];
+
+			rcc.countSegment(p1, p2);
+
+			if ( rcc.isOnSegment() )
+				return rcc.getLocation();
+		}
+		return rcc.getLocation();
+	}
+
 	for (std::size_t i = 1, ni = ring.size(); i < ni; i++) 
 	{
 		const geom::Coordinate & p1 = ring[ i - 1 ];
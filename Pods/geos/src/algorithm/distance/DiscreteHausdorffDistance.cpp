@@ -45,8 +45,9 @@ DiscreteHausdorffDistance::MaxDensifiedByFractionDistanceFilter::filter_ro(
     if (index == 0)
       return;
 
-    const geom::Coordinate& p0 = seq.getAt(index - 1);
-    const geom::Coordinate& p1 = seq.getAt(index);
+    geom::Coordinate p0, p1;
+    seq.getAt(index - 1, p0);
+    seq.getAt(index, p1);
 
     double delx = (p1.x - p0.x)/numSubSegs;
     double dely = (p1.y - p0.y)/numSubSegs;
@@ -79,10 +79,10 @@ DistanceToPoint::computeDistance(const geom::LineString& line,
 	Coordinate closestPt;
 
 	Coordinate* segPts[2] = { &(tempSegment.p0), &(tempSegment.p1) };
-	tempSegment.p0 = coords.getAt(0);
+	coords.getAt(0, tempSegment.p0);
 	for (size_t i=1; i<npts; ++i)
 	{
-		*(segPts[i%2]) = coords.getAt(i);
+		coords.getAt(i, *(segPts[i%2]));
 
 		// this is somewhat inefficient - could do better
 		tempSegment.closestPoint(pt, closestPt);
@@ -21,10 +21,9 @@
 #include <geos/geom/LineSegment.h>
 #include <geos/geom/CoordinateSequence.h>
 #include <geos/geom/util/LinearComponentExtracter.h>
-#include <geos/index/intervalrtree/SortedPackedIntervalRTree.h>
+#include <geos/index/intervalrtree/ArrayIntervalRTree.h>
 #include <geos/util/IllegalArgumentException.h>
 #include <geos/algorithm/RayCrossingCounter.h>
-#include <geos/index/ItemVisitor.h> 
 
 #include <algorithm>
 #include <typeinfo>
@@ -37,18 +36,11 @@ namespace locate {
 //
 IndexedPointInAreaLocator::IntervalIndexedGeometry::IntervalIndexedGeometry( const geom::Geometry & g)
 {
-	index = new index::intervalrtree::SortedPackedIntervalRTree();
 	init( g);
 }
 
 IndexedPointInAreaLocator::IntervalIndexedGeometry::~IntervalIndexedGeometry( )
 {
-	delete index;
-
-	for ( size_t i = 0, ni = allocatedSegments.size(); i < ni; ++i ) 
-	{
-		delete allocatedSegments[i];
-	}
 }
 
 void 
@@ -60,26 +52,27 @@ IndexedPointInAreaLocator::IntervalIndexedGeometry::init( const geom::Geometry &
 	for ( size_t i = 0, ni = lines.size(); i < ni; i++ )
 	{
 		const geom::LineString * line = lines[ i ];
-		geom::CoordinateSequence * pts = line->getCoordinates();
-
-		addLine( pts);
+		addLine( line->getCoordinatesRO());
+	}
 
-		delete pts;
+	// segments is complete, so pointers to its elements are stable
+	for ( size_t i = 0, ni = segments.size(); i < ni; i++ )
+	{
+		const geom::LineSegment & seg = segments[ i ];
+		double const min = (std::min)( seg.p0.y, seg.p1.y);
+		double const max = (std::max)( seg.p0.y, seg.p1.y);
+		index.insert( min, max, &segments[ i ]);
 	}
+	index.build();
 }
 
 void 
-IndexedPointInAreaLocator::IntervalIndexedGeometry::addLine( geom::CoordinateSequence * pts)
+IndexedPointInAreaLocator::IntervalIndexedGeometry::addLine( const geom::CoordinateSequence * pts)
 {
 	for ( size_t i = 1, ni = pts->size(); i < ni; i++ ) 
 	{
-		geom::LineSegment * seg = new geom::LineSegment( (*pts)[ i - 1 ], (*pts)[ i ]);
-		double const min = (std::min)( seg->p0.y, seg->p1.y);
-		double const max = (std::max)( seg->p0.y, seg->p1.y);
-		
-		// NOTE: seg ownership still ours
-		allocatedSegments.push_back(seg);
-		index->insert( min, max, seg);
+		segments.push_back( geom::LineSegment( pts->getX( i - 1), pts->getY( i - 1),
+				pts->getX( i), pts->getY( i)));
 	}
 } 
 
@@ -122,7 +115,7 @@ IndexedPointInAreaLocator::locate( const geom::Coordinate * /*const*/ p)
 
 	IndexedPointInAreaLocator::SegmentVisitor visitor( &rcc);
 
-	index->query( p->y, p->y, &visitor);
+	index->query( p->y, p->y, visitor);
 
 	return rcc.getLocation();
 }
@@ -135,12 +128,6 @@ IndexedPointInAreaLocator::SegmentVisitor::visitItem( void * item)
 	counter->countSegment( (*seg)[ 0 ], (*seg)[ 1 ]);
 }
 
-void 
-IndexedPointInAreaLocator::IntervalIndexedGeometry::query( double min, double max, index::ItemVisitor * visitor)
-{
-	index->query( min, max, visitor);
-}
-
 
 } // geos::algorithm::locate
 } // geos::algorithm
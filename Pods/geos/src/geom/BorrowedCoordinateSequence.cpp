@@ -0,0 +1,221 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geom/BorrowedCoordinateSequence.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateFilter.h>
+#include <geos/util/IllegalArgumentException.h>
+#include <geos/util/UnsupportedOperationException.h>
+
+#include <vector>
+#include <string>
+
+using namespace std;
+
+namespace geos {
+namespace geom { // geos::geom
+
+BorrowedCoordinateSequence::BorrowedCoordinateSequence(const double* b,
+		size_t n, size_t d, size_t s)
+	:
+	buf(b),
+	size(n),
+	dims(d),
+	stride(s ? s : d)
+{
+	if ( dims < 2 || dims > 3 )
+		throw util::IllegalArgumentException("BorrowedCoordinateSequence: dimension must be 2 or 3");
+	if ( stride < dims )
+		throw util::IllegalArgumentException("BorrowedCoordinateSequence: stride is less than dimension");
+}
+
+BorrowedCoordinateSequence::~BorrowedCoordinateSequence()
+{
+}
+
+CoordinateSequence *
+BorrowedCoordinateSequence::clone() const
+{
+	vector<Coordinate>* v = new vector<Coordinate>();
+	v->reserve(size);
+	toVector(*v);
+	return new CoordinateArraySequence(v, dims);
+}
+
+/*private static*/
+void
+BorrowedCoordinateSequence::throwReadOnly()
+{
+	throw util::UnsupportedOperationException("BorrowedCoordinateSequence is read-only");
+}
+
+const Coordinate &
+BorrowedCoordinateSequence::getAt(size_t pos) const
+{
+	return coords.get(*this)[pos];
+}
+
+void
+BorrowedCoordinateSequence::getAt(size_t pos, Coordinate &c) const
+{
+	const double* p = buf + stride * pos;
+	c.x = p[0];
+	c.y = p[1];
+	c.z = dims == 3 ? p[2] : DoubleNotANumber;
+}
+
+const vector<Coordinate>*
+BorrowedCoordinateSequence::toVector() const
+{
+	return &coords.get(*this);
+}
+
+void
+BorrowedCoordinateSequence::toVector(vector<Coordinate>& out) const
+{
+	Coordinate c;
+	for (size_t i = 0; i < size; ++i)
+	{
+		getAt(i, c);
+		out.push_back(c);
+	}
+}
+
+void
+BorrowedCoordinateSequence::add(const Coordinate&)
+{
+	throwReadOnly();
+}
+
+void
+BorrowedCoordinateSequence::add(const Coordinate&, bool)
+{
+	throwReadOnly();
+}
+
+void
+BorrowedCoordinateSequence::add(size_t, const Coordinate&, bool)
+{
+	throwReadOnly();
+}
+
+void
+BorrowedCoordinateSequence::setAt(const Coordinate&, size_t)
+{
+	throwReadOnly();
+}
+
+void
+BorrowedCoordinateSequence::deleteAt(size_t)
+{
+	throwReadOnly();
+}
+
+string
+BorrowedCoordinateSequence::toString() const
+{
+	string result("(");
+	Coordinate c;
+	for (size_t i = 0; i < size; i++)
+	{
+		if ( i ) result.append(", ");
+		getAt(i, c);
+		result.append(c.toString());
+	}
+	result.append(")");
+
+	return result;
+}
+
+void
+BorrowedCoordinateSequence::setPoints(const vector<Coordinate>&)
+{
+	throwReadOnly();
+}
+
+double
+BorrowedCoordinateSequence::getOrdinate(size_t index,
+		size_t ordinateIndex) const
+{
+	switch (ordinateIndex)
+	{
+		case CoordinateSequence::X:
+			return buf[stride * index];
+		case CoordinateSequence::Y:
+			return buf[stride * index + 1];
+		case CoordinateSequence::Z:
+			return dims == 3 ? buf[stride * index + 2] : DoubleNotANumber;
+		default:
+			return DoubleNotANumber;
+	}
+}
+
+void
+BorrowedCoordinateSequence::setOrdinate(size_t, size_t, double)
+{
+	throwReadOnly();
+}
+
+void
+BorrowedCoordinateSequence::expandEnvelope(Envelope &env) const
+{
+	if ( size == 0 ) return;
+
+	double minX = buf[0], maxX = buf[0];
+	double minY = buf[1], maxY = buf[1];
+	for (size_t i = 1; i < size; ++i)
+	{
+		const double* p = buf + stride * i;
+		if ( p[0] < minX ) minX = p[0];
+		if ( p[0] > maxX ) maxX = p[0];
+		if ( p[1] < minY ) minY = p[1];
+		if ( p[1] > maxY ) maxY = p[1];
+	}
+	env.expandToInclude(minX, minY);
+	env.expandToInclude(maxX, maxY);
+}
+
+void
+BorrowedCoordinateSequence::apply_rw(const CoordinateFilter *)
+{
+	throwReadOnly();
+}
+
+void
+BorrowedCoordinateSequence::apply_ro(CoordinateFilter *filter) const
+{
+	// Filters may keep the pointers they are given
+	const vector<Coordinate>& v = coords.get(*this);
+	for (vector<Coordinate>::const_iterator i = v.begin(), e = v.end();
+			i != e; ++i)
+	{
+		filter->filter_ro(&(*i));
+	}
+}
+
+CoordinateSequence&
+BorrowedCoordinateSequence::removeRepeatedPoints()
+{
+	// Nothing to do unless there are repeated points, compared in 2D
+	// as in CoordinateArraySequence
+	for (size_t i = 1; i < size; ++i)
+	{
+		if ( getX(i) == getX(i - 1) && getY(i) == getY(i - 1) )
+			throwReadOnly();
+	}
+	return *this;
+}
+
+} // namespace geos::geom
+} // namespace geos
@@ -25,27 +25,66 @@
 #include <vector>
 #include <cmath>
 
+#ifdef _MSC_VER
+# include <intrin.h>
+#endif
+
 using namespace std;
 
 namespace geos {
 namespace geom { // geos::geom
 
+namespace {
+
+// Reference counts are changed atomically, as copies of one sequence
+// may be made, and dropped, from several threads
+
+#ifdef _MSC_VER
+long atomicIncrement(long *p) { return _InterlockedIncrement(p); }
+long atomicDecrement(long *p) { return _InterlockedDecrement(p); }
+long atomicLoad(long *p) { return _InterlockedCompareExchange(p, 0, 0); }
+long *
+compareAndSwap(long **p, long *expected, long *value)
+{
+	return static_cast<long*>(_InterlockedCompareExchangePointer(
+		reinterpret_cast<void* volatile*>(p), value, expected));
+}
+#else
+long atomicIncrement(long *p) { return __sync_add_and_fetch(p, 1); }
+long atomicDecrement(long *p) { return __sync_sub_and_fetch(p, 1); }
+long atomicLoad(long *p) { return __sync_fetch_and_add(p, 0); }
+long *
+compareAndSwap(long **p, long *expected, long *value)
+{
+	return __sync_val_compare_and_swap(p, expected, value);
+}
+#endif
+
+} // anonymous namespace
+
 CoordinateArraySequence::CoordinateArraySequence():
 	vect(new vector<Coordinate>()),
-        dimension(3)
+        dimension(3),
+	inArena(false),
+	refs(0)
 {
 }
 
 CoordinateArraySequence::CoordinateArraySequence(size_t n, 
                                                  size_t dimension_in ):
 	vect(new vector<Coordinate>(n)),
-        dimension(dimension_in)
+        dimension(static_cast<unsigned int>(dimension_in)),
+	inArena(false),
+	refs(0)
 {
 }
 
 CoordinateArraySequence::CoordinateArraySequence(
     vector<Coordinate> *coords, size_t dimension_in )
-        : vect(coords), dimension(dimension_in)
+        : vect(coords),
+          dimension(static_cast<unsigned int>(dimension_in)),
+          inArena(false),
+          refs(0)
 {
 	if ( ! vect ) vect = new vector<Coordinate>();
 }
@@ -54,8 +93,10 @@ CoordinateArraySequence::CoordinateArraySequence(
     const CoordinateArraySequence &c )
 	:
 	CoordinateSequence(c),
-	vect(new vector<Coordinate>(*(c.vect))),
-        dimension(c.getDimension())
+	vect(c.vect),
+        dimension(static_cast<unsigned int>(c.getDimension())),
+	inArena(false),
+	refs(c.share())
 {
 }
 
@@ -64,7 +105,9 @@ CoordinateArraySequence::CoordinateArraySequence(
 	:
 	CoordinateSequence(c),
 	vect(new vector<Coordinate>(c.size())),
-  dimension(c.getDimension())
+  dimension(static_cast<unsigned int>(c.getDimension())),
+	inArena(false),
+	refs(0)
 {
   for (size_t i = 0, n = vect->size(); i < n; ++i) {
       (*vect)[i] = c.getAt(i);
@@ -77,9 +120,51 @@ CoordinateArraySequence::clone() const
 	return new CoordinateArraySequence(*this);
 }
 
+/*private*/
+long *
+CoordinateArraySequence::share() const
+{
+	long *r = refs;
+	if ( ! r )
+	{
+		// First copy: count this sequence and the copy. Another
+		// thread copying this sequence may get there first.
+		long *fresh = new long(1);
+		r = compareAndSwap(&refs, 0, fresh);
+		if ( r ) delete fresh;
+		else r = fresh;
+	}
+	atomicIncrement(r);
+	return r;
+}
+
+/*private*/
+void
+CoordinateArraySequence::detach()
+{
+	if ( ! refs || atomicLoad(refs) == 1 ) return;
+
+	vector<Coordinate> *own = new vector<Coordinate>(*vect);
+	unshare();
+	vect = own;
+	refs = 0;
+}
+
+/*private*/
+void
+CoordinateArraySequence::unshare()
+{
+	if ( ! refs || atomicDecrement(refs) == 0 )
+	{
+		delete vect;
+		delete refs;
+	}
+}
+
 void
 CoordinateArraySequence::setPoints(const vector<Coordinate> &v)
 {
+	detach();
 	vect->assign(v.begin(), v.end());
 }
 
@@ -116,6 +201,7 @@ CoordinateArraySequence::toVector(vector<Coordinate>& out) const
 void
 CoordinateArraySequence::add(const Coordinate& c)
 {
+	detach();
 	vect->push_back(c);
 }
 
@@ -127,6 +213,7 @@ CoordinateArraySequence::add(const Coordinate& c, bool allowRepeated)
 		const Coordinate& last=vect->back();
 		if (last.equals2D(c)) return;
 	}
+	detach();
 	vect->push_back(c);
 }
 
@@ -150,6 +237,7 @@ CoordinateArraySequence::add(size_t i, const Coordinate& coord,
       }
     }
 
+    detach();
     vect->insert(vect->begin()+i, coord);
 }
 
@@ -174,12 +262,14 @@ CoordinateArraySequence::getAt(size_t pos, Coordinate &c) const
 void
 CoordinateArraySequence::setAt(const Coordinate& c, size_t pos)
 {
+	detach();
 	(*vect)[pos]=c;
 }
 
 void
 CoordinateArraySequence::deleteAt(size_t pos)
 {
+	detach();
 	vect->erase(vect->begin()+pos);
 }
 
@@ -203,7 +293,8 @@ CoordinateArraySequence::toString() const
 
 CoordinateArraySequence::~CoordinateArraySequence()
 {
-	delete vect;
+	unshare();
+	if ( inArena ) geos::util::Arena::deleting(this);
 }
 
 void
@@ -233,6 +324,7 @@ void
 CoordinateArraySequence::setOrdinate(size_t index, size_t ordinateIndex,
 	double value)
 {
+	detach();
 	switch (ordinateIndex)
 	{
 		case CoordinateSequence::X:
@@ -257,6 +349,7 @@ CoordinateArraySequence::setOrdinate(size_t index, size_t ordinateIndex,
 void
 CoordinateArraySequence::apply_rw(const CoordinateFilter *filter)
 {
+	detach();
 	for (vector<Coordinate>::iterator i=vect->begin(), e=vect->end(); i!=e; ++i)
 	{
 		filter->filter_rw(&(*i));
@@ -276,6 +369,8 @@ CoordinateArraySequence::apply_ro(CoordinateFilter *filter) const
 CoordinateSequence&
 CoordinateArraySequence::removeRepeatedPoints()
 {
+	detach();
+
 	// We use == operator, which is 2D only
 	vector<Coordinate>::iterator new_end = \
 		std::unique(vect->begin(), vect->end());
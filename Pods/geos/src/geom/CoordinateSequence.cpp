@@ -31,6 +31,23 @@ using namespace std;
 namespace geos {
 namespace geom { // geos::geom
 
+namespace {
+
+// Expands an Envelope to include points, for forEachXY()
+struct EnvelopeExpander {
+
+	EnvelopeExpander(Envelope& e) : env(e) {}
+
+	void operator()(double x, double y)
+	{
+		env.expandToInclude(x, y);
+	}
+
+	Envelope& env;
+};
+
+} // anonymous namespace
+
 #if PROFILE
 static Profiler *profiler = Profiler::instance();
 #endif
@@ -38,13 +55,7 @@ static Profiler *profiler = Profiler::instance();
 bool
 CoordinateSequence::hasRepeatedPoints() const
 {
-    const std::size_t size=getSize();
-	for(std::size_t i=1; i<size; i++) {
-		if (getAt(i-1)==getAt(i)) {
-			return true;
-		}
-	}
-	return false;
+	return hasRepeatedPoints(this);
 }
 
 /*
@@ -72,7 +83,7 @@ CoordinateSequence::hasRepeatedPoints(const CoordinateSequence *cl)
 {
 	const std::size_t size=cl->getSize();
 	for(std::size_t i=1;i<size; i++) {
-		if (cl->getAt(i-1)==cl->getAt(i)) {
+		if (cl->getX(i-1)==cl->getX(i) && cl->getY(i-1)==cl->getY(i)) {
 			return true;
 		}
 	}
@@ -112,7 +123,7 @@ CoordinateSequence::indexOf(const Coordinate *coordinate,
 	size_t size=cl->getSize();
 	for (size_t i=0; i<size; ++i)
 	{
-		if ((*coordinate)==cl->getAt(i))
+		if (coordinate->x==cl->getX(i) && coordinate->y==cl->getY(i))
 		{
 			return static_cast<int>(i); // FIXME: what if we overflow the int ?
 		}
@@ -133,10 +144,10 @@ CoordinateSequence::scroll(CoordinateSequence* cl,
 	const std::size_t length=cl->getSize();
 	vector<Coordinate> v(length);
 	for (i=ind; i<length; i++) {
-		v[j++]=cl->getAt(i);
+		cl->getAt(i, v[j++]);
 	}
 	for (i=0; i<ind; i++) {
-		v[j++]=cl->getAt(i);
+		cl->getAt(i, v[j++]);
 	}
 	cl->setPoints(v);
 }
@@ -164,8 +175,10 @@ CoordinateSequence::reverse(CoordinateSequence *cl)
 	int last = static_cast<int>(cl->getSize()) - 1;
 	int mid=last/2;
 	for(int i=0;i<=mid;i++) {
-		const Coordinate tmp=cl->getAt(i);
-		cl->setAt(cl->getAt(last-i),i);
+		Coordinate tmp, other;
+		cl->getAt(i, tmp);
+		cl->getAt(last-i, other);
+		cl->setAt(other,i);
 		cl->setAt(tmp,last-i);
 	}
 }
@@ -181,7 +194,8 @@ CoordinateSequence::equals(const CoordinateSequence *cl1,
 	size_t npts1=cl1->getSize();
 	if (npts1!=cl2->getSize()) return false;
 	for (size_t i=0; i<npts1; i++) {
-		if (!(cl1->getAt(i)==cl2->getAt(i))) return false;
+		if (cl1->getX(i)!=cl2->getX(i) || cl1->getY(i)!=cl2->getY(i))
+			return false;
 	}
 	return true;
 }
@@ -204,8 +218,7 @@ CoordinateSequence::add(const Coordinate& c, bool allowRepeated)
 	if (!allowRepeated) {
         std::size_t npts=getSize();
 		if (npts>=1) {
-			const Coordinate& last=getAt(npts-1);
-			if (last.equals2D(c))
+			if (getX(npts-1)==c.x && getY(npts-1)==c.y)
                 return;
 		}
 	}
@@ -228,13 +241,16 @@ CoordinateSequence::add(const CoordinateSequence *cl,
 	// FIXME:  don't rely on negative values for 'j' (the reverse case)
 
 	const int npts = static_cast<int>(cl->getSize());
+	Coordinate c;
 	if (direction) {
 		for (int i=0; i<npts; i++) {
-			add(cl->getAt(i), allowRepeated);
+			cl->getAt(i, c);
+			add(c, allowRepeated);
 		}
 	} else {
 		for (int j=npts-1; j>=0; j--) {
-			add(cl->getAt(j), allowRepeated);
+			cl->getAt(j, c);
+			add(c, allowRepeated);
 		}
 	}
 }
@@ -248,11 +264,10 @@ CoordinateSequence::removeRepeatedPoints(const CoordinateSequence *cl)
 	static Profile *prof= profiler->get("CoordinateSequence::removeRepeatedPoints()");
 	prof->start();
 #endif
-	const vector<Coordinate> *v=cl->toVector();
-
 	vector<Coordinate> *nv=new vector<Coordinate>;
-	nv->reserve(v->size());
-	unique_copy(v->begin(), v->end(), back_inserter(*nv));
+	nv->reserve(cl->getSize());
+	cl->toVector(*nv);
+	nv->erase(unique(nv->begin(), nv->end()), nv->end());
 	CoordinateSequence* ret=CoordinateArraySequenceFactory::instance()->create(nv);
 
 #if PROFILE
@@ -264,9 +279,9 @@ CoordinateSequence::removeRepeatedPoints(const CoordinateSequence *cl)
 void
 CoordinateSequence::expandEnvelope(Envelope &env) const
 {
-	const std::size_t size = getSize();
-	for (std::size_t i=0; i<size; i++)
-        env.expandToInclude(getAt(i));
+	// One virtual call for the sequence rather than one per point
+	EnvelopeExpander expander(env);
+	forEachXY(expander);
 }
 
 std::ostream& operator<< (std::ostream& os, const CoordinateSequence& cs)
@@ -17,6 +17,11 @@
  **********************************************************************/
 
 #include <geos/geom/CoordinateSequenceFactory.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Coordinate.h>
+
+#include <vector>
+#include <memory>
 
 namespace geos {
 namespace geom { // geos::geom
@@ -24,5 +29,15 @@ namespace geom { // geos::geom
 CoordinateSequenceFactory::~CoordinateSequenceFactory()
 {}
 
+std::auto_ptr<CoordinateSequence>
+CoordinateSequenceFactory::create(
+		std::auto_ptr< std::vector<Coordinate> > coordinates,
+		std::size_t dimension) const
+{
+	// Implementations delete the vector if they do not keep it
+	return std::auto_ptr<CoordinateSequence>(
+		create(coordinates.release(), dimension));
+}
+
 } // namespace geos::geom
 }
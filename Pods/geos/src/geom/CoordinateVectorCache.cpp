@@ -0,0 +1,98 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geom/CoordinateVectorCache.h>
+#include <geos/geom/CoordinateSequence.h>
+
+#include <memory>
+#include <vector>
+
+#ifdef _MSC_VER
+# include <intrin.h>
+#endif
+
+using namespace std;
+
+namespace geos {
+namespace geom { // geos::geom
+
+namespace {
+
+typedef vector<Coordinate> Vect;
+
+// The copy is published with a compare and swap, and read with an
+// acquire load, so a thread seeing the pointer sees the Coordinates
+
+#ifdef _MSC_VER
+Vect *
+loadAcquire(Vect **p)
+{
+	// volatile reads have acquire semantics with MSVC
+	Vect *v = *static_cast<Vect* volatile*>(p);
+	_ReadWriteBarrier();
+	return v;
+}
+Vect *
+compareAndSwap(Vect **p, Vect *expected, Vect *value)
+{
+	return static_cast<Vect*>(_InterlockedCompareExchangePointer(
+		reinterpret_cast<void* volatile*>(p), value, expected));
+}
+#else
+Vect *
+loadAcquire(Vect **p)
+{
+# ifdef __ATOMIC_ACQUIRE
+	return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+# else
+	Vect *v = *static_cast<Vect* volatile*>(p);
+	__sync_synchronize();
+	return v;
+# endif
+}
+Vect *
+compareAndSwap(Vect **p, Vect *expected, Vect *value)
+{
+	return __sync_val_compare_and_swap(p, expected, value);
+}
+#endif
+
+} // anonymous namespace
+
+CoordinateVectorCache::~CoordinateVectorCache()
+{
+	delete vect;
+}
+
+const vector<Coordinate>&
+CoordinateVectorCache::get(const CoordinateSequence& seq) const
+{
+	if ( Vect *v = loadAcquire(&vect) ) return *v;
+
+	auto_ptr<Vect> built(new Vect());
+	built->reserve(seq.getSize());
+	seq.toVector(*built);
+
+	// Another thread may have published its copy meanwhile
+	if ( Vect *v = compareAndSwap(&vect, 0, built.get()) ) return *v;
+	return *built.release();
+}
+
+void
+CoordinateVectorCache::clear()
+{
+	delete vect;
+	vect = 0;
+}
+
+} // namespace geos::geom
+} // namespace geos
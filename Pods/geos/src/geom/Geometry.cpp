@@ -106,9 +106,12 @@ jtsport()
 
 Geometry::GeometryChangedFilter Geometry::geometryChangedFilter;
 
+Geometry::EnvelopeFilter Geometry::envelopeFilter;
+
 Geometry::Geometry(const GeometryFactory *newFactory)
 	:
-	envelope(NULL),
+	envelopeComputed(false),
+	inArena(false),
 	factory(newFactory),
 	userData(NULL)
 {
@@ -120,14 +123,13 @@ Geometry::Geometry(const GeometryFactory *newFactory)
 
 Geometry::Geometry(const Geometry &geom)
 	:
+	envelope(geom.envelope),
+	envelopeComputed(geom.envelopeComputed),
+	inArena(false),
 	SRID(geom.getSRID()),
-	factory(geom.factory),
+	factory(geom.factory->getCloneFactory()),
 	userData(NULL)
 {
-	if ( geom.envelope.get() )
-	{
-		envelope.reset(new Envelope(*(geom.envelope)));
-	}
 	//factory=geom.factory; 
 	//envelope(new Envelope(*(geom.envelope.get())));
 	//SRID=geom.getSRID();
@@ -242,6 +244,7 @@ void
 Geometry::geometryChanged()
 {
 	apply_rw(&geometryChangedFilter);
+	if ( factory->hasEagerEnvelopes() ) computeEnvelopes();
 }
 
 /**
@@ -253,8 +256,7 @@ Geometry::geometryChanged()
 void
 Geometry::geometryChangedAction()
 {
-	//delete envelope;
-	envelope.reset(NULL);
+	envelopeComputed = false;
 }
 
 bool
@@ -272,10 +274,17 @@ Geometry::getEnvelope() const
 const Envelope *
 Geometry::getEnvelopeInternal() const
 {
-	if (!envelope.get()) {
+	if (!envelopeComputed) {
 		envelope = computeEnvelopeInternal();
+		envelopeComputed = true;
 	}
-	return envelope.get();
+	return &envelope;
+}
+
+void
+Geometry::computeEnvelopes() const
+{
+	apply_ro(&envelopeFilter);
 }
 
 bool
@@ -717,6 +726,11 @@ void Geometry::GeometryChangedFilter::filter_rw(Geometry* geom)
    geom->geometryChangedAction();
 }
 
+void Geometry::EnvelopeFilter::filter_ro(const Geometry* geom)
+{
+   geom->getEnvelopeInternal();
+}
+
 int
 Geometry::compare(vector<Coordinate> a, vector<Coordinate> b) const
 {
@@ -809,6 +823,7 @@ Geometry::getLength() const
 Geometry::~Geometry()
 {
 	//delete envelope;
+	if ( inArena ) geos::util::Arena::deleting(this);
 }
 
 bool
@@ -871,6 +886,14 @@ Geometry::getPrecisionModel() const
 	return factory->getPrecisionModel();
 }
 
+/* public */
+geos::util::Arena*
+Geometry::getArena() const
+{
+	// The factory keeps its Arena until the Geometries in it are gone
+	return inArena ? factory->getArena() : NULL;
+}
+
 } // namespace geos::geom
 } // namespace geos
 
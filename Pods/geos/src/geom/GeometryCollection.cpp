@@ -249,13 +249,13 @@ GeometryCollection::normalize()
 	sort(geometries->begin(), geometries->end(), GeometryGreaterThen());
 }
 
-Envelope::AutoPtr
+Envelope
 GeometryCollection::computeEnvelopeInternal() const
 {
-	Envelope::AutoPtr envelope(new Envelope());
+	Envelope envelope;
 	for (size_t i=0; i<geometries->size(); i++) {
 		const Envelope *env=(*geometries)[i]->getEnvelopeInternal();
-		envelope->expandToInclude(env);
+		envelope.expandToInclude(env);
 	}
 	return envelope;
 }
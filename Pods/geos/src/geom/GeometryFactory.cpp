@@ -58,7 +58,17 @@ using namespace std;
 namespace geos {
 namespace geom { // geos::geom
 
-namespace { 
+namespace {
+
+// Deletes the Geometries given to the overloads taking ownership
+// of them, when the result could not be built
+void
+deleteGeometries(vector<Geometry *>* geoms)
+{
+	if ( ! geoms ) return;
+	for (size_t i=0, n=geoms->size(); i<n; ++i)
+		delete (*geoms)[i];
+}
 
 class gfCoordinateOperation: public util::CoordinateOperation {
 using CoordinateOperation::edit;
@@ -83,7 +93,11 @@ GeometryFactory::GeometryFactory()
 	:
 	precisionModel(new PrecisionModel()),
 	SRID(0),
-	coordinateListFactory(CoordinateArraySequenceFactory::instance())
+	coordinateListFactory(CoordinateArraySequenceFactory::instance()),
+	arena(0),
+	cloneFactory(0),
+	arenaSeqFactory(0),
+	eagerEnvelopes(false)
 {
 #if GEOS_DEBUG
 	std::cerr << "GEOS_DEBUG: GeometryFactory["<<this<<"]::GeometryFactory()" << std::endl;
@@ -95,7 +109,11 @@ GeometryFactory::GeometryFactory()
 GeometryFactory::GeometryFactory(const PrecisionModel* pm, int newSRID,
 		CoordinateSequenceFactory* nCoordinateSequenceFactory)
 	:
-	SRID(newSRID)
+	SRID(newSRID),
+	arena(0),
+	cloneFactory(0),
+	arenaSeqFactory(0),
+	eagerEnvelopes(false)
 {
 #if GEOS_DEBUG
 	std::cerr << "GEOS_DEBUG: GeometryFactory["<<this<<"]::GeometryFactory(PrecisionModel["<<pm<<"], SRID)" << std::endl;
@@ -118,7 +136,11 @@ GeometryFactory::GeometryFactory(
 		CoordinateSequenceFactory* nCoordinateSequenceFactory)
 	:
 	precisionModel(new PrecisionModel()),
-	SRID(0)
+	SRID(0),
+	arena(0),
+	cloneFactory(0),
+	arenaSeqFactory(0),
+	eagerEnvelopes(false)
 {
 #if GEOS_DEBUG
 	std::cerr << "GEOS_DEBUG: GeometryFactory["<<this<<"]::GeometryFactory(CoordinateSequenceFactory["<<nCoordinateSequenceFactory<<"])" << std::endl;
@@ -134,7 +156,11 @@ GeometryFactory::GeometryFactory(
 GeometryFactory::GeometryFactory(const PrecisionModel *pm)
 	:
 	SRID(0),
-	coordinateListFactory(CoordinateArraySequenceFactory::instance())
+	coordinateListFactory(CoordinateArraySequenceFactory::instance()),
+	arena(0),
+	cloneFactory(0),
+	arenaSeqFactory(0),
+	eagerEnvelopes(false)
 {
 #if GEOS_DEBUG
 	std::cerr << "GEOS_DEBUG: GeometryFactory["<<this<<"]::GeometryFactory(PrecisionModel["<<pm<<"])" << std::endl;
@@ -150,7 +176,11 @@ GeometryFactory::GeometryFactory(const PrecisionModel *pm)
 GeometryFactory::GeometryFactory(const PrecisionModel* pm, int newSRID)
 	:
 	SRID(newSRID),
-	coordinateListFactory(CoordinateArraySequenceFactory::instance())
+	coordinateListFactory(CoordinateArraySequenceFactory::instance()),
+	arena(0),
+	cloneFactory(0),
+	arenaSeqFactory(0),
+	eagerEnvelopes(false)
 {
 #if GEOS_DEBUG
 	std::cerr << "GEOS_DEBUG: GeometryFactory["<<this<<"]::GeometryFactory(PrecisionModel["<<pm<<"], SRID)" << std::endl;
@@ -162,13 +192,43 @@ GeometryFactory::GeometryFactory(const PrecisionModel* pm, int newSRID)
 	}
 }
 
+/*public*/
+GeometryFactory::GeometryFactory(const GeometryFactory* base,
+		geos::util::Arena* nArena)
+	:
+	precisionModel(new PrecisionModel(*(base->precisionModel))),
+	SRID(base->SRID),
+	arena(nArena),
+	cloneFactory(base->getCloneFactory()),
+	arenaSeqFactory(0),
+	eagerEnvelopes(base->eagerEnvelopes)
+{
+	// Other sequence factories keep their sequences on the heap
+	if ( base->coordinateListFactory ==
+			CoordinateArraySequenceFactory::instance() ) {
+		arenaSeqFactory=new CoordinateArraySequenceFactory(arena);
+		coordinateListFactory=arenaSeqFactory;
+	} else {
+		coordinateListFactory=base->coordinateListFactory;
+	}
+}
+
 /*public*/
 GeometryFactory::GeometryFactory(const GeometryFactory &gf)
 {
 	assert(gf.precisionModel);
 	precisionModel=new PrecisionModel(*(gf.precisionModel));
 	SRID=gf.SRID;
-	coordinateListFactory=gf.coordinateListFactory;
+	arena=gf.arena;
+	cloneFactory=gf.cloneFactory;
+	if ( gf.arenaSeqFactory ) {
+		arenaSeqFactory=new CoordinateArraySequenceFactory(arena);
+		coordinateListFactory=arenaSeqFactory;
+	} else {
+		arenaSeqFactory=0;
+		coordinateListFactory=gf.coordinateListFactory;
+	}
+	eagerEnvelopes=gf.eagerEnvelopes;
 }
 
 /*public*/
@@ -177,6 +237,16 @@ GeometryFactory::~GeometryFactory(){
 	std::cerr << "GEOS_DEBUG: GeometryFactory["<<this<<"]::~GeometryFactory()" << std::endl;
 #endif
 	delete precisionModel;
+	delete arenaSeqFactory;
+}
+
+/*public*/
+void
+GeometryFactory::setArena(geos::util::Arena* newArena)
+{
+	assert(cloneFactory);
+	arena=newArena;
+	if ( arenaSeqFactory ) arenaSeqFactory->setArena(newArena);
 }
   
 /*public*/
@@ -238,7 +308,7 @@ GeometryFactory::getPrecisionModel() const
 Point*
 GeometryFactory::createPoint() const
 {
-	return new Point(NULL, this);
+	return adopt(new (arena) Point(NULL, this));
 }
 
 /*public*/
@@ -248,11 +318,7 @@ GeometryFactory::createPoint(const Coordinate& coordinate) const
 	if (coordinate.isNull()) {
 		return createPoint();
 	} else {
-		std::size_t dim = ISNAN(coordinate.z) ? 2 : 3;
-		CoordinateSequence *cl = coordinateListFactory->create(new vector<Coordinate>(1, coordinate), dim);
-		//cl->setAt(coordinate, 0);
-		Point *ret = createPoint(cl);
-		return ret;
+		return adopt(new (arena) Point(coordinate, this));
 	}
 }
 
@@ -260,30 +326,30 @@ GeometryFactory::createPoint(const Coordinate& coordinate) const
 Point*
 GeometryFactory::createPoint(CoordinateSequence *newCoords) const
 {
-	return new Point(newCoords,this);
+	return adopt(new (arena) Point(newCoords,this));
+}
+
+/*public*/
+Geometry::AutoPtr
+GeometryFactory::createPoint(CoordinateSequence::AutoPtr newCoords) const
+{
+	// The Point deletes the sequence, even if it throws
+	return Geometry::AutoPtr(adopt(new (arena) Point(newCoords.release(), this)));
 }
 
 /*public*/
 Point*
 GeometryFactory::createPoint(const CoordinateSequence &fromCoords) const
 {
-	CoordinateSequence *newCoords = fromCoords.clone();
-	Point *g = NULL;
-	try {
-		g = new Point(newCoords,this); 
-	} catch (...) {
-		delete newCoords;
-		throw;
-	}
-	return g;
-
+	// The Point deletes the clone, even if it throws
+	return adopt(new (arena) Point(fromCoords.clone(), this));
 }
 
 /*public*/
 MultiLineString*
 GeometryFactory::createMultiLineString() const
 {
-	return new MultiLineString(NULL,this);
+	return adopt(new (arena) MultiLineString(NULL,this));
 }
 
 /*public*/
@@ -291,7 +357,21 @@ MultiLineString*
 GeometryFactory::createMultiLineString(vector<Geometry *> *newLines)
 	const
 {
-	return new MultiLineString(newLines,this);
+	return adopt(new (arena) MultiLineString(newLines,this));
+}
+
+/*public*/
+Geometry::AutoPtr
+GeometryFactory::createMultiLineString(std::auto_ptr< vector<Geometry *> > newLines) const
+{
+	try {
+		Geometry::AutoPtr g(createMultiLineString(newLines.get()));
+		newLines.release();
+		return g;
+	} catch (...) {
+		deleteGeometries(newLines.get());
+		throw;
+	}
 }
 
 /*public*/
@@ -308,7 +388,7 @@ GeometryFactory::createMultiLineString(const vector<Geometry *> &fromLines)
 	}
 	MultiLineString *g = NULL;
 	try {
-		g = new MultiLineString(newGeoms,this);
+		g = adopt(new (arena) MultiLineString(newGeoms,this));
 	} catch (...) {
 		for (size_t i=0; i<newGeoms->size(); i++) {
 			delete (*newGeoms)[i];
@@ -323,21 +403,35 @@ GeometryFactory::createMultiLineString(const vector<Geometry *> &fromLines)
 GeometryCollection*
 GeometryFactory::createGeometryCollection() const
 {
-	return new GeometryCollection(NULL,this);
+	return adopt(new (arena) GeometryCollection(NULL,this));
 }
 
 /*public*/
 Geometry*
 GeometryFactory::createEmptyGeometry() const
 {
-	return new GeometryCollection(NULL,this);
+	return adopt(new (arena) GeometryCollection(NULL,this));
 }
 
 /*public*/
 GeometryCollection*
 GeometryFactory::createGeometryCollection(vector<Geometry *> *newGeoms) const
 {
-	return new GeometryCollection(newGeoms,this);
+	return adopt(new (arena) GeometryCollection(newGeoms,this));
+}
+
+/*public*/
+Geometry::AutoPtr
+GeometryFactory::createGeometryCollection(std::auto_ptr< vector<Geometry *> > newGeoms) const
+{
+	try {
+		Geometry::AutoPtr g(createGeometryCollection(newGeoms.get()));
+		newGeoms.release();
+		return g;
+	} catch (...) {
+		deleteGeometries(newGeoms.get());
+		throw;
+	}
 }
 
 /*public*/
@@ -350,7 +444,7 @@ GeometryFactory::createGeometryCollection(const vector<Geometry *> &fromGeoms) c
 	}
 	GeometryCollection *g = NULL;
 	try {
-		g = new GeometryCollection(newGeoms,this);
+		g = adopt(new (arena) GeometryCollection(newGeoms,this));
 	} catch (...) {
 		for (size_t i=0; i<newGeoms->size(); i++) {
 			delete (*newGeoms)[i];
@@ -365,14 +459,28 @@ GeometryFactory::createGeometryCollection(const vector<Geometry *> &fromGeoms) c
 MultiPolygon*
 GeometryFactory::createMultiPolygon() const
 {
-	return new MultiPolygon(NULL,this);
+	return adopt(new (arena) MultiPolygon(NULL,this));
 }
 
 /*public*/
 MultiPolygon*
 GeometryFactory::createMultiPolygon(vector<Geometry *> *newPolys) const
 {
-	return new MultiPolygon(newPolys,this);
+	return adopt(new (arena) MultiPolygon(newPolys,this));
+}
+
+/*public*/
+Geometry::AutoPtr
+GeometryFactory::createMultiPolygon(std::auto_ptr< vector<Geometry *> > newPolys) const
+{
+	try {
+		Geometry::AutoPtr g(createMultiPolygon(newPolys.get()));
+		newPolys.release();
+		return g;
+	} catch (...) {
+		deleteGeometries(newPolys.get());
+		throw;
+	}
 }
 
 /*public*/
@@ -386,7 +494,7 @@ GeometryFactory::createMultiPolygon(const vector<Geometry *> &fromPolys) const
 	}
 	MultiPolygon *g = NULL;
 	try {
-		g = new MultiPolygon(newGeoms,this);
+		g = adopt(new (arena) MultiPolygon(newGeoms,this));
 	} catch (...) {
 		for (size_t i=0; i<newGeoms->size(); i++) {
 			delete (*newGeoms)[i];
@@ -401,21 +509,21 @@ GeometryFactory::createMultiPolygon(const vector<Geometry *> &fromPolys) const
 LinearRing*
 GeometryFactory::createLinearRing() const
 {
-	return new LinearRing(NULL,this);
+	return adopt(new (arena) LinearRing(NULL,this));
 }
 
 /*public*/
 LinearRing*
 GeometryFactory::createLinearRing(CoordinateSequence* newCoords) const
 {
-	return new LinearRing(newCoords,this);
+	return adopt(new (arena) LinearRing(newCoords,this));
 }
 
 /*public*/
 Geometry::AutoPtr
 GeometryFactory::createLinearRing(CoordinateSequence::AutoPtr newCoords) const
 {
-	return Geometry::AutoPtr(new LinearRing(newCoords, this));
+	return Geometry::AutoPtr(adopt(new (arena) LinearRing(newCoords, this)));
 }
 
 /*public*/
@@ -425,7 +533,7 @@ GeometryFactory::createLinearRing(const CoordinateSequence& fromCoords) const
 	CoordinateSequence *newCoords = fromCoords.clone();
 	LinearRing *g = NULL;
 	// construction failure will delete newCoords
-	g = new LinearRing(newCoords, this);
+	g = adopt(new (arena) LinearRing(newCoords, this));
 	return g;
 }
 
@@ -433,7 +541,21 @@ GeometryFactory::createLinearRing(const CoordinateSequence& fromCoords) const
 MultiPoint*
 GeometryFactory::createMultiPoint(vector<Geometry *> *newPoints) const
 {
-	return new MultiPoint(newPoints,this);
+	return adopt(new (arena) MultiPoint(newPoints,this));
+}
+
+/*public*/
+Geometry::AutoPtr
+GeometryFactory::createMultiPoint(std::auto_ptr< vector<Geometry *> > newPoints) const
+{
+	try {
+		Geometry::AutoPtr g(createMultiPoint(newPoints.get()));
+		newPoints.release();
+		return g;
+	} catch (...) {
+		deleteGeometries(newPoints.get());
+		throw;
+	}
 }
 
 /*public*/
@@ -448,7 +570,7 @@ GeometryFactory::createMultiPoint(const vector<Geometry *> &fromPoints) const
 
 	MultiPoint *g = NULL;
 	try {
-		g = new MultiPoint(newGeoms,this);
+		g = adopt(new (arena) MultiPoint(newGeoms,this));
 	} catch (...) {
 		for (size_t i=0; i<newGeoms->size(); i++) {
 			delete (*newGeoms)[i];
@@ -463,7 +585,7 @@ GeometryFactory::createMultiPoint(const vector<Geometry *> &fromPoints) const
 MultiPoint*
 GeometryFactory::createMultiPoint() const
 {
-	return new MultiPoint(NULL, this);
+	return adopt(new (arena) MultiPoint(NULL, this));
 }
 
 /*public*/
@@ -514,7 +636,7 @@ GeometryFactory::createMultiPoint(const std::vector<Coordinate> &fromCoords) con
 Polygon*
 GeometryFactory::createPolygon() const
 {
-	return new Polygon(NULL, NULL, this);
+	return adopt(new (arena) Polygon(NULL, NULL, this));
 }
 
 /*public*/
@@ -522,7 +644,23 @@ Polygon*
 GeometryFactory::createPolygon(LinearRing *shell, vector<Geometry *> *holes)
 	const
 {
-	return new Polygon(shell, holes, this);
+	return adopt(new (arena) Polygon(shell, holes, this));
+}
+
+/*public*/
+Geometry::AutoPtr
+GeometryFactory::createPolygon(std::auto_ptr<LinearRing> shell,
+		std::auto_ptr< vector<Geometry *> > holes) const
+{
+	try {
+		Geometry::AutoPtr g(createPolygon(shell.get(), holes.get()));
+		shell.release();
+		holes.release();
+		return g;
+	} catch (...) {
+		deleteGeometries(holes.get());
+		throw;
+	}
 }
 
 /*public*/
@@ -538,7 +676,7 @@ GeometryFactory::createPolygon(const LinearRing &shell, const vector<Geometry *>
 	}
 	Polygon *g = NULL;
 	try {
-		g = new Polygon(newRing, newHoles, this);
+		g = adopt(new (arena) Polygon(newRing, newHoles, this));
 	} catch (...) {
 		delete newRing;
 		for (size_t i=0; i<holes.size(); i++)
@@ -553,14 +691,17 @@ GeometryFactory::createPolygon(const LinearRing &shell, const vector<Geometry *>
 LineString *
 GeometryFactory::createLineString() const
 {
-	return new LineString(NULL, this);
+	return adopt(new (arena) LineString(NULL, this));
 }
 
 /*public*/
 std::auto_ptr<LineString>
 GeometryFactory::createLineString(const LineString& ls) const
 {
-	return std::auto_ptr<LineString>(new LineString(ls));
+	LineString* g = new (arena) LineString(ls);
+	// the copy belongs to cloneFactory
+	g->factory = this;
+	return std::auto_ptr<LineString>(adopt(g));
 }
 
 /*public*/
@@ -568,7 +709,7 @@ LineString*
 GeometryFactory::createLineString(CoordinateSequence *newCoords)
 	const
 {
-	return new LineString(newCoords, this);
+	return adopt(new (arena) LineString(newCoords, this));
 }
 
 /*public*/
@@ -576,7 +717,7 @@ Geometry::AutoPtr
 GeometryFactory::createLineString(CoordinateSequence::AutoPtr newCoords)
 	const
 {
-	return Geometry::AutoPtr(new LineString(newCoords, this));
+	return Geometry::AutoPtr(adopt(new (arena) LineString(newCoords, this)));
 }
 
 /*public*/
@@ -587,7 +728,7 @@ GeometryFactory::createLineString(const CoordinateSequence &fromCoords)
 	CoordinateSequence *newCoords = fromCoords.clone();
 	LineString *g = NULL;
 	// construction failure will delete newCoords
-	g = new LineString(newCoords, this);
+	g = adopt(new (arena) LineString(newCoords, this));
 	return g;
 }
 
@@ -655,6 +796,20 @@ GeometryFactory::buildGeometry(vector<Geometry *> *newGeoms) const
 	return geom0;
 }
 
+/*public*/
+Geometry::AutoPtr
+GeometryFactory::buildGeometry(std::auto_ptr< vector<Geometry *> > newGeoms) const
+{
+	try {
+		Geometry::AutoPtr g(buildGeometry(newGeoms.get()));
+		newGeoms.release();
+		return g;
+	} catch (...) {
+		deleteGeometries(newGeoms.get());
+		throw;
+	}
+}
+
 /*public*/
 Geometry*
 GeometryFactory::buildGeometry(const vector<Geometry *> &fromGeoms) const
@@ -169,7 +169,9 @@ LineString::getPointN(size_t n) const
 {
 	assert(getFactory());
 	assert(points.get());
-	return getFactory()->createPoint(points->getAt(n));
+	Coordinate c;
+	points->getAt(n, c);
+	return getFactory()->createPoint(c);
 }
 
 Point*
@@ -198,7 +200,11 @@ LineString::isClosed() const
 	if (isEmpty()) {
 		return false;
 	}
-	return getCoordinateN(0).equals2D(getCoordinateN(getNumPoints()-1));
+	// Read the ordinates, which does not make sequences that
+	// do not hold Coordinates build them
+	std::size_t last = getNumPoints()-1;
+	return points->getX(0) == points->getX(last) &&
+	       points->getY(0) == points->getY(last);
 }
 
 bool
@@ -238,7 +244,7 @@ LineString::isCoordinate(Coordinate& pt) const
 	assert(points.get());
 	std::size_t npts=points->getSize();
 	for (std::size_t i = 0; i<npts; i++) {
-		if (points->getAt(i)==pt) {
+		if (points->getX(i)==pt.x && points->getY(i)==pt.y) {
 			return true;
 		}
 	}
@@ -246,36 +252,19 @@ LineString::isCoordinate(Coordinate& pt) const
 }
 
 /*protected*/
-Envelope::AutoPtr
+Envelope
 LineString::computeEnvelopeInternal() const
 {
-	if (isEmpty()) {
-		// We don't return NULL here
-		// as it would indicate "unknown"
-		// envelope. In this case we
-		// *know* the envelope is EMPTY.
-		return Envelope::AutoPtr(new Envelope());
-	}
+	// An empty LineString has a null Envelope
+	Envelope env;
+	if (isEmpty()) return env;
 
 	assert(points.get());
-	const Coordinate& c=points->getAt(0);
-	double minx = c.x;
-	double miny = c.y;
-	double maxx = c.x;
-	double maxy = c.y;
-	std::size_t npts=points->getSize();
-	for (std::size_t i=1; i<npts; i++) {
-		const Coordinate &c=points->getAt(i);
-		minx = minx < c.x ? minx : c.x;
-		maxx = maxx > c.x ? maxx : c.x;
-		miny = miny < c.y ? miny : c.y;
-		maxy = maxy > c.y ? maxy : c.y;
-	}
+	points->expandEnvelope(env);
 
-	// caller expects a newly allocated Envelope.
 	// this function won't be called twice, unless
-	// cached Envelope is invalidated (set to NULL)
-	return Envelope::AutoPtr(new Envelope(minx, maxx, miny, maxy));
+	// cached Envelope is invalidated
+	return env;
 }
 
 bool
@@ -291,8 +280,11 @@ LineString::equalsExact(const Geometry *other, double tolerance) const
 	if (npts!=otherLineString->points->getSize()) {
 		return false;
 	}
+	Coordinate a, b;
 	for (size_t i=0; i<npts; ++i) {
-		if (!equal(points->getAt(i),otherLineString->points->getAt(i),tolerance)) {
+		points->getAt(i, a);
+		otherLineString->points->getAt(i, b);
+		if (!equal(a,b,tolerance)) {
 			return false;
 		}
 	}
@@ -332,10 +324,13 @@ LineString::normalize()
 	assert(points.get());
 	std::size_t npts=points->getSize();
 	std::size_t n=npts/2;
+	Coordinate a, b;
 	for (std::size_t i=0; i<n; i++) {
 		std::size_t j = npts - 1 - i;
-		if (!(points->getAt(i)==points->getAt(j))) {
-			if (points->getAt(i).compareTo(points->getAt(j)) > 0) {
+		points->getAt(i, a);
+		points->getAt(j, b);
+		if (!(a==b)) {
+			if (a.compareTo(b) > 0) {
 				CoordinateSequence::reverse(points.get());
 			}
 			return;
@@ -353,9 +348,12 @@ LineString::compareToSameClass(const Geometry *ls) const
 	std::size_t othnpts=line->points->getSize();
 	if ( mynpts > othnpts ) return 1;
 	if ( mynpts < othnpts ) return -1;
+	Coordinate a, b;
 	for (std::size_t i=0; i<mynpts; i++)
 	{
-		int cmp=points->getAt(i).compareTo(line->points->getAt(i));
+		points->getAt(i, a);
+		line->points->getAt(i, b);
+		int cmp=a.compareTo(b);
 		if (cmp) return cmp;
 	}
 	return 0;
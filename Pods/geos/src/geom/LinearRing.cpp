@@ -112,9 +112,9 @@ string LinearRing::getGeometryType() const {
 }
 
 void LinearRing::setPoints(CoordinateSequence* cl){
-	const vector<Coordinate> *v=cl->toVector();
-	points->setPoints(*(v));
-	//delete v;
+	vector<Coordinate> v;
+	cl->toVector(v);
+	points->setPoints(v);
 }
 
 GeometryTypeId
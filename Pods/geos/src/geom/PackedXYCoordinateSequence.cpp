@@ -0,0 +1,298 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geom/PackedXYCoordinateSequence.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateFilter.h>
+#include <geos/util/IllegalArgumentException.h>
+
+#include <sstream>
+#include <vector>
+#include <string>
+
+using namespace std;
+
+namespace geos {
+namespace geom { // geos::geom
+
+PackedXYCoordinateSequence::PackedXYCoordinateSequence()
+{
+}
+
+PackedXYCoordinateSequence::PackedXYCoordinateSequence(size_t n)
+	:
+	xy(2 * n, 0.0)
+{
+}
+
+PackedXYCoordinateSequence::PackedXYCoordinateSequence(const double* p,
+		size_t n)
+	:
+	xy(p, p + 2 * n)
+{
+}
+
+PackedXYCoordinateSequence::PackedXYCoordinateSequence(
+		const PackedXYCoordinateSequence &c)
+	:
+	CoordinateSequence(c),
+	xy(c.xy)
+{
+}
+
+PackedXYCoordinateSequence::PackedXYCoordinateSequence(
+		const CoordinateSequence &c)
+	:
+	CoordinateSequence(c),
+	xy(2 * c.getSize())
+{
+	for (size_t i = 0, n = c.getSize(); i < n; ++i)
+	{
+		xy[2 * i] = c.getX(i);
+		xy[2 * i + 1] = c.getY(i);
+	}
+}
+
+PackedXYCoordinateSequence::~PackedXYCoordinateSequence()
+{
+}
+
+CoordinateSequence *
+PackedXYCoordinateSequence::clone() const
+{
+	return new PackedXYCoordinateSequence(*this);
+}
+
+const Coordinate &
+PackedXYCoordinateSequence::getAt(size_t pos) const
+{
+	return coords.get(*this)[pos];
+}
+
+void
+PackedXYCoordinateSequence::getAt(size_t pos, Coordinate &c) const
+{
+	c.x = xy[2 * pos];
+	c.y = xy[2 * pos + 1];
+	c.z = DoubleNotANumber;
+}
+
+const vector<Coordinate>*
+PackedXYCoordinateSequence::toVector() const
+{
+	return &coords.get(*this);
+}
+
+void
+PackedXYCoordinateSequence::toVector(vector<Coordinate>& out) const
+{
+	for (size_t i = 0, n = getSize(); i < n; ++i)
+		out.push_back(Coordinate(xy[2 * i], xy[2 * i + 1]));
+}
+
+void
+PackedXYCoordinateSequence::add(const Coordinate& c)
+{
+	xy.push_back(c.x);
+	xy.push_back(c.y);
+	if ( vector<Coordinate>* v = coords.getIfBuilt() )
+		v->push_back(Coordinate(c.x, c.y));
+}
+
+void
+PackedXYCoordinateSequence::add(const Coordinate& c, bool allowRepeated)
+{
+	if ( ! allowRepeated && ! xy.empty() )
+	{
+		size_t last = xy.size() - 2;
+		if ( xy[last] == c.x && xy[last + 1] == c.y ) return;
+	}
+	add(c);
+}
+
+/*public*/
+void
+PackedXYCoordinateSequence::add(size_t i, const Coordinate& coord,
+		bool allowRepeated)
+{
+	// don't add duplicate coordinates
+	if ( ! allowRepeated )
+	{
+		size_t sz = getSize();
+		if ( i > 0 && xy[2 * i - 2] == coord.x && xy[2 * i - 1] == coord.y )
+			return;
+		if ( i < sz && xy[2 * i] == coord.x && xy[2 * i + 1] == coord.y )
+			return;
+	}
+
+	double p[2] = { coord.x, coord.y };
+	xy.insert(xy.begin() + 2 * i, p, p + 2);
+	if ( vector<Coordinate>* v = coords.getIfBuilt() )
+		v->insert(v->begin() + i, Coordinate(coord.x, coord.y));
+}
+
+void
+PackedXYCoordinateSequence::setAt(const Coordinate& c, size_t pos)
+{
+	xy[2 * pos] = c.x;
+	xy[2 * pos + 1] = c.y;
+	if ( vector<Coordinate>* v = coords.getIfBuilt() )
+		(*v)[pos] = Coordinate(c.x, c.y);
+}
+
+void
+PackedXYCoordinateSequence::deleteAt(size_t pos)
+{
+	xy.erase(xy.begin() + 2 * pos, xy.begin() + 2 * pos + 2);
+	if ( vector<Coordinate>* v = coords.getIfBuilt() )
+		v->erase(v->begin() + pos);
+}
+
+string
+PackedXYCoordinateSequence::toString() const
+{
+	string result("(");
+	for (size_t i = 0, n = getSize(); i < n; i++)
+	{
+		if ( i ) result.append(", ");
+		result.append(Coordinate(xy[2 * i], xy[2 * i + 1]).toString());
+	}
+	result.append(")");
+
+	return result;
+}
+
+void
+PackedXYCoordinateSequence::setPoints(const vector<Coordinate> &v)
+{
+	xy.resize(2 * v.size());
+	for (size_t i = 0, n = v.size(); i < n; ++i)
+	{
+		xy[2 * i] = v[i].x;
+		xy[2 * i + 1] = v[i].y;
+	}
+	coords.clear();
+}
+
+double
+PackedXYCoordinateSequence::getOrdinate(size_t index,
+		size_t ordinateIndex) const
+{
+	switch (ordinateIndex)
+	{
+		case CoordinateSequence::X:
+			return xy[2 * index];
+		case CoordinateSequence::Y:
+			return xy[2 * index + 1];
+		default:
+			return DoubleNotANumber;
+	}
+}
+
+void
+PackedXYCoordinateSequence::setOrdinate(size_t index, size_t ordinateIndex,
+		double value)
+{
+	switch (ordinateIndex)
+	{
+		case CoordinateSequence::X:
+			xy[2 * index] = value;
+			if ( vector<Coordinate>* v = coords.getIfBuilt() )
+				(*v)[index].x = value;
+			break;
+		case CoordinateSequence::Y:
+			xy[2 * index + 1] = value;
+			if ( vector<Coordinate>* v = coords.getIfBuilt() )
+				(*v)[index].y = value;
+			break;
+		case CoordinateSequence::Z:
+			break; // not stored
+		default:
+		{
+			std::stringstream ss;
+			ss << "Unknown ordinate index " << index;
+			throw util::IllegalArgumentException(ss.str());
+			break;
+		}
+	}
+}
+
+void
+PackedXYCoordinateSequence::expandEnvelope(Envelope &env) const
+{
+	size_t n = xy.size();
+	if ( n == 0 ) return;
+
+	double minX = xy[0], maxX = xy[0];
+	double minY = xy[1], maxY = xy[1];
+	for (size_t i = 2; i < n; i += 2)
+	{
+		if ( xy[i] < minX ) minX = xy[i];
+		if ( xy[i] > maxX ) maxX = xy[i];
+		if ( xy[i + 1] < minY ) minY = xy[i + 1];
+		if ( xy[i + 1] > maxY ) maxY = xy[i + 1];
+	}
+	env.expandToInclude(minX, minY);
+	env.expandToInclude(maxX, maxY);
+}
+
+void
+PackedXYCoordinateSequence::apply_rw(const CoordinateFilter *filter)
+{
+	Coordinate c;
+	for (size_t i = 0, n = getSize(); i < n; ++i)
+	{
+		getAt(i, c);
+		filter->filter_rw(&c);
+		setAt(c, i);
+	}
+}
+
+void
+PackedXYCoordinateSequence::apply_ro(CoordinateFilter *filter) const
+{
+	// Filters may keep the pointers they are given
+	const vector<Coordinate>& v = coords.get(*this);
+	for (vector<Coordinate>::const_iterator i = v.begin(), e = v.end();
+			i != e; ++i)
+	{
+		filter->filter_ro(&(*i));
+	}
+}
+
+CoordinateSequence&
+PackedXYCoordinateSequence::removeRepeatedPoints()
+{
+	size_t n = xy.size();
+	if ( n == 0 ) return *this;
+
+	// Coordinate equality is 2D, as in CoordinateArraySequence
+	size_t out = 2;
+	for (size_t i = 2; i < n; i += 2)
+	{
+		if ( xy[i] == xy[out - 2] && xy[i + 1] == xy[out - 1] ) continue;
+		xy[out] = xy[i];
+		xy[out + 1] = xy[i + 1];
+		out += 2;
+	}
+	if ( out != n )
+	{
+		xy.resize(out);
+		coords.clear();
+	}
+
+	return *this;
+}
+
+} // namespace geos::geom
+} // namespace geos
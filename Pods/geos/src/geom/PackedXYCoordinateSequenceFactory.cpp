@@ -0,0 +1,64 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geom/PackedXYCoordinateSequenceFactory.h>
+#include <geos/geom/PackedXYCoordinateSequence.h>
+
+#include <vector>
+
+using namespace std;
+
+namespace geos {
+namespace geom { // geos::geom
+
+static PackedXYCoordinateSequenceFactory packedXYCoordinateSequenceFactory;
+
+const CoordinateSequenceFactory *
+PackedXYCoordinateSequenceFactory::instance()
+{
+	return &packedXYCoordinateSequenceFactory;
+}
+
+CoordinateSequence *
+PackedXYCoordinateSequenceFactory::create() const
+{
+	return new PackedXYCoordinateSequence();
+}
+
+CoordinateSequence *
+PackedXYCoordinateSequenceFactory::create(vector<Coordinate> *coords,
+		size_t /*dims*/) const
+{
+	PackedXYCoordinateSequence* seq = new PackedXYCoordinateSequence();
+	if ( coords )
+	{
+		seq->setPoints(*coords);
+		delete coords;
+	}
+	return seq;
+}
+
+CoordinateSequence *
+PackedXYCoordinateSequenceFactory::create(size_t size,
+		size_t /*dimension*/) const
+{
+	return new PackedXYCoordinateSequence(size);
+}
+
+CoordinateSequence *
+PackedXYCoordinateSequenceFactory::create(const CoordinateSequence& seq) const
+{
+	return new PackedXYCoordinateSequence(seq);
+}
+
+} // namespace geos::geom
+} // namespace geos
@@ -45,31 +45,41 @@ namespace geom { // geos::geom
 /*protected*/
 Point::Point(CoordinateSequence *newCoords, const GeometryFactory *factory)
 	:
-	Geometry(factory),
-	coordinates(newCoords)
+	Geometry(factory)
 {
-	if (coordinates.get()==NULL) {
-		coordinates.reset(factory->getCoordinateSequenceFactory()->create());
+	std::auto_ptr<CoordinateSequence> coords(newCoords);
+	if (coords.get()==NULL) {
 		return;
 	}        
-	if (coordinates->getSize() != 1)
+	if (coords->getSize() != 1)
 	{
 		throw util::IllegalArgumentException("Point coordinate list must contain a single element");
 	}
+	Coordinate c;
+	coords->getAt(0, c);
+	coordinates.init(c, coords->getDimension());
+}
+
+/*protected*/
+Point::Point(const Coordinate& c, const GeometryFactory *factory)
+	:
+	Geometry(factory),
+	coordinates(c, ISNAN(c.z) ? 2 : 3)
+{
 }
 
 /*protected*/
 Point::Point(const Point &p)
 	:
 	Geometry(p),
-	coordinates(p.coordinates->clone())
+	coordinates(p.coordinates)
 {
 }
 
 CoordinateSequence *
 Point::getCoordinates() const
 {
-	return coordinates->clone();
+	return coordinates.clone();
 }
 
 size_t
@@ -81,7 +91,7 @@ Point::getNumPoints() const
 bool
 Point::isEmpty() const
 {
-	return coordinates->isEmpty();
+	return coordinates.isEmpty();
 }
 
 bool
@@ -99,7 +109,7 @@ Point::getDimension() const
 int
 Point::getCoordinateDimension() const
 {
-    return (int) coordinates->getDimension();
+    return (int) coordinates.getDimension();
 }
 
 int
@@ -129,7 +139,7 @@ Point::getY() const
 const Coordinate *
 Point::getCoordinate() const
 {
-	return coordinates->getSize()!=0 ? &(coordinates->getAt(0)) : NULL;
+	return coordinates.getSize()!=0 ? &(coordinates.getAt(0)) : NULL;
 }
 
 string
@@ -144,16 +154,14 @@ Point::getBoundary() const
 	return getFactory()->createGeometryCollection(NULL);
 }
 
-Envelope::AutoPtr
+Envelope
 Point::computeEnvelopeInternal() const
 {
 	if (isEmpty()) {
-		return Envelope::AutoPtr(new Envelope());
+		return Envelope();
 	}
-
-	return Envelope::AutoPtr(new Envelope(getCoordinate()->x,
-			getCoordinate()->x, getCoordinate()->y,
-			getCoordinate()->y));
+	const Coordinate& c = coordinates.getAt(0);
+	return Envelope(c.x, c.x, c.y, c.y);
 }
 
 void
@@ -167,9 +175,10 @@ void
 Point::apply_rw(const CoordinateFilter *filter)
 {
 	if (isEmpty()) {return;}
-	Coordinate newcoord = coordinates->getAt(0);
+	Coordinate newcoord = coordinates.getAt(0);
 	filter->filter_rw(&newcoord);
-	coordinates->setAt(newcoord, 0);
+	coordinates.setAt(newcoord, 0);
+	geometryChanged();
 }
 
 void
@@ -200,7 +209,7 @@ void
 Point::apply_rw(CoordinateSequenceFilter& filter)
 {
 	if (isEmpty()) return;
-	filter.filter_rw(*coordinates, 0);
+	filter.filter_rw(coordinates, 0);
 	if (filter.isGeometryChanged()) geometryChanged();
 }
 
@@ -208,7 +217,7 @@ void
 Point::apply_ro(CoordinateSequenceFilter& filter) const
 {
 	if (isEmpty()) return;
-	filter.filter_ro(*coordinates, 0);
+	filter.filter_ro(coordinates, 0);
 	//if (filter.isGeometryChanged()) geometryChanged();
 }
 
@@ -257,7 +266,7 @@ Point::getGeometryTypeId() const
 const CoordinateSequence*
 Point::getCoordinatesRO() const
 {
-	return coordinates.get();
+	return &coordinates;
 }
 
 } // namespace geos::geom
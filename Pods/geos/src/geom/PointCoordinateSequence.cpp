@@ -0,0 +1,229 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geom/PointCoordinateSequence.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/CoordinateFilter.h>
+#include <geos/geom/Envelope.h>
+#include <geos/util/IllegalArgumentException.h>
+#include <geos/util/UnsupportedOperationException.h>
+#include <geos/platform.h> // for ISNAN
+
+#include <sstream>
+#include <vector>
+#include <string>
+
+using namespace std;
+
+namespace geos {
+namespace geom { // geos::geom
+
+PointCoordinateSequence::PointCoordinateSequence()
+	:
+	size(0),
+	dimension(3)
+{
+}
+
+PointCoordinateSequence::PointCoordinateSequence(const Coordinate& c,
+		size_t d)
+	:
+	coord(c),
+	size(1),
+	dimension(d ? d : dimensionOf(c))
+{
+}
+
+PointCoordinateSequence::PointCoordinateSequence(
+		const PointCoordinateSequence& other)
+	:
+	CoordinateSequence(other),
+	coord(other.coord),
+	size(other.size),
+	dimension(other.dimension)
+{
+}
+
+PointCoordinateSequence::~PointCoordinateSequence()
+{
+}
+
+void
+PointCoordinateSequence::init(const Coordinate& c, size_t d)
+{
+	coord = c;
+	size = 1;
+	dimension = d ? d : dimensionOf(c);
+	changed();
+}
+
+/*private*/
+void
+PointCoordinateSequence::changed()
+{
+	if ( vector<Coordinate>* v = vect.getIfBuilt() ) v->assign(size, coord);
+}
+
+/*private static*/
+size_t
+PointCoordinateSequence::dimensionOf(const Coordinate& c)
+{
+	return ISNAN(c.z) ? 2 : 3;
+}
+
+/*private static*/
+void
+PointCoordinateSequence::throwTooLong()
+{
+	throw util::UnsupportedOperationException("Point coordinate list must contain a single element");
+}
+
+CoordinateSequence *
+PointCoordinateSequence::clone() const
+{
+	return new CoordinateArraySequence(new vector<Coordinate>(size, coord),
+			getDimension());
+}
+
+const vector<Coordinate>*
+PointCoordinateSequence::toVector() const
+{
+	return &vect.get(*this);
+}
+
+void
+PointCoordinateSequence::toVector(vector<Coordinate>& out) const
+{
+	if ( size ) out.push_back(coord);
+}
+
+void
+PointCoordinateSequence::add(const Coordinate& c)
+{
+	if ( size ) throwTooLong();
+	init(c, dimension);
+}
+
+void
+PointCoordinateSequence::add(const Coordinate& c, bool allowRepeated)
+{
+	if ( size && ! allowRepeated && coord.equals2D(c) ) return;
+	add(c);
+}
+
+void
+PointCoordinateSequence::add(size_t, const Coordinate& c, bool allowRepeated)
+{
+	add(c, allowRepeated);
+}
+
+void
+PointCoordinateSequence::setAt(const Coordinate& c, size_t)
+{
+	coord = c;
+	changed();
+}
+
+void
+PointCoordinateSequence::deleteAt(size_t)
+{
+	size = 0;
+	changed();
+}
+
+string
+PointCoordinateSequence::toString() const
+{
+	string result("(");
+	if ( size ) result.append(coord.toString());
+	result.append(")");
+	return result;
+}
+
+void
+PointCoordinateSequence::setPoints(const vector<Coordinate> &v)
+{
+	if ( v.size() > 1 ) throwTooLong();
+	if ( v.empty() ) deleteAt(0);
+	else init(v[0], dimension);
+}
+
+double
+PointCoordinateSequence::getOrdinate(size_t, size_t ordinateIndex) const
+{
+	switch (ordinateIndex)
+	{
+		case CoordinateSequence::X:
+			return coord.x;
+		case CoordinateSequence::Y:
+			return coord.y;
+		case CoordinateSequence::Z:
+			return coord.z;
+		default:
+			return DoubleNotANumber;
+	}
+}
+
+void
+PointCoordinateSequence::setOrdinate(size_t index, size_t ordinateIndex,
+		double value)
+{
+	switch (ordinateIndex)
+	{
+		case CoordinateSequence::X:
+			coord.x = value;
+			break;
+		case CoordinateSequence::Y:
+			coord.y = value;
+			break;
+		case CoordinateSequence::Z:
+			coord.z = value;
+			break;
+		default:
+		{
+			std::stringstream ss;
+			ss << "Unknown ordinate index " << index;
+			throw util::IllegalArgumentException(ss.str());
+		}
+	}
+	changed();
+}
+
+void
+PointCoordinateSequence::expandEnvelope(Envelope &e) const
+{
+	if ( size ) e.expandToInclude(coord.x, coord.y);
+}
+
+size_t
+PointCoordinateSequence::getDimension() const
+{
+	return dimension;
+}
+
+void
+PointCoordinateSequence::apply_rw(const CoordinateFilter *filter)
+{
+	if ( ! size ) return;
+	filter->filter_rw(&coord);
+	changed();
+	dimension = dimensionOf(coord); // re-check, as CoordinateArraySequence does
+}
+
+void
+PointCoordinateSequence::apply_ro(CoordinateFilter *filter) const
+{
+	if ( size ) filter->filter_ro(&coord);
+}
+
+} // namespace geos::geom
+} // namespace geos
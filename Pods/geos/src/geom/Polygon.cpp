@@ -242,10 +242,10 @@ Polygon::getBoundary() const
 	return ret;
 }
 
-Envelope::AutoPtr
+Envelope
 Polygon::computeEnvelopeInternal() const
 {
-	return Envelope::AutoPtr(new Envelope(*(shell->getEnvelopeInternal())));
+	return *(shell->getEnvelopeInternal());
 }
 
 bool
@@ -0,0 +1,359 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geom/QuantizedCoordinateSequence.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateFilter.h>
+#include <geos/util/IllegalArgumentException.h>
+#include <geos/util/math.h>
+
+#include <sstream>
+#include <vector>
+#include <string>
+#include <climits>
+
+using namespace std;
+
+namespace geos {
+namespace geom { // geos::geom
+
+namespace {
+
+double
+checkScale(double scale)
+{
+	if ( ! ( scale > 0 ) )
+		throw util::IllegalArgumentException("QuantizedCoordinateSequence: scale must be positive");
+	return scale;
+}
+
+} // anonymous namespace
+
+QuantizedCoordinateSequence::QuantizedCoordinateSequence(double s,
+		int64 originX, int64 originY)
+	:
+	scale(checkScale(s)),
+	ox(static_cast<double>(originX)),
+	oy(static_cast<double>(originY))
+{
+}
+
+QuantizedCoordinateSequence::QuantizedCoordinateSequence(size_t n, double s,
+		int64 originX, int64 originY)
+	:
+	scale(checkScale(s)),
+	ox(static_cast<double>(originX)),
+	oy(static_cast<double>(originY)),
+	q(2 * n, 0)
+{
+}
+
+QuantizedCoordinateSequence::QuantizedCoordinateSequence(
+		const QuantizedCoordinateSequence &c)
+	:
+	CoordinateSequence(c),
+	scale(c.scale),
+	ox(c.ox),
+	oy(c.oy),
+	q(c.q)
+{
+}
+
+QuantizedCoordinateSequence::QuantizedCoordinateSequence(
+		const CoordinateSequence &c, double s, int64 originX, int64 originY)
+	:
+	CoordinateSequence(c),
+	scale(checkScale(s)),
+	ox(static_cast<double>(originX)),
+	oy(static_cast<double>(originY)),
+	q(2 * c.getSize())
+{
+	for (size_t i = 0, n = c.getSize(); i < n; ++i)
+	{
+		q[2 * i] = quantize(c.getX(i), ox);
+		q[2 * i + 1] = quantize(c.getY(i), oy);
+	}
+}
+
+QuantizedCoordinateSequence::~QuantizedCoordinateSequence()
+{
+}
+
+CoordinateSequence *
+QuantizedCoordinateSequence::clone() const
+{
+	return new QuantizedCoordinateSequence(*this);
+}
+
+/*private*/
+int
+QuantizedCoordinateSequence::quantize(double v, double origin) const
+{
+	// Same rounding as PrecisionModel::makePrecise
+	double d = util::round(v * scale) - origin;
+	if ( ! ( d >= INT_MIN && d <= INT_MAX ) )
+	{
+		std::stringstream ss;
+		ss << "QuantizedCoordinateSequence: " << v
+		   << " is out of the range of the grid";
+		throw util::IllegalArgumentException(ss.str());
+	}
+	return static_cast<int>(d);
+}
+
+void
+QuantizedCoordinateSequence::decode(double* xy, size_t start,
+		size_t count) const
+{
+	if ( ! count ) return;
+
+	const int* p = &q[2 * start];
+	for (size_t i = 0; i < count; ++i)
+	{
+		xy[2 * i] = (ox + p[2 * i]) / scale;
+		xy[2 * i + 1] = (oy + p[2 * i + 1]) / scale;
+	}
+}
+
+const Coordinate &
+QuantizedCoordinateSequence::getAt(size_t pos) const
+{
+	return coords.get(*this)[pos];
+}
+
+void
+QuantizedCoordinateSequence::getAt(size_t pos, Coordinate &c) const
+{
+	c.x = getX(pos);
+	c.y = getY(pos);
+	c.z = DoubleNotANumber;
+}
+
+const vector<Coordinate>*
+QuantizedCoordinateSequence::toVector() const
+{
+	return &coords.get(*this);
+}
+
+void
+QuantizedCoordinateSequence::toVector(vector<Coordinate>& out) const
+{
+	for (size_t i = 0, n = getSize(); i < n; ++i)
+		out.push_back(Coordinate(getX(i), getY(i)));
+}
+
+void
+QuantizedCoordinateSequence::add(const Coordinate& c)
+{
+	int qx = quantize(c.x, ox);
+	int qy = quantize(c.y, oy);
+	q.push_back(qx);
+	q.push_back(qy);
+	if ( vector<Coordinate>* v = coords.getIfBuilt() )
+		v->push_back(Coordinate(getX(getSize() - 1), getY(getSize() - 1)));
+}
+
+void
+QuantizedCoordinateSequence::add(const Coordinate& c, bool allowRepeated)
+{
+	// Repeated on the grid, which is how they would be stored
+	if ( ! allowRepeated && ! q.empty() )
+	{
+		size_t last = q.size() - 2;
+		if ( q[last] == quantize(c.x, ox) && q[last + 1] == quantize(c.y, oy) )
+			return;
+	}
+	add(c);
+}
+
+/*public*/
+void
+QuantizedCoordinateSequence::add(size_t i, const Coordinate& coord,
+		bool allowRepeated)
+{
+	int p[2] = { quantize(coord.x, ox), quantize(coord.y, oy) };
+
+	// don't add duplicate coordinates
+	if ( ! allowRepeated )
+	{
+		size_t sz = getSize();
+		if ( i > 0 && q[2 * i - 2] == p[0] && q[2 * i - 1] == p[1] )
+			return;
+		if ( i < sz && q[2 * i] == p[0] && q[2 * i + 1] == p[1] )
+			return;
+	}
+
+	q.insert(q.begin() + 2 * i, p, p + 2);
+	if ( vector<Coordinate>* v = coords.getIfBuilt() )
+		v->insert(v->begin() + i, Coordinate(getX(i), getY(i)));
+}
+
+void
+QuantizedCoordinateSequence::setAt(const Coordinate& c, size_t pos)
+{
+	int qx = quantize(c.x, ox);
+	int qy = quantize(c.y, oy);
+	q[2 * pos] = qx;
+	q[2 * pos + 1] = qy;
+	if ( vector<Coordinate>* v = coords.getIfBuilt() )
+		(*v)[pos] = Coordinate(getX(pos), getY(pos));
+}
+
+void
+QuantizedCoordinateSequence::deleteAt(size_t pos)
+{
+	q.erase(q.begin() + 2 * pos, q.begin() + 2 * pos + 2);
+	if ( vector<Coordinate>* v = coords.getIfBuilt() )
+		v->erase(v->begin() + pos);
+}
+
+string
+QuantizedCoordinateSequence::toString() const
+{
+	string result("(");
+	for (size_t i = 0, n = getSize(); i < n; i++)
+	{
+		if ( i ) result.append(", ");
+		result.append(Coordinate(getX(i), getY(i)).toString());
+	}
+	result.append(")");
+
+	return result;
+}
+
+void
+QuantizedCoordinateSequence::setPoints(const vector<Coordinate> &v)
+{
+	vector<int> nq(2 * v.size());
+	for (size_t i = 0, n = v.size(); i < n; ++i)
+	{
+		nq[2 * i] = quantize(v[i].x, ox);
+		nq[2 * i + 1] = quantize(v[i].y, oy);
+	}
+	q.swap(nq);
+	coords.clear();
+}
+
+double
+QuantizedCoordinateSequence::getOrdinate(size_t index,
+		size_t ordinateIndex) const
+{
+	switch (ordinateIndex)
+	{
+		case CoordinateSequence::X:
+			return getX(index);
+		case CoordinateSequence::Y:
+			return getY(index);
+		default:
+			return DoubleNotANumber;
+	}
+}
+
+void
+QuantizedCoordinateSequence::setOrdinate(size_t index, size_t ordinateIndex,
+		double value)
+{
+	switch (ordinateIndex)
+	{
+		case CoordinateSequence::X:
+			q[2 * index] = quantize(value, ox);
+			if ( vector<Coordinate>* v = coords.getIfBuilt() )
+				(*v)[index].x = getX(index);
+			break;
+		case CoordinateSequence::Y:
+			q[2 * index + 1] = quantize(value, oy);
+			if ( vector<Coordinate>* v = coords.getIfBuilt() )
+				(*v)[index].y = getY(index);
+			break;
+		case CoordinateSequence::Z:
+			break; // not stored
+		default:
+		{
+			std::stringstream ss;
+			ss << "Unknown ordinate index " << index;
+			throw util::IllegalArgumentException(ss.str());
+			break;
+		}
+	}
+}
+
+void
+QuantizedCoordinateSequence::expandEnvelope(Envelope &env) const
+{
+	size_t n = q.size();
+	if ( n == 0 ) return;
+
+	// Compare on the grid, decode the extremes only
+	int minX = q[0], maxX = q[0];
+	int minY = q[1], maxY = q[1];
+	for (size_t i = 2; i < n; i += 2)
+	{
+		if ( q[i] < minX ) minX = q[i];
+		if ( q[i] > maxX ) maxX = q[i];
+		if ( q[i + 1] < minY ) minY = q[i + 1];
+		if ( q[i + 1] > maxY ) maxY = q[i + 1];
+	}
+	env.expandToInclude((ox + minX) / scale, (oy + minY) / scale);
+	env.expandToInclude((ox + maxX) / scale, (oy + maxY) / scale);
+}
+
+void
+QuantizedCoordinateSequence::apply_rw(const CoordinateFilter *filter)
+{
+	Coordinate c;
+	for (size_t i = 0, n = getSize(); i < n; ++i)
+	{
+		getAt(i, c);
+		filter->filter_rw(&c);
+		setAt(c, i);
+	}
+}
+
+void
+QuantizedCoordinateSequence::apply_ro(CoordinateFilter *filter) const
+{
+	// Filters may keep the pointers they are given
+	const vector<Coordinate>& v = coords.get(*this);
+	for (vector<Coordinate>::const_iterator i = v.begin(), e = v.end();
+			i != e; ++i)
+	{
+		filter->filter_ro(&(*i));
+	}
+}
+
+CoordinateSequence&
+QuantizedCoordinateSequence::removeRepeatedPoints()
+{
+	size_t n = q.size();
+	if ( n == 0 ) return *this;
+
+	// Coordinate equality is 2D, as in CoordinateArraySequence
+	size_t out = 2;
+	for (size_t i = 2; i < n; i += 2)
+	{
+		if ( q[i] == q[out - 2] && q[i + 1] == q[out - 1] ) continue;
+		q[out] = q[i];
+		q[out + 1] = q[i + 1];
+		out += 2;
+	}
+	if ( out != n )
+	{
+		q.resize(out);
+		coords.clear();
+	}
+
+	return *this;
+}
+
+} // namespace geos::geom
+} // namespace geos
@@ -0,0 +1,69 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geom/QuantizedCoordinateSequenceFactory.h>
+#include <geos/geom/QuantizedCoordinateSequence.h>
+#include <geos/geom/PrecisionModel.h>
+#include <geos/util/IllegalArgumentException.h>
+
+#include <vector>
+#include <memory>
+
+using namespace std;
+
+namespace geos {
+namespace geom { // geos::geom
+
+QuantizedCoordinateSequenceFactory::QuantizedCoordinateSequenceFactory(
+		const PrecisionModel& pm, int64 ox, int64 oy)
+	:
+	scale(pm.getScale()),
+	originX(ox),
+	originY(oy)
+{
+	if ( pm.getType() != PrecisionModel::FIXED )
+		throw util::IllegalArgumentException("QuantizedCoordinateSequenceFactory needs a FIXED PrecisionModel");
+}
+
+CoordinateSequence *
+QuantizedCoordinateSequenceFactory::create() const
+{
+	return new QuantizedCoordinateSequence(scale, originX, originY);
+}
+
+CoordinateSequence *
+QuantizedCoordinateSequenceFactory::create(vector<Coordinate> *coords,
+		size_t /*dims*/) const
+{
+	// Takes ownership of coords, even if it throws
+	auto_ptr< vector<Coordinate> > v(coords);
+	auto_ptr<QuantizedCoordinateSequence> seq(
+		new QuantizedCoordinateSequence(scale, originX, originY));
+	if ( v.get() ) seq->setPoints(*v);
+	return seq.release();
+}
+
+CoordinateSequence *
+QuantizedCoordinateSequenceFactory::create(size_t size,
+		size_t /*dimension*/) const
+{
+	return new QuantizedCoordinateSequence(size, scale, originX, originY);
+}
+
+CoordinateSequence *
+QuantizedCoordinateSequenceFactory::create(const CoordinateSequence& seq) const
+{
+	return new QuantizedCoordinateSequence(seq, scale, originX, originY);
+}
+
+} // namespace geos::geom
+} // namespace geos
@@ -66,6 +66,7 @@ EdgeRing::EdgeRing(DirectedEdge *newStart,
         label(Location::UNDEF), // new Label(Location::UNDEF)),
         ring(NULL),
         isHoleVar(false),
+        released(false),
         shell(NULL)
 {
 	/*
@@ -196,6 +197,31 @@ EdgeRing::toPolygon(const GeometryFactory* geometryFactory)
 	return geometryFactory->createPolygon(shellLR, holeLR);
 }
 
+/*public*/
+Polygon*
+EdgeRing::releasePolygon(const GeometryFactory* geometryFactory)
+{
+	testInvariant();
+
+	size_t nholes=holes.size();
+	vector<Geometry *> *holeLR=new vector<Geometry *>(nholes);
+	for (size_t i=0; i<nholes; ++i)
+	{
+		EdgeRing *hole=holes[i];
+		(*holeLR)[i]=hole->getLinearRing();
+		hole->ring=NULL;
+		hole->pts=NULL;
+		hole->released=true;
+	}
+
+	LinearRing *shellLR=getLinearRing();
+	ring=NULL;
+	pts=NULL;
+	released=true;
+
+	return geometryFactory->createPolygon(shellLR, holeLR);
+}
+
 /*public*/
 void
 EdgeRing::computeRing()
@@ -0,0 +1,130 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/index/BatchQuery.h>
+#include <geos/index/HilbertCode.h>
+#include <geos/geom/Envelope.h>
+#include <geos/util/ParallelFor.h>
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+using namespace geos::geom;
+
+namespace geos {
+namespace index { // geos.index
+
+namespace {
+
+class GroupTask: public util::ParallelTask {
+public:
+	GroupTask(const BatchQuery& q,
+	          const vector<const Envelope*>& envs,
+	          const vector<size_t>& ids,
+	          vector< vector<BatchQueryHit> >& out)
+		: query(q), searchEnvs(envs), order(ids), groupHits(out)
+	{}
+
+	void run(size_t g)
+	{
+		size_t first = g * BatchQuery::groupSize;
+		size_t count = min(BatchQuery::groupSize, order.size() - first);
+		query.queryGroup(searchEnvs, &order[first], count, groupHits[g]);
+	}
+
+private:
+	const BatchQuery& query;
+	const vector<const Envelope*>& searchEnvs;
+	const vector<size_t>& order;
+	vector< vector<BatchQueryHit> >& groupHits;
+};
+
+} // anonymous namespace
+
+const std::size_t BatchQuery::groupSize;
+
+/*public*/
+void
+BatchQuery::run(const vector<const Envelope*>& searchEnvs,
+                vector<BatchQueryHit>& hits, size_t numThreads) const
+{
+	vector<size_t> ids;
+	ids.reserve(searchEnvs.size());
+	double cMinX = numeric_limits<double>::infinity();
+	double cMinY = cMinX;
+	double cMaxX = -cMinX;
+	double cMaxY = -cMinX;
+	for (size_t i = 0, n = searchEnvs.size(); i < n; ++i)
+	{
+		const Envelope* e = searchEnvs[i];
+		if ( ! e || e->isNull() ) continue;
+		ids.push_back(i);
+		double cx = (e->getMinX() + e->getMaxX()) / 2.0;
+		double cy = (e->getMinY() + e->getMaxY()) / 2.0;
+		if (cx < cMinX) cMinX = cx;
+		if (cx > cMaxX) cMaxX = cx;
+		if (cy < cMinY) cMinY = cy;
+		if (cy > cMaxY) cMaxY = cy;
+	}
+	if ( ids.empty() ) return;
+
+	// Order the queries along a Hilbert curve, so that each group
+	// covers a compact area and shares most of its node visits
+	const double gridMax = HilbertCode::maxOrdinate;
+	const double sx = cMaxX > cMinX ? gridMax / (cMaxX - cMinX) : 0.0;
+	const double sy = cMaxY > cMinY ? gridMax / (cMaxY - cMinY) : 0.0;
+	vector< pair<unsigned int, size_t> > keyed(ids.size());
+	for (size_t i = 0, n = ids.size(); i < n; ++i)
+	{
+		const Envelope* e = searchEnvs[ids[i]];
+		double cx = (e->getMinX() + e->getMaxX()) / 2.0;
+		double cy = (e->getMinY() + e->getMaxY()) / 2.0;
+		keyed[i] = make_pair(HilbertCode::encode(
+				static_cast<unsigned int>((cx - cMinX) * sx),
+				static_cast<unsigned int>((cy - cMinY) * sy)), ids[i]);
+	}
+	sort(keyed.begin(), keyed.end());
+	for (size_t i = 0, n = keyed.size(); i < n; ++i)
+		ids[i] = keyed[i].second;
+
+	size_t numGroups = (ids.size() + groupSize - 1) / groupSize;
+	vector< vector<BatchQueryHit> > groupHits(numGroups);
+
+	GroupTask task(*this, searchEnvs, ids, groupHits);
+	util::parallelFor(numGroups, numThreads, task);
+
+	// Back to query order, by counting sort: it is stable, so each
+	// query keeps the order of its own hits
+	vector<size_t> offset(searchEnvs.size() + 1, 0);
+	for (size_t g = 0; g < numGroups; ++g)
+	{
+		const vector<BatchQueryHit>& gh = groupHits[g];
+		for (size_t i = 0, n = gh.size(); i < n; ++i)
+			++offset[gh[i].first + 1];
+	}
+	for (size_t i = 1, n = offset.size(); i < n; ++i)
+		offset[i] += offset[i - 1];
+
+	size_t first = hits.size();
+	hits.resize(first + offset.back());
+	for (size_t g = 0; g < numGroups; ++g)
+	{
+		const vector<BatchQueryHit>& gh = groupHits[g];
+		for (size_t i = 0, n = gh.size(); i < n; ++i)
+			hits[first + offset[gh[i].first]++] = gh[i];
+	}
+}
+
+} // namespace geos.index
+} // namespace geos
@@ -0,0 +1,49 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/index/HilbertCode.h>
+
+#include <algorithm>
+
+namespace geos {
+namespace index { // geos.index
+
+const unsigned int HilbertCode::maxOrdinate;
+
+/*public static*/
+unsigned int
+HilbertCode::encode(unsigned int x, unsigned int y)
+{
+	const unsigned int n = maxOrdinate + 1;
+	unsigned int d = 0;
+	for (unsigned int s = n / 2; s > 0; s /= 2)
+	{
+		unsigned int rx = (x & s) ? 1u : 0u;
+		unsigned int ry = (y & s) ? 1u : 0u;
+		d += s * s * ((3u * rx) ^ ry);
+
+		// rotate the quadrant so the sub-curve has the right orientation
+		if (ry == 0)
+		{
+			if (rx == 1)
+			{
+				x = n - 1 - x;
+				y = n - 1 - y;
+			}
+			std::swap(x, y);
+		}
+	}
+	return d;
+}
+
+} // namespace geos.index
+} // namespace geos
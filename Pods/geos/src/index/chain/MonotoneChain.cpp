@@ -52,8 +52,9 @@ MonotoneChain::getEnvelope() const
 {
     if (0 == env)
     {
-        const Coordinate& p0 = pts[start];
-        const Coordinate& p1 = pts[end];
+        Coordinate p0, p1;
+        pts.getAt(start, p0);
+        pts.getAt(end, p1);
         env = new Envelope(p0, p1);
     }
     return *env;
@@ -62,8 +63,8 @@ MonotoneChain::getEnvelope() const
 void
 MonotoneChain::getLineSegment(size_t index, LineSegment& ls) const
 {
-    ls.p0 = pts[index];
-    ls.p1 = pts[index+1];
+    pts.getAt(index, ls.p0);
+    pts.getAt(index+1, ls.p1);
 }
 
 std::auto_ptr<CoordinateSequence>
@@ -83,8 +84,9 @@ MonotoneChain::computeSelect(const Envelope& searchEnv,
                              size_t start0, size_t end0,
                              MonotoneChainSelectAction& mcs )
 {
-    const Coordinate& p0=pts[start0];
-    const Coordinate& p1=pts[end0];
+    Coordinate p0, p1;
+    pts.getAt(start0, p0);
+    pts.getAt(end0, p1);
     mcs.tempEnv1.init(p0,p1);
 
     //Debug.println("trying:"+p0+p1+" [ "+start0+","+end0+" ]");
@@ -137,10 +139,11 @@ MonotoneChain::computeOverlaps(size_t start0, size_t end0,
         return;
     }
 
-    const Coordinate& p00 = pts[start0];
-    const Coordinate& p01 = pts[end0];
-    const Coordinate& p10 = mc.pts[start1];
-    const Coordinate& p11 = mc.pts[end1];
+    Coordinate p00, p01, p10, p11;
+    pts.getAt(start0, p00);
+    pts.getAt(end0, p01);
+    mc.pts.getAt(start1, p10);
+    mc.pts.getAt(end1, p11);
 
     // nothing to do if the envelopes of these chains don't overlap
     mco.tempEnv1.init(p00, p01);
@@ -19,6 +19,7 @@
 #include <geos/index/chain/MonotoneChainBuilder.h> 
 #include <geos/index/chain/MonotoneChain.h> 
 #include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Coordinate.h>
 #include <geos/geomgraph/Quadrant.h>
 
 #include <cassert>
@@ -99,13 +100,21 @@ MonotoneChainBuilder::findChainEnd(const CoordinateSequence& pts, std::size_t st
 	assert(npts); // should be implied by the assertion above,
 	              // 'start' being unsigned
 
+	// Points are copied out with getAt(i, c), for which sequences
+	// such as PackedXYCoordinateSequence need no Coordinate copy
+	// of all their points
+	Coordinate prev, curr;
+	pts.getAt(start, curr);
+
 	std::size_t safeStart = start;
 
         // skip any zero-length segments at the start of the sequence
         // (since they cannot be used to establish a quadrant)
-	while ( safeStart < npts - 1
-		&& pts[safeStart].equals2D(pts[safeStart+1]) ) 
+	while ( safeStart < npts - 1 )
 	{
+		prev = curr;
+		pts.getAt(safeStart + 1, curr);
+		if ( ! prev.equals2D(curr) ) break;
 		++safeStart;
 	}
 
@@ -116,17 +125,19 @@ MonotoneChainBuilder::findChainEnd(const CoordinateSequence& pts, std::size_t st
 
 	// determine overall quadrant for chain
 	// (which is the starting quadrant)
-	int chainQuad = Quadrant::quadrant(pts[safeStart],
-	                                   pts[safeStart + 1]);
+	int chainQuad = Quadrant::quadrant(prev, curr);
 	std::size_t last = start + 1;
+	pts.getAt(start, curr);
 	while (last < npts)
 	{
+		prev = curr;
+		pts.getAt(last, curr);
+
 		// skip zero-length segments, but include them in the chain
-		if (! pts[last - 1].equals2D( pts[last] ) )
+		if (! prev.equals2D( curr ) )
 		{
 			// compute quadrant for next possible segment in chain
-			int quad = Quadrant::quadrant( pts[last - 1],
-			                               pts[last]      );
+			int quad = Quadrant::quadrant( prev, curr );
 			if (quad != chainQuad) break;
 		}
 		++last;	
@@ -0,0 +1,420 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/index/hilbertrtree/HilbertRtree.h>
+#include <geos/index/HilbertCode.h>
+#include <geos/index/strtree/PackedSTRtree.h>
+#include <geos/index/strtree/ItemBoundable.h>
+#include <geos/index/strtree/ItemDistance.h>
+#include <geos/index/ItemVisitor.h>
+#include <geos/geom/Envelope.h>
+#include <geos/util/IllegalArgumentException.h>
+
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <utility>
+#include <limits>
+#include <cmath>
+#include <cassert>
+
+using namespace std;
+using namespace geos::geom;
+using geos::index::strtree::PackedSTRtree;
+using geos::index::strtree::ItemBoundable;
+using geos::index::strtree::ItemDistance;
+
+namespace geos {
+namespace index { // geos.index
+namespace hilbertrtree { // geos.index.hilbertrtree
+
+namespace {
+
+class VisitorSink {
+	ItemVisitor& visitor;
+public:
+	VisitorSink(ItemVisitor& v) : visitor(v) {}
+	void add(void* item) { visitor.visitItem(item); }
+};
+
+class VectorSink {
+	vector<void*>& matches;
+public:
+	VectorSink(vector<void*>& m) : matches(m) {}
+	void add(void* item) { matches.push_back(item); }
+};
+
+/// An entry of the nearest-neighbour search queue
+struct Candidate {
+	double distance;
+	size_t index;
+	size_t level;
+
+	Candidate(double d, size_t i, size_t l)
+		: distance(d), index(i), level(l) {}
+};
+
+/// Closest candidate on top; ties broken by position, for determinism
+struct CandidateGreater {
+	bool operator()(const Candidate& a, const Candidate& b) const
+	{
+		if (a.distance != b.distance) return a.distance > b.distance;
+		if (a.level != b.level) return a.level > b.level;
+		return a.index > b.index;
+	}
+};
+
+/// Distance between two boxes, 0 if they intersect
+double
+boxDistance(double aMinX, double aMinY, double aMaxX, double aMaxY,
+            double bMinX, double bMinY, double bMaxX, double bMaxY)
+{
+	double dx = 0.0;
+	if (aMaxX < bMinX) dx = bMinX - aMaxX;
+	else if (bMaxX < aMinX) dx = aMinX - bMaxX;
+
+	double dy = 0.0;
+	if (aMaxY < bMinY) dy = bMinY - aMaxY;
+	else if (bMaxY < aMinY) dy = aMinY - bMaxY;
+
+	if (dx == 0.0) return dy;
+	if (dy == 0.0) return dx;
+	return sqrt(dx * dx + dy * dy);
+}
+
+} // anonymous namespace
+
+HilbertRtree::HilbertRtree(size_t newNodeCapacity)
+	:
+	nodeCapacity(newNodeCapacity),
+	built(false)
+{
+	if (nodeCapacity < 2)
+		throw util::IllegalArgumentException(
+			"HilbertRtree node capacity must be at least 2");
+}
+
+HilbertRtree::~HilbertRtree()
+{
+}
+
+/*public*/
+void
+HilbertRtree::insert(const Envelope *itemEnv, void* item)
+{
+	if (itemEnv->isNull()) return;
+
+	Entry e;
+	e.minX = itemEnv->getMinX();
+	e.minY = itemEnv->getMinY();
+	e.maxX = itemEnv->getMaxX();
+	e.maxY = itemEnv->getMaxY();
+	e.item = item;
+	entries.push_back(e);
+	built = false;
+}
+
+/*public*/
+bool
+HilbertRtree::remove(const Envelope *itemEnv, void* item)
+{
+	for (vector<Entry>::iterator i = entries.begin(), e = entries.end();
+			i != e; ++i)
+	{
+		if (i->item != item) continue;
+		if (itemEnv->getMinX() > i->maxX || itemEnv->getMaxX() < i->minX ||
+		    itemEnv->getMinY() > i->maxY || itemEnv->getMaxY() < i->minY)
+			continue;
+		entries.erase(i);
+		built = false;
+		return true;
+	}
+	return false;
+}
+
+/*public*/
+void
+HilbertRtree::build()
+{
+	if (built) return;
+
+	minX.clear();
+	minY.clear();
+	maxX.clear();
+	maxY.clear();
+	items.clear();
+	levelBounds.clear();
+
+	const size_t numItems = entries.size();
+	built = true;
+	if (numItems == 0) return;
+
+	// Extent of the item centres, mapped onto the Hilbert grid
+	double cMinX = numeric_limits<double>::infinity();
+	double cMinY = cMinX;
+	double cMaxX = -cMinX;
+	double cMaxY = -cMinX;
+	for (size_t i = 0; i < numItems; ++i)
+	{
+		const Entry& e = entries[i];
+		double cx = (e.minX + e.maxX) / 2.0;
+		double cy = (e.minY + e.maxY) / 2.0;
+		if (cx < cMinX) cMinX = cx;
+		if (cx > cMaxX) cMaxX = cx;
+		if (cy < cMinY) cMinY = cy;
+		if (cy > cMaxY) cMaxY = cy;
+	}
+	const double gridMax = HilbertCode::maxOrdinate;
+	const double sx = cMaxX > cMinX ? gridMax / (cMaxX - cMinX) : 0.0;
+	const double sy = cMaxY > cMinY ? gridMax / (cMaxY - cMinY) : 0.0;
+
+	// Sort by (code, insertion index); the index makes the order,
+	// and so the tree, independent of the sort implementation
+	vector< pair<unsigned int, size_t> > order(numItems);
+	for (size_t i = 0; i < numItems; ++i)
+	{
+		const Entry& e = entries[i];
+		double cx = (e.minX + e.maxX) / 2.0;
+		double cy = (e.minY + e.maxY) / 2.0;
+		unsigned int hx = static_cast<unsigned int>((cx - cMinX) * sx);
+		unsigned int hy = static_cast<unsigned int>((cy - cMinY) * sy);
+		order[i] = make_pair(HilbertCode::encode(hx, hy), i);
+	}
+	sort(order.begin(), order.end());
+
+	// Count the entries of all levels, up to a single root
+	size_t total = numItems;
+	size_t levelSize = numItems;
+	do {
+		levelSize = (levelSize + nodeCapacity - 1) / nodeCapacity;
+		total += levelSize;
+	} while (levelSize > 1);
+
+	const size_t padding = PackedSTRtree::slotGroupSize - 1;
+	minX.reserve(total + padding);
+	minY.reserve(total + padding);
+	maxX.reserve(total + padding);
+	maxY.reserve(total + padding);
+	items.reserve(numItems);
+
+	for (size_t i = 0; i < numItems; ++i)
+	{
+		const Entry& e = entries[order[i].second];
+		minX.push_back(e.minX);
+		minY.push_back(e.minY);
+		maxX.push_back(e.maxX);
+		maxY.push_back(e.maxY);
+		items.push_back(e.item);
+	}
+	levelBounds.push_back(numItems);
+
+	// Each node covers the next nodeCapacity entries of the level below
+	size_t levelStart = 0;
+	do {
+		const size_t levelEnd = levelBounds.back();
+		for (size_t first = levelStart; first < levelEnd; first += nodeCapacity)
+		{
+			size_t last = first + nodeCapacity;
+			if (last > levelEnd) last = levelEnd;
+
+			double nMinX = minX[first], nMinY = minY[first];
+			double nMaxX = maxX[first], nMaxY = maxY[first];
+			for (size_t c = first + 1; c < last; ++c)
+			{
+				if (minX[c] < nMinX) nMinX = minX[c];
+				if (minY[c] < nMinY) nMinY = minY[c];
+				if (maxX[c] > nMaxX) nMaxX = maxX[c];
+				if (maxY[c] > nMaxY) nMaxY = maxY[c];
+			}
+			minX.push_back(nMinX);
+			minY.push_back(nMinY);
+			maxX.push_back(nMaxX);
+			maxY.push_back(nMaxY);
+		}
+		levelStart = levelEnd;
+		levelBounds.push_back(minX.size());
+	} while (levelBounds.back() - levelStart > 1);
+
+	assert(minX.size() == total);
+
+	// Node scans are rounded up to whole slot groups, which may
+	// read past the last entry. Padding slots are never reported.
+	const double inf = numeric_limits<double>::infinity();
+	minX.insert(minX.end(), padding, inf);
+	minY.insert(minY.end(), padding, inf);
+	maxX.insert(maxX.end(), padding, -inf);
+	maxY.insert(maxY.end(), padding, -inf);
+}
+
+/*private*/
+template <class Sink>
+void
+HilbertRtree::queryImpl(const Envelope& searchEnv, Sink& sink)
+{
+	build();
+	if (items.empty() || searchEnv.isNull()) return;
+
+	const double qMinX = searchEnv.getMinX();
+	const double qMinY = searchEnv.getMinY();
+	const double qMaxX = searchEnv.getMaxX();
+	const double qMaxY = searchEnv.getMaxY();
+
+	const size_t root = levelBounds.back() - 1;
+	if (qMinX > maxX[root] || qMaxX < minX[root] ||
+	    qMinY > maxY[root] || qMaxY < minY[root]) return;
+
+	const size_t groupSize = PackedSTRtree::slotGroupSize;
+
+	// (entry index, level) pairs still to be expanded
+	vector< pair<size_t, size_t> > stack;
+	stack.push_back(make_pair(root, levelBounds.size() - 1));
+
+	while (!stack.empty())
+	{
+		const size_t node = stack.back().first;
+		const size_t level = stack.back().second;
+		stack.pop_back();
+
+		const size_t below = level - 1;
+		const size_t belowStart = below == 0 ? 0 : levelBounds[below - 1];
+		const size_t thisStart = levelBounds[below];
+		const size_t start = belowStart + (node - thisStart) * nodeCapacity;
+		size_t end = start + nodeCapacity;
+		if (end > levelBounds[below]) end = levelBounds[below];
+
+		// Children are scanned in chunks; hits are pushed in reverse
+		// so that they are expanded in order.
+		const size_t mark = stack.size();
+		for (size_t first = start; first < end; first += PackedSTRtree::maxMaskSlots)
+		{
+			size_t n = end - first;
+			if (n > PackedSTRtree::maxMaskSlots) n = PackedSTRtree::maxMaskSlots;
+			size_t padded = (n + groupSize - 1) / groupSize * groupSize;
+			unsigned int hits = PackedSTRtree::overlapMask(
+					&minX[first], &minY[first], &maxX[first], &maxY[first],
+					padded, qMinX, qMinY, qMaxX, qMaxY);
+			if (n < PackedSTRtree::maxMaskSlots) hits &= (1u << n) - 1u;
+
+			for (size_t b = 0; hits; ++b, hits >>= 1)
+			{
+				if (!(hits & 1u)) continue;
+				if (below == 0) sink.add(items[first + b]);
+				else stack.push_back(make_pair(first + b, below));
+			}
+		}
+		std::reverse(stack.begin() + mark, stack.end());
+	}
+}
+
+/*public*/
+void
+HilbertRtree::query(const Envelope *searchEnv, vector<void*>& matches)
+{
+	VectorSink sink(matches);
+	queryImpl(*searchEnv, sink);
+}
+
+/*public*/
+void
+HilbertRtree::query(const Envelope *searchEnv, ItemVisitor& visitor)
+{
+	VisitorSink sink(visitor);
+	queryImpl(*searchEnv, sink);
+}
+
+/*public*/
+void
+HilbertRtree::iterate(ItemVisitor& visitor)
+{
+	for (vector<Entry>::const_iterator i = entries.begin(), e = entries.end();
+			i != e; ++i)
+	{
+		visitor.visitItem(i->item);
+	}
+}
+
+/*public*/
+const void*
+HilbertRtree::nearestNeighbour(const Envelope* env, const void* item,
+		ItemDistance* itemDist)
+{
+	vector<void*> neighbours;
+	nearestNeighbours(env, item, itemDist, 1, neighbours);
+	if (neighbours.empty()) return NULL;
+	return neighbours.front();
+}
+
+/*public*/
+void
+HilbertRtree::nearestNeighbours(const Envelope* env, const void* item,
+		ItemDistance* itemDist, size_t k, vector<void*>& neighbours)
+{
+	if (k == 0) return;
+	build();
+	if (items.empty()) return;
+
+	const double qMinX = env->getMinX();
+	const double qMinY = env->getMinY();
+	const double qMaxX = env->getMaxX();
+	const double qMaxY = env->getMaxY();
+
+	ItemBoundable queryBnd(env, const_cast<void*>(item));
+
+	// Best-first search, as in STRtree::nearestNeighbours: a node's
+	// box distance bounds the distance of every item below it, so
+	// the first k items popped are the k nearest.
+	priority_queue<Candidate, vector<Candidate>, CandidateGreater> priQ;
+	const size_t root = levelBounds.back() - 1;
+	priQ.push(Candidate(0.0, root, levelBounds.size() - 1));
+
+	size_t found = 0;
+	while (!priQ.empty() && found < k)
+	{
+		const Candidate c = priQ.top();
+		priQ.pop();
+
+		if (c.level == 0)
+		{
+			neighbours.push_back(items[c.index]);
+			++found;
+			continue;
+		}
+
+		const size_t below = c.level - 1;
+		const size_t belowStart = below == 0 ? 0 : levelBounds[below - 1];
+		const size_t start = belowStart +
+			(c.index - levelBounds[below]) * nodeCapacity;
+		size_t end = start + nodeCapacity;
+		if (end > levelBounds[below]) end = levelBounds[below];
+
+		for (size_t i = start; i < end; ++i)
+		{
+			double d;
+			if (below == 0)
+			{
+				Envelope itemEnv(minX[i], maxX[i], minY[i], maxY[i]);
+				ItemBoundable treeBnd(&itemEnv, items[i]);
+				d = itemDist->distance(&treeBnd, &queryBnd);
+			}
+			else
+			{
+				d = boxDistance(minX[i], minY[i], maxX[i], maxY[i],
+				                qMinX, qMinY, qMaxX, qMaxY);
+			}
+			priQ.push(Candidate(d, i, below));
+		}
+	}
+}
+
+} // namespace geos.index.hilbertrtree
+} // namespace geos.index
+} // namespace geos
@@ -0,0 +1,117 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/index/intervalrtree/ArrayIntervalRTree.h>
+#include <geos/index/ItemVisitor.h>
+#include <geos/util/IllegalArgumentException.h>
+#include <geos/util/IllegalStateException.h>
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+namespace geos {
+namespace index {
+namespace intervalrtree {
+
+ArrayIntervalRTree::ArrayIntervalRTree(size_t nCapacity)
+	:
+	nodeCapacity(nCapacity),
+	built(false)
+{
+	if ( nodeCapacity < 2 )
+		throw util::IllegalArgumentException("ArrayIntervalRTree: node capacity must be at least 2");
+}
+
+void
+ArrayIntervalRTree::insert(double min, double max, void * item)
+{
+	if ( built )
+		throw util::IllegalStateException("Index cannot be added to once it has been built");
+
+	mins.push_back(min);
+	maxs.push_back(max);
+	items.push_back(item);
+}
+
+void
+ArrayIntervalRTree::build()
+{
+	if ( built )
+		throw util::IllegalStateException("Index has already been built");
+	built = true;
+
+	// Sort the items by interval midpoint, as SortedPackedIntervalRTree
+	// does; ties keep insertion order
+	const size_t n = items.size();
+	vector< pair<double, size_t> > order(n);
+	for (size_t i = 0; i < n; ++i)
+		order[i] = make_pair((mins[i] + maxs[i]) / 2, i);
+	sort(order.begin(), order.end());
+
+	vector<double> sMins(n), sMaxs(n);
+	vector<void*> sItems(n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		size_t j = order[i].second;
+		sMins[i] = mins[j];
+		sMaxs[i] = maxs[j];
+		sItems[i] = items[j];
+	}
+	mins.swap(sMins);
+	maxs.swap(sMaxs);
+	items.swap(sItems);
+
+	// Pack the levels bottom-up until a single root remains
+	levelStart.push_back(0);
+	levelStart.push_back(n);
+	size_t start = 0;
+	size_t levelSize = n;
+	while ( levelSize > 1 )
+	{
+		for (size_t first = 0; first < levelSize; first += nodeCapacity)
+		{
+			size_t last = (std::min)(first + nodeCapacity, levelSize);
+			double lo = mins[start + first];
+			double hi = maxs[start + first];
+			for (size_t i = first + 1; i < last; ++i)
+			{
+				lo = (std::min)(lo, mins[start + i]);
+				hi = (std::max)(hi, maxs[start + i]);
+			}
+			mins.push_back(lo);
+			maxs.push_back(hi);
+		}
+		start += levelSize;
+		levelSize = mins.size() - start;
+		levelStart.push_back(mins.size());
+	}
+}
+
+void
+ArrayIntervalRTree::query(double min, double max, ItemVisitor * visitor) const
+{
+	query(min, max, *visitor);
+}
+
+/*private static*/
+void
+ArrayIntervalRTree::throwNotBuilt()
+{
+	throw util::IllegalStateException("Index must be built before it is queried");
+}
+
+} // geos::intervalrtree
+} // geos::index
+} // geos
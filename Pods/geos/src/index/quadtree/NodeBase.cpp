@@ -133,6 +133,39 @@ NodeBase::addAllItemsFromOverlapping(const Envelope& searchEnv,
 	}
 }
 
+void
+NodeBase::addAllItemsFromOverlapping(const vector<const Envelope*>& searchEnvs,
+                                     const vector<size_t>& queryIds,
+                                     vector<BatchQueryHit>& hits) const
+{
+	vector<size_t> matching;
+	for (vector<size_t>::const_iterator i=queryIds.begin(),
+			e=queryIds.end(); i!=e; ++i)
+	{
+		if (isSearchMatch(*searchEnvs[*i])) matching.push_back(*i);
+	}
+	if (matching.empty()) return;
+
+	for (vector<size_t>::const_iterator q=matching.begin(),
+			qe=matching.end(); q!=qe; ++q)
+	{
+		for (vector<void*>::const_iterator i=items.begin(), e=items.end();
+				i!=e; ++i)
+		{
+			hits.push_back(BatchQueryHit(*q, *i));
+		}
+	}
+
+	for(int i=0; i<4; ++i)
+	{
+		if ( subnode[i] )
+		{
+			subnode[i]->addAllItemsFromOverlapping(searchEnvs, matching,
+			                                       hits);
+		}
+	}
+}
+
 //<<TODO:RENAME?>> In Samet's terminology, I think what we're returning here is
 //actually level+1 rather than depth. (See p. 4 of his book) [Jon Aquino]
 unsigned int
@@ -38,6 +38,24 @@ namespace geos {
 namespace index { // geos.index
 namespace quadtree { // geos.index.quadtree
 
+namespace {
+
+class QuadtreeBatchQuery: public BatchQuery {
+	const Root& root;
+public:
+	QuadtreeBatchQuery(const Root& r) : root(r) {}
+
+	void queryGroup(const vector<const Envelope*>& searchEnvs,
+	                const size_t* queryIds, size_t count,
+	                vector<BatchQueryHit>& hits) const
+	{
+		vector<size_t> ids(queryIds, queryIds + count);
+		root.addAllItemsFromOverlapping(searchEnvs, ids, hits);
+	}
+};
+
+} // anonymous namespace
+
 /*public static*/
 Envelope*
 Quadtree::ensureExtent(const Envelope *itemEnv, double minExtent)
@@ -121,6 +139,15 @@ Quadtree::query(const Envelope *searchEnv,
 #endif
 }
 
+/*public*/
+void
+Quadtree::queryBatch(const vector<const Envelope*>& searchEnvs,
+	vector<BatchQueryHit>& hits, size_t numThreads)
+{
+	QuadtreeBatchQuery batch(root);
+	batch.run(searchEnvs, hits, numThreads);
+}
+
 /*public*/
 vector<void*>*
 Quadtree::queryAll()
@@ -0,0 +1,733 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/index/rstartree/RStarTree.h>
+#include <geos/index/strtree/ItemBoundable.h>
+#include <geos/index/strtree/ItemDistance.h>
+#include <geos/index/ItemVisitor.h>
+#include <geos/geom/Envelope.h>
+#include <geos/util/IllegalArgumentException.h>
+
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cassert>
+
+using namespace std;
+using namespace geos::geom;
+using geos::index::strtree::ItemBoundable;
+using geos::index::strtree::ItemDistance;
+
+namespace geos {
+namespace index { // geos.index
+namespace rstartree { // geos.index.rstartree
+
+struct RStarTree::Node {
+	/// 0 for leaves, whose entries are items
+	size_t level;
+
+	vector<Entry> entries;
+
+	Node(size_t lvl) : level(lvl) {}
+};
+
+namespace {
+
+/// Bounds of a set of entries
+struct Box {
+	double minX, minY, maxX, maxY;
+
+	Box()
+		: minX(numeric_limits<double>::infinity()),
+		  minY(numeric_limits<double>::infinity()),
+		  maxX(-numeric_limits<double>::infinity()),
+		  maxY(-numeric_limits<double>::infinity())
+	{}
+
+	template <class E>
+	void expand(const E& e)
+	{
+		if (e.minX < minX) minX = e.minX;
+		if (e.minY < minY) minY = e.minY;
+		if (e.maxX > maxX) maxX = e.maxX;
+		if (e.maxY > maxY) maxY = e.maxY;
+	}
+
+	double area() const { return (maxX - minX) * (maxY - minY); }
+
+	double margin() const { return (maxX - minX) + (maxY - minY); }
+};
+
+template <class A, class B>
+double
+overlapArea(const A& a, const B& b)
+{
+	double w = min(a.maxX, b.maxX) - max(a.minX, b.minX);
+	if (w <= 0) return 0.0;
+	double h = min(a.maxY, b.maxY) - max(a.minY, b.minY);
+	if (h <= 0) return 0.0;
+	return w * h;
+}
+
+template <class A>
+double
+area(const A& a)
+{
+	return (a.maxX - a.minX) * (a.maxY - a.minY);
+}
+
+/// Area of the union of the bounds of a and b
+template <class A, class B>
+double
+unionArea(const A& a, const B& b)
+{
+	return (max(a.maxX, b.maxX) - min(a.minX, b.minX)) *
+	       (max(a.maxY, b.maxY) - min(a.minY, b.minY));
+}
+
+template <class E>
+bool
+intersects(const E& e, double minX, double minY, double maxX, double maxY)
+{
+	return !(minX > e.maxX || maxX < e.minX || minY > e.maxY || maxY < e.minY);
+}
+
+template <class E>
+double
+boxDistance(const E& e, const Envelope& env)
+{
+	double dx = 0.0;
+	if (e.maxX < env.getMinX()) dx = env.getMinX() - e.maxX;
+	else if (env.getMaxX() < e.minX) dx = e.minX - env.getMaxX();
+
+	double dy = 0.0;
+	if (e.maxY < env.getMinY()) dy = env.getMinY() - e.maxY;
+	else if (env.getMaxY() < e.minY) dy = e.minY - env.getMaxY();
+
+	if (dx == 0.0) return dy;
+	if (dy == 0.0) return dx;
+	return sqrt(dx * dx + dy * dy);
+}
+
+// Sort keys for the split
+template <class E> bool lessMinX(const E& a, const E& b)
+{ return a.minX < b.minX || (a.minX == b.minX && a.maxX < b.maxX); }
+template <class E> bool lessMaxX(const E& a, const E& b)
+{ return a.maxX < b.maxX || (a.maxX == b.maxX && a.minX < b.minX); }
+template <class E> bool lessMinY(const E& a, const E& b)
+{ return a.minY < b.minY || (a.minY == b.minY && a.maxY < b.maxY); }
+template <class E> bool lessMaxY(const E& a, const E& b)
+{ return a.maxY < b.maxY || (a.maxY == b.maxY && a.minY < b.minY); }
+
+/// Bounds of s[0..k) in head[k-1], of s[k..n) in tail[k]
+template <class E>
+void
+prefixBounds(const vector<E>& s, vector<Box>& head, vector<Box>& tail)
+{
+	const size_t n = s.size();
+	Box b;
+	for (size_t i = 0; i < n; ++i) { b.expand(s[i]); head[i] = b; }
+	b = Box();
+	for (size_t i = n; i > 0; --i) { b.expand(s[i - 1]); tail[i - 1] = b; }
+}
+
+/// Entry index keyed by squared distance from a node centre
+typedef pair<double, size_t> DistanceKey;
+
+/// An entry of the nearest-neighbour search queue
+struct Candidate {
+	double distance;
+	const void* node;
+	void* item;
+};
+
+/// Closest candidate on top; nodes before items at equal distance
+struct CandidateGreater {
+	bool operator()(const Candidate& a, const Candidate& b) const
+	{
+		if (a.distance != b.distance) return a.distance > b.distance;
+		return a.node == NULL && b.node != NULL;
+	}
+};
+
+class VisitorSink {
+	ItemVisitor& visitor;
+public:
+	VisitorSink(ItemVisitor& v) : visitor(v) {}
+	void add(void* item) { visitor.visitItem(item); }
+};
+
+class VectorSink {
+	vector<void*>& matches;
+public:
+	VectorSink(vector<void*>& m) : matches(m) {}
+	void add(void* item) { matches.push_back(item); }
+};
+
+} // anonymous namespace
+
+RStarTree::RStarTree(size_t newMaxEntries)
+	:
+	maxEntries(newMaxEntries),
+	minEntries(newMaxEntries * 2 / 5),
+	reinsertCount(newMaxEntries * 3 / 10),
+	numItems(0),
+	root(0)
+{
+	if (maxEntries < 4)
+		throw util::IllegalArgumentException(
+			"RStarTree needs at least 4 entries per node");
+	if (minEntries < 2) minEntries = 2;
+	if (reinsertCount < 1) reinsertCount = 1;
+	root = new Node(0);
+}
+
+RStarTree::~RStarTree()
+{
+	deleteTree(root);
+}
+
+/*private static*/
+void
+RStarTree::deleteTree(Node* node)
+{
+	if (node->level > 0)
+	{
+		for (vector<Entry>::iterator i = node->entries.begin(),
+				e = node->entries.end(); i != e; ++i)
+		{
+			deleteTree(i->child);
+		}
+	}
+	delete node;
+}
+
+/*private static*/
+void
+RStarTree::setBounds(Entry& e, const Node* node)
+{
+	Box b;
+	for (vector<Entry>::const_iterator i = node->entries.begin(),
+			end = node->entries.end(); i != end; ++i)
+	{
+		b.expand(*i);
+	}
+	e.minX = b.minX;
+	e.minY = b.minY;
+	e.maxX = b.maxX;
+	e.maxY = b.maxY;
+}
+
+/*public*/
+size_t
+RStarTree::depth() const
+{
+	return root->level + 1;
+}
+
+/*public*/
+void
+RStarTree::insert(const Envelope *itemEnv, void* item)
+{
+	if (itemEnv->isNull()) return;
+
+	Entry e;
+	e.minX = itemEnv->getMinX();
+	e.minY = itemEnv->getMinY();
+	e.maxX = itemEnv->getMaxX();
+	e.maxY = itemEnv->getMaxY();
+	e.child = NULL;
+	e.item = item;
+
+	insertEntry(e, 0);
+	++numItems;
+}
+
+/*private*/
+void
+RStarTree::insertEntry(const Entry& e, size_t level)
+{
+	// Forced reinsertion happens at most once per level for each
+	// entry inserted by the caller, reinsertions included
+	vector<bool> reinserted(root->level + 1, false);
+	vector<PendingEntry> pending;
+	pending.push_back(PendingEntry(e, level));
+
+	for (size_t p = 0; p < pending.size(); ++p)
+	{
+		const PendingEntry next = pending[p];
+		if (reinserted.size() < root->level + 1)
+			reinserted.resize(root->level + 1, false);
+
+		Node* sibling = insertRecursive(root, next.first, next.second,
+				reinserted, pending);
+		if (sibling)
+		{
+			// grow a new root
+			Node* newRoot = new Node(root->level + 1);
+			Entry a, b;
+			a.child = root;
+			a.item = NULL;
+			setBounds(a, root);
+			b.child = sibling;
+			b.item = NULL;
+			setBounds(b, sibling);
+			newRoot->entries.reserve(maxEntries + 1);
+			newRoot->entries.push_back(a);
+			newRoot->entries.push_back(b);
+			root = newRoot;
+		}
+	}
+}
+
+/*private*/
+RStarTree::Node*
+RStarTree::insertRecursive(Node* node, const Entry& e, size_t level,
+		vector<bool>& reinserted, vector<PendingEntry>& pending)
+{
+	if (node->level == level)
+	{
+		if (node->entries.empty()) node->entries.reserve(maxEntries + 1);
+		node->entries.push_back(e);
+	}
+	else
+	{
+		size_t i = chooseSubtree(node, e);
+		Node* child = node->entries[i].child;
+		Node* sibling = insertRecursive(child, e, level, reinserted, pending);
+
+		// the child may have lost entries to reinsertion, so
+		// its bounds are recomputed rather than enlarged
+		setBounds(node->entries[i], child);
+		if (sibling)
+		{
+			Entry s;
+			s.child = sibling;
+			s.item = NULL;
+			setBounds(s, sibling);
+			node->entries.push_back(s);
+		}
+	}
+
+	if (node->entries.size() > maxEntries)
+		return overflow(node, reinserted, pending);
+	return NULL;
+}
+
+/*private*/
+size_t
+RStarTree::chooseSubtree(const Node* node, const Entry& e) const
+{
+	const vector<Entry>& entries = node->entries;
+	const size_t n = entries.size();
+	assert(n > 0);
+
+	size_t best = 0;
+	double bestOverlap = numeric_limits<double>::infinity();
+	double bestEnlargement = numeric_limits<double>::infinity();
+	double bestArea = numeric_limits<double>::infinity();
+
+	const bool aboveLeaves = node->level == 1;
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		const Entry& c = entries[i];
+		double a = area(c);
+		double enlargement = unionArea(c, e) - a;
+
+		double overlap = 0.0;
+		if (aboveLeaves)
+		{
+			// overlap enlargement of c with its siblings
+			Box grown;
+			grown.expand(c);
+			grown.expand(e);
+			for (size_t j = 0; j < n; ++j)
+			{
+				if (j == i) continue;
+				overlap += overlapArea(grown, entries[j]) -
+				           overlapArea(c, entries[j]);
+			}
+		}
+
+		if (overlap < bestOverlap ||
+		    (overlap == bestOverlap && (enlargement < bestEnlargement ||
+		     (enlargement == bestEnlargement && a < bestArea))))
+		{
+			best = i;
+			bestOverlap = overlap;
+			bestEnlargement = enlargement;
+			bestArea = a;
+		}
+	}
+	return best;
+}
+
+/*private*/
+RStarTree::Node*
+RStarTree::overflow(Node* node, vector<bool>& reinserted,
+		vector<PendingEntry>& pending)
+{
+	if (node != root && !reinserted[node->level])
+	{
+		reinserted[node->level] = true;
+		reinsertFarthest(node, pending);
+		return NULL;
+	}
+	return split(node);
+}
+
+/*private*/
+void
+RStarTree::reinsertFarthest(Node* node, vector<PendingEntry>& pending)
+{
+	vector<Entry>& entries = node->entries;
+	Box b;
+	for (size_t i = 0, n = entries.size(); i < n; ++i) b.expand(entries[i]);
+	const double cx = (b.minX + b.maxX) / 2.0;
+	const double cy = (b.minY + b.maxY) / 2.0;
+
+	vector<DistanceKey> keys(entries.size());
+	for (size_t i = 0, n = entries.size(); i < n; ++i)
+	{
+		const Entry& c = entries[i];
+		double dx = (c.minX + c.maxX) / 2.0 - cx;
+		double dy = (c.minY + c.maxY) / 2.0 - cy;
+		keys[i] = DistanceKey(dx * dx + dy * dy, i);
+	}
+	sort(keys.begin(), keys.end());
+
+	// The farthest entries go; they are reinserted closest first
+	const size_t keep = entries.size() - reinsertCount;
+	vector<Entry> kept;
+	kept.reserve(maxEntries + 1);
+	for (size_t i = 0; i < keep; ++i) kept.push_back(entries[keys[i].second]);
+	for (size_t i = keep, n = keys.size(); i < n; ++i)
+		pending.push_back(PendingEntry(entries[keys[i].second], node->level));
+	entries.swap(kept);
+}
+
+/*private*/
+RStarTree::Node*
+RStarTree::split(Node* node)
+{
+	vector<Entry>& entries = node->entries;
+	const size_t n = entries.size();
+	const size_t first = minEntries;
+	const size_t last = n - minEntries; // largest first group
+
+	typedef bool (*EntryLess)(const Entry&, const Entry&);
+	EntryLess sorts[2][2] = {
+		{ lessMinX<Entry>, lessMaxX<Entry> },
+		{ lessMinY<Entry>, lessMaxY<Entry> }
+	};
+
+	vector<Entry> sorted(entries);
+	vector<Box> head(n), tail(n);
+
+	// Choose the axis with the least total margin
+	size_t bestAxis = 0;
+	double bestMargin = numeric_limits<double>::infinity();
+	for (size_t axis = 0; axis < 2; ++axis)
+	{
+		double margin = 0.0;
+		for (size_t s = 0; s < 2; ++s)
+		{
+			stable_sort(sorted.begin(), sorted.end(), sorts[axis][s]);
+			prefixBounds(sorted, head, tail);
+			for (size_t k = first; k <= last; ++k)
+				margin += head[k - 1].margin() + tail[k].margin();
+		}
+		if (margin < bestMargin)
+		{
+			bestMargin = margin;
+			bestAxis = axis;
+		}
+	}
+
+	// On that axis, choose the distribution with the least overlap
+	size_t bestSort = 0, bestK = first;
+	double bestOverlap = numeric_limits<double>::infinity();
+	double bestArea = numeric_limits<double>::infinity();
+	for (size_t s = 0; s < 2; ++s)
+	{
+		sorted = entries;
+		stable_sort(sorted.begin(), sorted.end(), sorts[bestAxis][s]);
+		prefixBounds(sorted, head, tail);
+		for (size_t k = first; k <= last; ++k)
+		{
+			double overlap = overlapArea(head[k - 1], tail[k]);
+			double a = head[k - 1].area() + tail[k].area();
+			if (overlap < bestOverlap ||
+			    (overlap == bestOverlap && a < bestArea))
+			{
+				bestOverlap = overlap;
+				bestArea = a;
+				bestSort = s;
+				bestK = k;
+			}
+		}
+	}
+
+	sorted = entries;
+	stable_sort(sorted.begin(), sorted.end(), sorts[bestAxis][bestSort]);
+
+	Node* sibling = new Node(node->level);
+	sibling->entries.reserve(maxEntries + 1);
+	sibling->entries.assign(sorted.begin() + bestK, sorted.end());
+	entries.assign(sorted.begin(), sorted.begin() + bestK);
+	return sibling;
+}
+
+/*public*/
+bool
+RStarTree::remove(const Envelope *itemEnv, void* item)
+{
+	if (itemEnv->isNull()) return false;
+
+	vector<PendingEntry> orphans;
+	if (!removeRecursive(root, *itemEnv, item, orphans)) return false;
+	--numItems;
+
+	// shorten the tree while the root has a single child
+	while (root->level > 0 && root->entries.size() == 1)
+	{
+		Node* child = root->entries.front().child;
+		delete root;
+		root = child;
+	}
+	assert(root->level == 0 || !root->entries.empty());
+
+	for (vector<PendingEntry>::iterator i = orphans.begin(),
+			e = orphans.end(); i != e; ++i)
+	{
+		if (i->second <= root->level)
+		{
+			insertEntry(i->first, i->second);
+		}
+		else
+		{
+			// the tree is now too shallow for this subtree
+			vector<Entry> items;
+			collectItems(i->first.child, items);
+			for (size_t j = 0, n = items.size(); j < n; ++j)
+				insertEntry(items[j], 0);
+		}
+	}
+	return true;
+}
+
+/*private*/
+bool
+RStarTree::removeRecursive(Node* node, const Envelope& env, void* item,
+		vector<PendingEntry>& orphans)
+{
+	vector<Entry>& entries = node->entries;
+	const double qMinX = env.getMinX(), qMinY = env.getMinY();
+	const double qMaxX = env.getMaxX(), qMaxY = env.getMaxY();
+
+	for (size_t i = 0, n = entries.size(); i < n; ++i)
+	{
+		Entry& e = entries[i];
+		if (!intersects(e, qMinX, qMinY, qMaxX, qMaxY)) continue;
+
+		if (node->level == 0)
+		{
+			if (e.item != item) continue;
+			entries.erase(entries.begin() + i);
+			return true;
+		}
+
+		Node* child = e.child;
+		if (!removeRecursive(child, env, item, orphans)) continue;
+
+		if (child->entries.size() < minEntries)
+		{
+			// dissolve the child; its entries go back in at its level
+			for (vector<Entry>::iterator c = child->entries.begin(),
+					ce = child->entries.end(); c != ce; ++c)
+			{
+				orphans.push_back(PendingEntry(*c, child->level));
+			}
+			delete child;
+			entries.erase(entries.begin() + i);
+		}
+		else
+		{
+			setBounds(e, child);
+		}
+		return true;
+	}
+	return false;
+}
+
+/*private static*/
+void
+RStarTree::collectItems(Node* node, vector<Entry>& items)
+{
+	if (node->level == 0)
+	{
+		items.insert(items.end(), node->entries.begin(), node->entries.end());
+	}
+	else
+	{
+		for (vector<Entry>::iterator i = node->entries.begin(),
+				e = node->entries.end(); i != e; ++i)
+		{
+			collectItems(i->child, items);
+		}
+	}
+	delete node;
+}
+
+/*private*/
+template <class Sink>
+void
+RStarTree::queryImpl(const Envelope& searchEnv, Sink& sink)
+{
+	if (searchEnv.isNull()) return;
+	const double qMinX = searchEnv.getMinX(), qMinY = searchEnv.getMinY();
+	const double qMaxX = searchEnv.getMaxX(), qMaxY = searchEnv.getMaxY();
+
+	vector<const Node*> stack;
+	stack.push_back(root);
+	while (!stack.empty())
+	{
+		const Node* node = stack.back();
+		stack.pop_back();
+		const vector<Entry>& entries = node->entries;
+		if (node->level == 0)
+		{
+			for (size_t i = 0, n = entries.size(); i < n; ++i)
+				if (intersects(entries[i], qMinX, qMinY, qMaxX, qMaxY))
+					sink.add(entries[i].item);
+		}
+		else
+		{
+			// push in reverse so that children are visited in order
+			for (size_t i = entries.size(); i > 0; --i)
+				if (intersects(entries[i - 1], qMinX, qMinY, qMaxX, qMaxY))
+					stack.push_back(entries[i - 1].child);
+		}
+	}
+}
+
+/*public*/
+void
+RStarTree::query(const Envelope *searchEnv, vector<void*>& matches)
+{
+	VectorSink sink(matches);
+	queryImpl(*searchEnv, sink);
+}
+
+/*public*/
+void
+RStarTree::query(const Envelope *searchEnv, ItemVisitor& visitor)
+{
+	VisitorSink sink(visitor);
+	queryImpl(*searchEnv, sink);
+}
+
+/*public*/
+void
+RStarTree::iterate(ItemVisitor& visitor)
+{
+	vector<const Node*> stack;
+	stack.push_back(root);
+	while (!stack.empty())
+	{
+		const Node* node = stack.back();
+		stack.pop_back();
+		const vector<Entry>& entries = node->entries;
+		if (node->level == 0)
+		{
+			for (size_t i = 0, n = entries.size(); i < n; ++i)
+				visitor.visitItem(entries[i].item);
+		}
+		else
+		{
+			for (size_t i = entries.size(); i > 0; --i)
+				stack.push_back(entries[i - 1].child);
+		}
+	}
+}
+
+/*public*/
+const void*
+RStarTree::nearestNeighbour(const Envelope* env, const void* item,
+		ItemDistance* itemDist)
+{
+	vector<void*> neighbours;
+	nearestNeighbours(env, item, itemDist, 1, neighbours);
+	if (neighbours.empty()) return NULL;
+	return neighbours.front();
+}
+
+/*public*/
+void
+RStarTree::nearestNeighbours(const Envelope* env, const void* item,
+		ItemDistance* itemDist, size_t k, vector<void*>& neighbours)
+{
+	if (k == 0 || numItems == 0) return;
+
+	ItemBoundable queryBnd(env, const_cast<void*>(item));
+
+	// Best-first search, as in STRtree::nearestNeighbours
+	priority_queue<Candidate, vector<Candidate>, CandidateGreater> priQ;
+	Candidate start;
+	start.distance = 0.0;
+	start.node = root;
+	start.item = NULL;
+	priQ.push(start);
+
+	size_t found = 0;
+	while (!priQ.empty() && found < k)
+	{
+		const Candidate c = priQ.top();
+		priQ.pop();
+
+		if (c.node == NULL)
+		{
+			neighbours.push_back(c.item);
+			++found;
+			continue;
+		}
+
+		const Node* node = static_cast<const Node*>(c.node);
+		for (vector<Entry>::const_iterator i = node->entries.begin(),
+				e = node->entries.end(); i != e; ++i)
+		{
+			Candidate next;
+			if (node->level == 0)
+			{
+				Envelope itemEnv(i->minX, i->maxX, i->minY, i->maxY);
+				ItemBoundable treeBnd(&itemEnv, i->item);
+				next.distance = itemDist->distance(&treeBnd, &queryBnd);
+				next.node = NULL;
+				next.item = i->item;
+			}
+			else
+			{
+				next.distance = boxDistance(*i, *env);
+				next.node = i->child;
+				next.item = NULL;
+			}
+			priQ.push(next);
+		}
+	}
+}
+
+} // namespace geos.index.rstartree
+} // namespace geos.index
+} // namespace geos
@@ -55,7 +55,7 @@ AbstractSTRtree::~AbstractSTRtree()
 void
 AbstractSTRtree::build()
 {
-	assert(!built);
+	if (built) return;
 	root=(itemBoundables->empty()?createNode(0):createHigherLevels(itemBoundables,-1));
 	built=true;
 }
@@ -66,17 +66,24 @@ AbstractSTRtree::createParentBoundables(BoundableList* childBoundables,
 		int newLevel)
 {
 	assert(!childBoundables->empty());
+	std::auto_ptr< BoundableList > sortedChildBoundables ( sortBoundables(childBoundables) );
+	return createParentBoundablesFromSorted(*sortedChildBoundables, newLevel);
+}
+
+/*protected*/
+std::auto_ptr<BoundableList>
+AbstractSTRtree::createParentBoundablesFromSorted(
+		const BoundableList& sortedChildBoundables, int newLevel)
+{
+	assert(!sortedChildBoundables.empty());
 	std::auto_ptr< BoundableList > parentBoundables ( new BoundableList() );
 	parentBoundables->push_back(createNode(newLevel));
 
-	std::auto_ptr< BoundableList > sortedChildBoundables ( sortBoundables(childBoundables) );
-
-	for (BoundableList::iterator i=sortedChildBoundables->begin(),
-			e=sortedChildBoundables->end();
+	for (BoundableList::const_iterator i=sortedChildBoundables.begin(),
+			e=sortedChildBoundables.end();
 			i!=e; i++)
-	//for(std::size_t i=0, scbsize=sortedChildBoundables->size(); i<scbsize; ++i)
 	{
-		Boundable *childBoundable=*i; // (*sortedChildBoundables)[i];
+		Boundable *childBoundable=*i;
 
 		AbstractNode *last = lastNode(parentBoundables.get());
 		if (last->getChildBoundables()->size() == nodeCapacity)
@@ -0,0 +1,164 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: index/strtree/BoundablePair.java (JTS-1.13)
+ *
+ **********************************************************************/
+
+#include <geos/index/strtree/BoundablePair.h>
+#include <geos/index/strtree/AbstractNode.h>
+#include <geos/index/strtree/ItemBoundable.h>
+#include <geos/index/strtree/ItemDistance.h>
+#include <geos/geom/Envelope.h>
+#include <geos/util/IllegalArgumentException.h>
+
+#include <cassert>
+
+using namespace geos::geom;
+
+namespace geos {
+namespace index { // geos.index
+namespace strtree { // geos.index.strtree
+
+BoundablePair::BoundablePair(const Boundable* newBoundable1,
+                             const Boundable* newBoundable2,
+                             ItemDistance* newItemDistance)
+	:
+	boundable1(newBoundable1),
+	boundable2(newBoundable2),
+	itemDistance(newItemDistance)
+{
+	mDistance = distance();
+}
+
+const Boundable*
+BoundablePair::getBoundable(int i) const
+{
+	if (i == 0) return boundable1;
+	return boundable2;
+}
+
+/*private*/
+double
+BoundablePair::distance()
+{
+	// if items, compute exact distance
+	if (isLeaves())
+	{
+		return itemDistance->distance(
+				static_cast<const ItemBoundable*>(boundable1),
+				static_cast<const ItemBoundable*>(boundable2));
+	}
+
+	// otherwise compute distance between bounds of boundables
+	const Envelope* e1 = static_cast<const Envelope*>(boundable1->getBounds());
+	const Envelope* e2 = static_cast<const Envelope*>(boundable2->getBounds());
+	assert(e1);
+	assert(e2);
+	return e1->distance(e2);
+}
+
+double
+BoundablePair::getDistance() const
+{
+	return mDistance;
+}
+
+bool
+BoundablePair::isLeaves() const
+{
+	return !(isComposite(boundable1) || isComposite(boundable2));
+}
+
+/*public static*/
+bool
+BoundablePair::isComposite(const Boundable* item)
+{
+	return dynamic_cast<const AbstractNode*>(item) != NULL;
+}
+
+/*public static*/
+double
+BoundablePair::area(const Boundable* b)
+{
+	return static_cast<const Envelope*>(b->getBounds())->getArea();
+}
+
+void
+BoundablePair::expandToQueue(BoundablePairQueue& priQ, double minDistance)
+{
+	bool isComp1 = isComposite(boundable1);
+	bool isComp2 = isComposite(boundable2);
+
+	/**
+	 * HEURISTIC: If both boundables are composite,
+	 * choose the one with largest area to expand.
+	 * Otherwise, simply expand whichever is composite.
+	 */
+	if (isComp1 && isComp2)
+	{
+		if (area(boundable1) > area(boundable2))
+		{
+			expand(boundable1, boundable2, false, priQ, minDistance);
+			return;
+		}
+		expand(boundable2, boundable1, true, priQ, minDistance);
+		return;
+	}
+	else if (isComp1)
+	{
+		expand(boundable1, boundable2, false, priQ, minDistance);
+		return;
+	}
+	else if (isComp2)
+	{
+		expand(boundable2, boundable1, true, priQ, minDistance);
+		return;
+	}
+
+	throw util::IllegalArgumentException("neither boundable is composite");
+}
+
+/*private*/
+void
+BoundablePair::expand(const Boundable* bndComposite, const Boundable* bndOther,
+                      bool isFlipped, BoundablePairQueue& priQ,
+                      double minDistance)
+{
+	const std::vector<Boundable*>* children =
+		static_cast<const AbstractNode*>(bndComposite)->getChildBoundables();
+
+	for (std::vector<Boundable*>::const_iterator it = children->begin(),
+			itEnd = children->end(); it != itEnd; ++it)
+	{
+		const Boundable* child = *it;
+		// keep members in their original order, so that
+		// item pairs reported to the caller are not swapped
+		BoundablePair* bp = isFlipped ?
+			new BoundablePair(bndOther, child, itemDistance) :
+			new BoundablePair(child, bndOther, itemDistance);
+
+		// only add to queue if this pair might contain the closest points
+		if (bp->getDistance() < minDistance)
+		{
+			priQ.push(bp);
+		}
+		else
+		{
+			delete bp;
+		}
+	}
+}
+
+} // namespace geos.index.strtree
+} // namespace geos.index
+} // namespace geos
@@ -0,0 +1,699 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/index/strtree/PackedSTRtree.h>
+#include <geos/index/strtree/AbstractNode.h>
+#include <geos/index/strtree/ItemBoundable.h>
+#include <geos/index/ItemVisitor.h>
+#include <geos/index/ItemPairVisitor.h>
+#include <geos/geom/Envelope.h>
+#include <geos/util/ParallelFor.h>
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#if defined(__AVX__)
+# include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# include <emmintrin.h>
+# define GEOS_PACKEDSTRTREE_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+# include <arm_neon.h>
+# define GEOS_PACKEDSTRTREE_NEON 1
+#endif
+
+using namespace std;
+using namespace geos::geom;
+
+namespace geos {
+namespace index { // geos.index
+namespace strtree { // geos.index.strtree
+
+namespace {
+
+class VisitorSink {
+	ItemVisitor& visitor;
+public:
+	VisitorSink(ItemVisitor& v) : visitor(v) {}
+	void add(void* item) { visitor.visitItem(item); }
+};
+
+class VectorSink {
+	vector<void*>& matches;
+public:
+	VectorSink(vector<void*>& m) : matches(m) {}
+	void add(void* item) { matches.push_back(item); }
+};
+
+/// A node reached by a batch of queries, see queryBatch
+struct BatchFrame {
+	size_t node;
+	size_t first;
+};
+
+class PairVisitorSink {
+	ItemPairVisitor& visitor;
+public:
+	PairVisitorSink(ItemPairVisitor& v) : visitor(v) {}
+	void add(void* item1, void* item2) { visitor.visitItemPair(item1, item2); }
+};
+
+class PairVectorSink {
+	vector< pair<void*, void*> >& pairs;
+public:
+	PairVectorSink(vector< pair<void*, void*> >& p) : pairs(p) {}
+	void add(void* item1, void* item2) { pairs.push_back(make_pair(item1, item2)); }
+};
+
+} // anonymous namespace
+
+struct PackedSTRtree::JoinFrame {
+	size_t a;
+	size_t b;
+	double aMinX, aMinY, aMaxX, aMaxY;
+	double bMinX, bMinY, bMaxX, bMaxY;
+};
+
+class PackedSTRtree::JoinTask: public util::ParallelTask {
+public:
+	JoinTask(const PackedSTRtree& t1, const PackedSTRtree& t2,
+	         const vector<JoinFrame>& f,
+	         vector< vector< pair<void*, void*> > >& out)
+		: tree(t1), other(t2), frames(f), pairs(out)
+	{}
+
+	void run(size_t i)
+	{
+		PairVectorSink sink(pairs[i]);
+		tree.joinFrom(other, frames[i], sink);
+	}
+
+private:
+	const PackedSTRtree& tree;
+	const PackedSTRtree& other;
+	const vector<JoinFrame>& frames;
+	vector< vector< pair<void*, void*> > >& pairs;
+};
+
+const std::size_t PackedSTRtree::slotGroupSize;
+const std::size_t PackedSTRtree::maxMaskSlots;
+const std::size_t PackedSTRtree::joinSplitSize;
+
+PackedSTRtree::PackedSTRtree()
+	:
+	rootMinX(0), rootMinY(0), rootMaxX(-1), rootMaxY(-1)
+{
+}
+
+/*public*/
+void
+PackedSTRtree::clear()
+{
+	nodes.clear();
+	minX.clear();
+	minY.clear();
+	maxX.clear();
+	maxY.clear();
+	childRef.clear();
+	items.clear();
+	rootMinX = rootMinY = 0;
+	rootMaxX = rootMaxY = -1;
+}
+
+/*public*/
+void
+PackedSTRtree::build(const AbstractNode& root)
+{
+	clear();
+
+	const Envelope* rootEnv = static_cast<const Envelope*>(root.getBounds());
+	if ( ! rootEnv ) return; // empty tree
+
+	rootMinX = rootEnv->getMinX();
+	rootMinY = rootEnv->getMinY();
+	rootMaxX = rootEnv->getMaxX();
+	rootMaxY = rootEnv->getMaxY();
+
+	// Breadth-first walk; the queue of pointer nodes is kept
+	// parallel to the packed node array.
+	vector<const AbstractNode*> level;
+	level.push_back(&root);
+
+	for (size_t n = 0; n < level.size(); ++n)
+	{
+		const vector<Boundable*>& children = *(level[n]->getChildBoundables());
+
+		Node node;
+		node.childStart = childRef.size();
+		node.childCount = 0;
+		node.isLeaf = children.empty() ||
+			dynamic_cast<const ItemBoundable*>(children.front()) != NULL;
+
+		for (vector<Boundable*>::const_iterator i = children.begin(),
+				e = children.end(); i != e; ++i)
+		{
+			const Boundable* child = *i;
+			const Envelope* env = static_cast<const Envelope*>(child->getBounds());
+			if ( ! env ) continue; // pruned subtree
+
+			if ( node.isLeaf )
+			{
+				const ItemBoundable* ib = dynamic_cast<const ItemBoundable*>(child);
+				assert(ib); // STR nodes hold either items or nodes
+				childRef.push_back(items.size());
+				items.push_back(ib->getItem());
+			}
+			else
+			{
+				const AbstractNode* an = dynamic_cast<const AbstractNode*>(child);
+				assert(an); // STR nodes hold either items or nodes
+				childRef.push_back(level.size());
+				level.push_back(an);
+			}
+			minX.push_back(env->getMinX());
+			minY.push_back(env->getMinY());
+			maxX.push_back(env->getMaxX());
+			maxY.push_back(env->getMaxY());
+			++node.childCount;
+		}
+
+		// Pad the run to whole slot groups. Padding slots are
+		// never reported (see slotMask), their bounds only need
+		// to be readable.
+		const double inf = numeric_limits<double>::infinity();
+		while ( childRef.size() % slotGroupSize )
+		{
+			childRef.push_back(0);
+			minX.push_back(inf);
+			minY.push_back(inf);
+			maxX.push_back(-inf);
+			maxY.push_back(-inf);
+		}
+		nodes.push_back(node);
+	}
+}
+
+/*public*/
+bool
+PackedSTRtree::remove(const Envelope& itemEnv, void* item)
+{
+	if ( items.empty() || itemEnv.isNull() ) return false;
+
+	const double qMinX = itemEnv.getMinX();
+	const double qMinY = itemEnv.getMinY();
+	const double qMaxX = itemEnv.getMaxX();
+	const double qMaxY = itemEnv.getMaxY();
+
+	if ( qMinX > rootMaxX || qMaxX < rootMinX ||
+	     qMinY > rootMaxY || qMaxY < rootMinY ) return false;
+
+	// Walk as AbstractSTRtree::remove() does, so that the same slot
+	// goes when an item was inserted more than once
+	vector<size_t> stack;
+	stack.push_back(0);
+
+	while ( ! stack.empty() )
+	{
+		const Node& node = nodes[stack.back()];
+		stack.pop_back();
+
+		const size_t start = node.childStart;
+		const size_t end = start + node.childCount;
+
+		if ( node.isLeaf )
+		{
+			// The last slot holding item, whatever its bounds;
+			// removed slots have inverted bounds
+			size_t found = end;
+			for (size_t s = start; s < end; ++s)
+			{
+				if ( items[childRef[s]] == item && minX[s] <= maxX[s] )
+					found = s;
+			}
+			if ( found == end ) continue;
+
+			// Bounds of padding slots, which nothing intersects
+			const double inf = numeric_limits<double>::infinity();
+			minX[found] = minY[found] = inf;
+			maxX[found] = maxY[found] = -inf;
+			return true;
+		}
+
+		// Pushed last first, so that children are searched in order
+		for (size_t s = end; s > start; --s)
+		{
+			const size_t c = s - 1;
+			if ( qMinX > maxX[c] || qMaxX < minX[c] ||
+			     qMinY > maxY[c] || qMaxY < minY[c] ) continue;
+			stack.push_back(childRef[c]);
+		}
+	}
+	return false;
+}
+
+/*public static*/
+unsigned int
+PackedSTRtree::overlapMask(const double* bMinX, const double* bMinY,
+                           const double* bMaxX, const double* bMaxY,
+                           size_t count,
+                           double qMinX, double qMinY,
+                           double qMaxX, double qMaxY)
+{
+	assert(count <= maxMaskSlots);
+
+	// A slot is missed if the query lies entirely on one side
+	// of it; the comparisons are ordered, as in Envelope::intersects
+	unsigned int mask = 0;
+	size_t i = 0;
+
+#if defined(__AVX__)
+	const __m256d q0 = _mm256_set1_pd(qMinX);
+	const __m256d q1 = _mm256_set1_pd(qMaxX);
+	const __m256d q2 = _mm256_set1_pd(qMinY);
+	const __m256d q3 = _mm256_set1_pd(qMaxY);
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256d miss = _mm256_or_pd(
+			_mm256_or_pd(
+				_mm256_cmp_pd(q0, _mm256_loadu_pd(bMaxX + i), _CMP_GT_OQ),
+				_mm256_cmp_pd(q1, _mm256_loadu_pd(bMinX + i), _CMP_LT_OQ)),
+			_mm256_or_pd(
+				_mm256_cmp_pd(q2, _mm256_loadu_pd(bMaxY + i), _CMP_GT_OQ),
+				_mm256_cmp_pd(q3, _mm256_loadu_pd(bMinY + i), _CMP_LT_OQ)));
+		unsigned int hit = ~static_cast<unsigned int>(_mm256_movemask_pd(miss)) & 0xFu;
+		mask |= hit << i;
+	}
+#elif defined(GEOS_PACKEDSTRTREE_SSE2)
+	const __m128d q0 = _mm_set1_pd(qMinX);
+	const __m128d q1 = _mm_set1_pd(qMaxX);
+	const __m128d q2 = _mm_set1_pd(qMinY);
+	const __m128d q3 = _mm_set1_pd(qMaxY);
+	for (; i + 2 <= count; i += 2)
+	{
+		__m128d miss = _mm_or_pd(
+			_mm_or_pd(
+				_mm_cmpgt_pd(q0, _mm_loadu_pd(bMaxX + i)),
+				_mm_cmplt_pd(q1, _mm_loadu_pd(bMinX + i))),
+			_mm_or_pd(
+				_mm_cmpgt_pd(q2, _mm_loadu_pd(bMaxY + i)),
+				_mm_cmplt_pd(q3, _mm_loadu_pd(bMinY + i))));
+		unsigned int hit = ~static_cast<unsigned int>(_mm_movemask_pd(miss)) & 0x3u;
+		mask |= hit << i;
+	}
+#elif defined(GEOS_PACKEDSTRTREE_NEON)
+	const float64x2_t q0 = vdupq_n_f64(qMinX);
+	const float64x2_t q1 = vdupq_n_f64(qMaxX);
+	const float64x2_t q2 = vdupq_n_f64(qMinY);
+	const float64x2_t q3 = vdupq_n_f64(qMaxY);
+	for (; i + 2 <= count; i += 2)
+	{
+		uint64x2_t miss = vorrq_u64(
+			vorrq_u64(
+				vcgtq_f64(q0, vld1q_f64(bMaxX + i)),
+				vcltq_f64(q1, vld1q_f64(bMinX + i))),
+			vorrq_u64(
+				vcgtq_f64(q2, vld1q_f64(bMaxY + i)),
+				vcltq_f64(q3, vld1q_f64(bMinY + i))));
+		unsigned int hit = (vgetq_lane_u64(miss, 0) ? 0u : 1u) |
+		                   (vgetq_lane_u64(miss, 1) ? 0u : 2u);
+		mask |= hit << i;
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		if ( !(qMinX > bMaxX[i] || qMaxX < bMinX[i] ||
+		       qMinY > bMaxY[i] || qMaxY < bMinY[i]) )
+		{
+			mask |= 1u << i;
+		}
+	}
+	return mask;
+}
+
+/*private*/
+unsigned int
+PackedSTRtree::slotMask(size_t first, size_t count,
+                        double qMinX, double qMinY,
+                        double qMaxX, double qMaxY) const
+{
+	// Runs are padded, so rounding up stays within the node
+	size_t padded = (count + slotGroupSize - 1) / slotGroupSize * slotGroupSize;
+	unsigned int mask = overlapMask(&minX[first], &minY[first],
+	                                &maxX[first], &maxY[first], padded,
+	                                qMinX, qMinY, qMaxX, qMaxY);
+	if ( count < maxMaskSlots ) mask &= (1u << count) - 1u;
+	return mask;
+}
+
+/*private*/
+template <class Sink>
+void
+PackedSTRtree::queryImpl(const Envelope& searchEnv, Sink& sink) const
+{
+	if ( items.empty() || searchEnv.isNull() ) return;
+
+	const double qMinX = searchEnv.getMinX();
+	const double qMinY = searchEnv.getMinY();
+	const double qMaxX = searchEnv.getMaxX();
+	const double qMaxY = searchEnv.getMaxY();
+
+	if ( qMinX > rootMaxX || qMaxX < rootMinX ||
+	     qMinY > rootMaxY || qMaxY < rootMinY ) return;
+
+	vector<size_t> stack;
+	stack.push_back(0);
+
+	while ( ! stack.empty() )
+	{
+		const Node& node = nodes[stack.back()];
+		stack.pop_back();
+
+		if ( node.childCount == 0 ) continue;
+
+		const size_t start = node.childStart;
+		const size_t end = start + node.childCount;
+
+		if ( node.isLeaf )
+		{
+			for (size_t first = start; first < end; first += maxMaskSlots)
+			{
+				size_t n = end - first;
+				if ( n > maxMaskSlots ) n = maxMaskSlots;
+				unsigned int hits = slotMask(first, n,
+						qMinX, qMinY, qMaxX, qMaxY);
+				for (size_t b = 0; hits; ++b, hits >>= 1)
+				{
+					if ( hits & 1u ) sink.add(items[childRef[first + b]]);
+				}
+			}
+		}
+		else
+		{
+			// push in reverse so that children are visited
+			// in their original order
+			size_t last = start + (node.childCount - 1) / maxMaskSlots * maxMaskSlots;
+			for (size_t first = last + maxMaskSlots; first > start; )
+			{
+				first -= maxMaskSlots;
+				size_t n = end - first;
+				if ( n > maxMaskSlots ) n = maxMaskSlots;
+				unsigned int hits = slotMask(first, n,
+						qMinX, qMinY, qMaxX, qMaxY);
+				for (size_t b = n; b > 0; --b)
+				{
+					if ( (hits >> (b - 1)) & 1u )
+						stack.push_back(childRef[first + b - 1]);
+				}
+			}
+		}
+	}
+}
+
+/*public*/
+void
+PackedSTRtree::query(const Envelope& searchEnv, ItemVisitor& visitor) const
+{
+	VisitorSink sink(visitor);
+	queryImpl(searchEnv, sink);
+}
+
+/*public*/
+void
+PackedSTRtree::query(const Envelope& searchEnv, vector<void*>& matches) const
+{
+	VectorSink sink(matches);
+	queryImpl(searchEnv, sink);
+}
+
+/*public*/
+void
+PackedSTRtree::queryBatch(const vector<const Envelope*>& searchEnvs,
+                          const size_t* queryIds, size_t count,
+                          vector< pair<size_t, void*> >& hits) const
+{
+	if ( items.empty() ) return;
+
+	// Queries which reach the root
+	vector<size_t> active;
+	for (size_t i = 0; i < count; ++i)
+	{
+		const Envelope* e = searchEnvs[queryIds[i]];
+		if ( ! e || e->isNull() ) continue;
+		if ( e->getMinX() > rootMaxX || e->getMaxX() < rootMinX ||
+		     e->getMinY() > rootMaxY || e->getMaxY() < rootMinY ) continue;
+		active.push_back(queryIds[i]);
+	}
+	if ( active.empty() ) return;
+
+	// Each stack entry is a node and the range of active holding
+	// the queries that reach it. Entries are popped in reverse order
+	// of their ranges, so active is used as a stack too.
+	vector<BatchFrame> stack;
+	BatchFrame root = { 0, 0 };
+	stack.push_back(root);
+
+	vector<size_t> queries;
+	vector<unsigned int> masks;
+
+	while ( ! stack.empty() )
+	{
+		const BatchFrame frame = stack.back();
+		stack.pop_back();
+		queries.assign(active.begin() + frame.first, active.end());
+		active.resize(frame.first);
+
+		const Node& node = nodes[frame.node];
+		if ( node.childCount == 0 ) continue;
+
+		const size_t start = node.childStart;
+		const size_t end = start + node.childCount;
+		const size_t numQueries = queries.size();
+		masks.resize(numQueries);
+
+		if ( node.isLeaf )
+		{
+			for (size_t first = start; first < end; first += maxMaskSlots)
+			{
+				size_t n = end - first;
+				if ( n > maxMaskSlots ) n = maxMaskSlots;
+				unsigned int any = 0;
+				for (size_t q = 0; q < numQueries; ++q)
+				{
+					const Envelope* e = searchEnvs[queries[q]];
+					masks[q] = slotMask(first, n, e->getMinX(), e->getMinY(),
+					                    e->getMaxX(), e->getMaxY());
+					any |= masks[q];
+				}
+				for (size_t b = 0; any; ++b, any >>= 1)
+				{
+					if ( ! (any & 1u) ) continue;
+					void* item = items[childRef[first + b]];
+					for (size_t q = 0; q < numQueries; ++q)
+					{
+						if ( (masks[q] >> b) & 1u )
+							hits.push_back(make_pair(queries[q], item));
+					}
+				}
+			}
+		}
+		else
+		{
+			// push in reverse so that children are visited
+			// in their original order
+			size_t last = start + (node.childCount - 1) / maxMaskSlots * maxMaskSlots;
+			for (size_t first = last + maxMaskSlots; first > start; )
+			{
+				first -= maxMaskSlots;
+				size_t n = end - first;
+				if ( n > maxMaskSlots ) n = maxMaskSlots;
+				for (size_t q = 0; q < numQueries; ++q)
+				{
+					const Envelope* e = searchEnvs[queries[q]];
+					masks[q] = slotMask(first, n, e->getMinX(), e->getMinY(),
+					                    e->getMaxX(), e->getMaxY());
+				}
+				for (size_t b = n; b > 0; --b)
+				{
+					BatchFrame child = { childRef[first + b - 1], active.size() };
+					for (size_t q = 0; q < numQueries; ++q)
+					{
+						if ( (masks[q] >> (b - 1)) & 1u )
+							active.push_back(queries[q]);
+					}
+					if ( active.size() > child.first ) stack.push_back(child);
+				}
+			}
+		}
+	}
+}
+
+/*private*/
+template <class Sink>
+void
+PackedSTRtree::joinStep(const PackedSTRtree& other, const JoinFrame& f,
+                        vector<JoinFrame>& next, Sink& sink) const
+{
+	const Node& na = nodes[f.a];
+	const Node& nb = other.nodes[f.b];
+	if ( na.childCount == 0 || nb.childCount == 0 ) return;
+
+	const size_t aStart = na.childStart;
+	const size_t aEnd = aStart + na.childCount;
+	const size_t bStart = nb.childStart;
+	const size_t bEnd = bStart + nb.childCount;
+
+	// Trees of different heights: descend the taller one only
+	if ( nb.isLeaf && ! na.isLeaf )
+	{
+		for (size_t first = aStart; first < aEnd; first += maxMaskSlots)
+		{
+			size_t n = min(aEnd - first, maxMaskSlots);
+			unsigned int hits = slotMask(first, n,
+					f.bMinX, f.bMinY, f.bMaxX, f.bMaxY);
+			for (size_t i = first; hits; ++i, hits >>= 1)
+			{
+				if ( ! (hits & 1u) ) continue;
+				JoinFrame c = { childRef[i], f.b,
+				                minX[i], minY[i], maxX[i], maxY[i],
+				                f.bMinX, f.bMinY, f.bMaxX, f.bMaxY };
+				next.push_back(c);
+			}
+		}
+		return;
+	}
+	if ( na.isLeaf && ! nb.isLeaf )
+	{
+		for (size_t first = bStart; first < bEnd; first += maxMaskSlots)
+		{
+			size_t n = min(bEnd - first, maxMaskSlots);
+			unsigned int hits = other.slotMask(first, n,
+					f.aMinX, f.aMinY, f.aMaxX, f.aMaxY);
+			for (size_t j = first; hits; ++j, hits >>= 1)
+			{
+				if ( ! (hits & 1u) ) continue;
+				JoinFrame c = { f.a, other.childRef[j],
+				                f.aMinX, f.aMinY, f.aMaxX, f.aMaxY,
+				                other.minX[j], other.minY[j],
+				                other.maxX[j], other.maxY[j] };
+				next.push_back(c);
+			}
+		}
+		return;
+	}
+
+	// Pair the children of a which intersect b with the children
+	// of b which intersect them
+	const bool leaves = na.isLeaf;
+	for (size_t first = aStart; first < aEnd; first += maxMaskSlots)
+	{
+		size_t n = min(aEnd - first, maxMaskSlots);
+		unsigned int aHits = slotMask(first, n,
+				f.bMinX, f.bMinY, f.bMaxX, f.bMaxY);
+		for (size_t i = first; aHits; ++i, aHits >>= 1)
+		{
+			if ( ! (aHits & 1u) ) continue;
+			for (size_t bFirst = bStart; bFirst < bEnd; bFirst += maxMaskSlots)
+			{
+				size_t m = min(bEnd - bFirst, maxMaskSlots);
+				unsigned int bHits = other.slotMask(bFirst, m,
+						minX[i], minY[i], maxX[i], maxY[i]);
+				for (size_t j = bFirst; bHits; ++j, bHits >>= 1)
+				{
+					if ( ! (bHits & 1u) ) continue;
+					if ( leaves )
+					{
+						sink.add(items[childRef[i]],
+						         other.items[other.childRef[j]]);
+						continue;
+					}
+					JoinFrame c = { childRef[i], other.childRef[j],
+					                minX[i], minY[i], maxX[i], maxY[i],
+					                other.minX[j], other.minY[j],
+					                other.maxX[j], other.maxY[j] };
+					next.push_back(c);
+				}
+			}
+		}
+	}
+}
+
+/*private*/
+template <class Sink>
+void
+PackedSTRtree::joinFrom(const PackedSTRtree& other, const JoinFrame& frame,
+                        Sink& sink) const
+{
+	vector<JoinFrame> stack;
+	stack.push_back(frame);
+	while ( ! stack.empty() )
+	{
+		const JoinFrame f = stack.back();
+		stack.pop_back();
+		size_t mark = stack.size();
+		joinStep(other, f, stack, sink);
+		// children are popped in the order joinStep found them
+		reverse(stack.begin() + mark, stack.end());
+	}
+}
+
+/*public*/
+void
+PackedSTRtree::join(const PackedSTRtree& other, ItemPairVisitor& visitor,
+                    size_t numThreads) const
+{
+	if ( items.empty() || other.items.empty() ) return;
+	if ( rootMinX > other.rootMaxX || rootMaxX < other.rootMinX ||
+	     rootMinY > other.rootMaxY || rootMaxY < other.rootMinY ) return;
+
+	JoinFrame root = { 0, 0,
+	                   rootMinX, rootMinY, rootMaxX, rootMaxY,
+	                   other.rootMinX, other.rootMinY,
+	                   other.rootMaxX, other.rootMaxY };
+	PairVisitorSink sink(visitor);
+
+	// The split does not depend on numThreads, so neither does
+	// the order pairs are reported in
+	vector<JoinFrame> frontier(1, root);
+	vector<JoinFrame> next;
+	while ( ! frontier.empty() && frontier.size() < joinSplitSize )
+	{
+		next.clear();
+		for (size_t i = 0, n = frontier.size(); i < n; ++i)
+			joinStep(other, frontier[i], next, sink);
+		frontier.swap(next);
+	}
+
+	if ( numThreads <= 1 || frontier.size() < 2 )
+	{
+		for (size_t i = 0, n = frontier.size(); i < n; ++i)
+			joinFrom(other, frontier[i], sink);
+		return;
+	}
+
+	vector< vector< pair<void*, void*> > > pairs(frontier.size());
+	JoinTask task(*this, other, frontier, pairs);
+	util::parallelFor(frontier.size(), numThreads, task);
+
+	for (size_t i = 0, n = pairs.size(); i < n; ++i)
+	{
+		const vector< pair<void*, void*> >& p = pairs[i];
+		for (size_t k = 0, m = p.size(); k < m; ++k)
+			visitor.visitItemPair(p[k].first, p[k].second);
+	}
+}
+
+} // namespace geos.index.strtree
+} // namespace geos.index
+} // namespace geos
@@ -18,7 +18,10 @@
  **********************************************************************/
 
 #include <geos/index/strtree/STRtree.h>
+#include <geos/index/strtree/BoundablePair.h>
+#include <geos/index/strtree/ItemBoundable.h>
 #include <geos/geom/Envelope.h>
+#include <geos/util/ParallelFor.h>
 
 #include <vector>
 #include <cassert>
@@ -87,8 +90,104 @@ static bool yComparator(Boundable *a, Boundable *b)
                                            STRtree::centreY(bEnv));
 }
 
+namespace {
+
+typedef bool (*BoundableComparator)(Boundable*, Boundable*);
+
+/// Stable-sorts each of a set of lists independently
+class SortListsTask: public util::ParallelTask {
+	vector<BoundableList*>& lists;
+	BoundableComparator comp;
+public:
+	SortListsTask(vector<BoundableList*>& l, BoundableComparator c)
+		: lists(l), comp(c) {}
+	void run(size_t i) {
+		stable_sort(lists[i]->begin(), lists[i]->end(), comp);
+	}
+};
+
+/// Stable-sorts equal chunks of a list independently
+class SortChunksTask: public util::ParallelTask {
+	BoundableList& list;
+	size_t chunkSize;
+	BoundableComparator comp;
+public:
+	SortChunksTask(BoundableList& l, size_t cs, BoundableComparator c)
+		: list(l), chunkSize(cs), comp(c) {}
+	void run(size_t i) {
+		size_t b = i * chunkSize;
+		size_t e = std::min(b + chunkSize, list.size());
+		stable_sort(list.begin() + b, list.begin() + e, comp);
+	}
+};
+
+/// Merges pairs of adjacent sorted runs of the given width
+class MergeRunsTask: public util::ParallelTask {
+	BoundableList& list;
+	size_t runSize;
+	BoundableComparator comp;
+public:
+	MergeRunsTask(BoundableList& l, size_t rs, BoundableComparator c)
+		: list(l), runSize(rs), comp(c) {}
+	void run(size_t i) {
+		size_t b = i * 2 * runSize;
+		size_t m = std::min(b + runSize, list.size());
+		size_t e = std::min(b + 2 * runSize, list.size());
+		inplace_merge(list.begin() + b, list.begin() + m,
+		              list.begin() + e, comp);
+	}
+};
+
+/**
+ * Stable sort, in parallel. Sorted chunks are merged pairwise;
+ * as stable sorting and merging are deterministic, the result
+ * is the same as a serial stable_sort.
+ */
+void
+parallelStableSort(BoundableList& list, BoundableComparator comp,
+		size_t numThreads)
+{
+	size_t n = list.size();
+	if ( numThreads <= 1 || n < 2 * numThreads )
+	{
+		stable_sort(list.begin(), list.end(), comp);
+		return;
+	}
+
+	size_t chunkSize = (n + numThreads - 1) / numThreads;
+	SortChunksTask sortTask(list, chunkSize, comp);
+	util::parallelFor(numThreads, numThreads, sortTask);
+
+	for (size_t runSize = chunkSize; runSize < n; runSize *= 2)
+	{
+		size_t pairs = (n + 2 * runSize - 1) / (2 * runSize);
+		MergeRunsTask mergeTask(list, runSize, comp);
+		util::parallelFor(pairs, numThreads, mergeTask);
+	}
+}
+
+/// Runs groups of a batch query against the packed tree
+class PackedBatchQuery: public BatchQuery {
+	const PackedSTRtree& packed;
+public:
+	PackedBatchQuery(const PackedSTRtree& p) : packed(p) {}
+	void queryGroup(const vector<const Envelope*>& searchEnvs,
+	                const size_t* queryIds, size_t count,
+	                vector<BatchQueryHit>& hits) const
+	{
+		packed.queryBatch(searchEnvs, queryIds, count, hits);
+	}
+};
+
+} // anonymous namespace
+
 /*public*/
-STRtree::STRtree(size_t nodeCapacity): AbstractSTRtree(nodeCapacity)
+STRtree::STRtree(size_t nodeCapacity, size_t nBuildThreads)
+	:
+	AbstractSTRtree(nodeCapacity),
+	packedValid(false),
+	packedHasRemovals(false),
+	buildThreads(nBuildThreads)
 { 
 }
 
@@ -133,6 +232,12 @@ std::auto_ptr<BoundableList>
 STRtree::createParentBoundablesFromVerticalSlices(std::vector<BoundableList*>* verticalSlices, int newLevel)
 {
 	assert(!verticalSlices->empty());
+
+	// Sorting is the expensive part and slices are independent;
+	// node creation below stays serial, in slice order.
+	SortListsTask sortTask(*verticalSlices, yComparator);
+	util::parallelFor(verticalSlices->size(), buildThreads, sortTask);
+
 	std::auto_ptr<BoundableList> parentBoundables( new BoundableList() );
 
 	for (size_t i=0, vssize=verticalSlices->size(); i<vssize; ++i)
@@ -155,7 +260,8 @@ STRtree::createParentBoundablesFromVerticalSlices(std::vector<BoundableList*>* v
 std::auto_ptr<BoundableList>
 STRtree::createParentBoundablesFromVerticalSlice(BoundableList* childBoundables, int newLevel)
 {
-	return AbstractSTRtree::createParentBoundables(childBoundables, newLevel);
+	// sorted already by createParentBoundablesFromVerticalSlices
+	return AbstractSTRtree::createParentBoundablesFromSorted(*childBoundables, newLevel);
 }
 
 /*private*/
@@ -236,6 +342,121 @@ STRtree::insert(const Envelope *itemEnv, void* item)
 	AbstractSTRtree::insert(itemEnv, item);
 }
 
+/*public*/
+void
+STRtree::build()
+{
+	AbstractSTRtree::build();
+	if (packedValid && !packedHasRemovals) return;
+	packed.build(*root);
+	packedValid = true;
+	packedHasRemovals = false;
+}
+
+/*public*/
+bool
+STRtree::remove(const Envelope *itemEnv, void* item)
+{
+	bool removed = AbstractSTRtree::remove(itemEnv, item);
+	if (!removed || !packedValid) return removed;
+
+	// Patched in place rather than packed again on the next query
+	if (packed.remove(*itemEnv, item)) packedHasRemovals = true;
+	else packedValid = false;
+	return removed;
+}
+
+/*public*/
+void
+STRtree::queryBatch(const vector<const Envelope*>& searchEnvs,
+		vector<BatchQueryHit>& hits, size_t numThreads)
+{
+	if (!packedValid) build();
+	PackedBatchQuery batch(packed);
+	batch.run(searchEnvs, hits, numThreads);
+}
+
+/*public*/
+void
+STRtree::join(STRtree& other, ItemPairVisitor& visitor, size_t numThreads)
+{
+	if (!packedValid) build();
+	if (!other.packedValid) other.build();
+	packed.join(other.packed, visitor, numThreads);
+}
+
+/*public*/
+const void*
+STRtree::nearestNeighbour(const Envelope* env, const void* item,
+		ItemDistance* itemDist)
+{
+	vector<void*> neighbours;
+	nearestNeighbours(env, item, itemDist, 1, neighbours);
+	if (neighbours.empty()) return NULL;
+	return neighbours.front();
+}
+
+/*public*/
+void
+STRtree::nearestNeighbours(const Envelope* env, const void* item,
+		ItemDistance* itemDist, size_t k, vector<void*>& neighbours)
+{
+	if (k == 0) return;
+
+	AbstractNode* r = getRoot();
+	if (r->getBounds() == NULL) return; // empty tree
+
+	ItemBoundable bnd(env, const_cast<void*>(item));
+	nearestNeighbours(new BoundablePair(r, &bnd, itemDist), k, neighbours);
+}
+
+/*private*/
+void
+STRtree::nearestNeighbours(BoundablePair* initBndPair, size_t k,
+		vector<void*>& neighbours)
+{
+	// Pairs come off the queue in order of increasing distance, and
+	// a pair's distance is a lower bound on the distance of any leaf
+	// pair it expands to. So the first k leaf pairs popped are the
+	// k nearest, and nothing farther than the queue head is expanded.
+	BoundablePair::BoundablePairQueue priQ;
+	priQ.push(initBndPair);
+
+	size_t found = 0;
+	try {
+		while (!priQ.empty() && found < k)
+		{
+			BoundablePair* bndPair = priQ.top();
+			priQ.pop();
+
+			if (bndPair->isLeaves())
+			{
+				const ItemBoundable* ib = static_cast<const ItemBoundable*>(
+						bndPair->getBoundable(0));
+				neighbours.push_back(ib->getItem());
+				++found;
+			}
+			else
+			{
+				try {
+					bndPair->expandToQueue(priQ,
+						numeric_limits<double>::infinity());
+				} catch (...) {
+					delete bndPair;
+					throw;
+				}
+			}
+			delete bndPair;
+		}
+	} catch (...) {
+		while (!priQ.empty()) { delete priQ.top(); priQ.pop(); }
+		throw;
+	}
+
+	// Free any remaining BoundablePairs in the queue
+	while (!priQ.empty()) { delete priQ.top(); priQ.pop(); }
+}
+
 /*private*/
 std::auto_ptr<BoundableList>
 STRtree::sortBoundables(const BoundableList* input)
@@ -244,7 +465,7 @@ STRtree::sortBoundables(const BoundableList* input)
 	std::auto_ptr<BoundableList> output ( new BoundableList(*input) );
 	assert(output->size() == input->size());
 
-	sort(output->begin(), output->end(), yComparator);
+	parallelStableSort(*output, yComparator, buildThreads);
 	return output;
 }
 
@@ -0,0 +1,382 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/index/strtree/STRtreeSnapshot.h>
+#include <geos/index/strtree/PackedSTRtree.h>
+#include <geos/geom/Envelope.h>
+#include <geos/util/GEOSException.h>
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include <fstream>
+#include <cstring>
+
+#if ! defined(_WIN32)
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <fcntl.h>
+# include <unistd.h>
+#endif
+
+using namespace std;
+using namespace geos::geom;
+
+namespace geos {
+namespace index { // geos.index
+namespace strtree { // geos.index.strtree
+
+namespace {
+
+const char magic[8] = { 'G', 'E', 'O', 'S', 'S', 'T', 'R', 'S' };
+
+// Read back in the wrong byte order if the image comes from a host
+// of the other endianness
+const int64 formatVersion = 1;
+
+// Magic, version, node, slot and item counts, root bounds
+const size_t headerWords = 9;
+
+const size_t nodeWords = 3;
+
+// Four bounds and a reference
+const size_t slotWords = 5;
+
+// Identifier and slot
+const size_t itemWords = 2;
+
+void
+writeWords(ostream& os, const void* words, size_t count)
+{
+	os.write(static_cast<const char*>(words),
+	         static_cast<streamsize>(count * sizeof(int64)));
+}
+
+void
+corrupt()
+{
+	throw util::GEOSException("STRtreeSnapshot: corrupt image");
+}
+
+} // anonymous namespace
+
+/*public static*/
+void
+STRtreeSnapshot::write(const PackedSTRtree& tree, ItemIdentifier& ids,
+                       ostream& os)
+{
+	const size_t nNodes = tree.nodes.size();
+	const size_t nSlots = tree.childRef.size();
+	const size_t nItems = tree.items.size();
+
+	int64 header[headerWords];
+	memcpy(&header[0], magic, sizeof(magic));
+	header[1] = formatVersion;
+	header[2] = static_cast<int64>(nNodes);
+	header[3] = static_cast<int64>(nSlots);
+	header[4] = static_cast<int64>(nItems);
+	double root[4] = { tree.rootMinX, tree.rootMinY,
+	                   tree.rootMaxX, tree.rootMaxY };
+	memcpy(&header[5], root, sizeof(root));
+	writeWords(os, header, headerWords);
+
+	vector<int64> words;
+	words.reserve(nNodes * nodeWords);
+	vector<int64> itemSlots(nItems, 0);
+	for (size_t i = 0; i < nNodes; ++i)
+	{
+		const PackedSTRtree::Node& node = tree.nodes[i];
+		words.push_back(static_cast<int64>(node.childStart));
+		words.push_back(static_cast<int64>(node.childCount));
+		words.push_back(node.isLeaf ? 1 : 0);
+		if ( ! node.isLeaf ) continue;
+		for (size_t s = node.childStart, e = s + node.childCount; s < e; ++s)
+			itemSlots[tree.childRef[s]] = static_cast<int64>(s);
+	}
+	if ( nNodes ) writeWords(os, &words[0], words.size());
+
+	if ( nSlots )
+	{
+		writeWords(os, &tree.minX[0], nSlots);
+		writeWords(os, &tree.minY[0], nSlots);
+		writeWords(os, &tree.maxX[0], nSlots);
+		writeWords(os, &tree.maxY[0], nSlots);
+		words.assign(tree.childRef.begin(), tree.childRef.end());
+		writeWords(os, &words[0], nSlots);
+	}
+
+	if ( nItems )
+	{
+		words.resize(nItems);
+		for (size_t i = 0; i < nItems; ++i)
+			words[i] = ids.getId(tree.items[i]);
+		writeWords(os, &words[0], nItems);
+		writeWords(os, &itemSlots[0], nItems);
+	}
+
+	if ( ! os ) throw util::GEOSException("STRtreeSnapshot: write failed");
+}
+
+/*public static*/
+auto_ptr<STRtreeSnapshot>
+STRtreeSnapshot::open(const string& filename)
+{
+	auto_ptr<STRtreeSnapshot> snapshot(new STRtreeSnapshot());
+
+#if ! defined(_WIN32)
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if ( fd < 0 )
+		throw util::GEOSException("STRtreeSnapshot: cannot open " + filename);
+	struct stat st;
+	if ( fstat(fd, &st) != 0 || st.st_size <= 0 )
+	{
+		::close(fd);
+		throw util::GEOSException("STRtreeSnapshot: cannot read " + filename);
+	}
+	size_t size = static_cast<size_t>(st.st_size);
+	void* addr = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd); // the mapping keeps the file open
+	if ( addr == MAP_FAILED )
+		throw util::GEOSException("STRtreeSnapshot: cannot map " + filename);
+	snapshot->mapping = addr;
+	snapshot->mappingSize = size;
+	snapshot->attach(addr, size);
+#else
+	ifstream is(filename.c_str(), ios::in | ios::binary);
+	if ( ! is )
+		throw util::GEOSException("STRtreeSnapshot: cannot open " + filename);
+	is.seekg(0, ios::end);
+	streamoff end = is.tellg();
+	is.seekg(0, ios::beg);
+	if ( end <= 0 || end % sizeof(int64) ) corrupt();
+	size_t size = static_cast<size_t>(end);
+	snapshot->buffer.resize(size / sizeof(int64));
+	if ( ! is.read(reinterpret_cast<char*>(&snapshot->buffer[0]),
+	               static_cast<streamsize>(size)) )
+		throw util::GEOSException("STRtreeSnapshot: cannot read " + filename);
+	snapshot->attach(&snapshot->buffer[0], size);
+#endif
+
+	return snapshot;
+}
+
+/*private*/
+STRtreeSnapshot::STRtreeSnapshot()
+	:
+	numNodes(0), numSlots(0), numItems(0),
+	rootMinX(0), rootMinY(0), rootMaxX(-1), rootMaxY(-1),
+	nodes(0), minX(0), minY(0), maxX(0), maxY(0),
+	childRef(0), itemIds(0), itemSlots(0),
+	mapping(0), mappingSize(0)
+{
+}
+
+/*public*/
+STRtreeSnapshot::STRtreeSnapshot(const void* data, size_t size)
+	:
+	numNodes(0), numSlots(0), numItems(0),
+	rootMinX(0), rootMinY(0), rootMaxX(-1), rootMaxY(-1),
+	nodes(0), minX(0), minY(0), maxX(0), maxY(0),
+	childRef(0), itemIds(0), itemSlots(0),
+	mapping(0), mappingSize(0)
+{
+	attach(data, size);
+}
+
+STRtreeSnapshot::~STRtreeSnapshot()
+{
+	release();
+}
+
+/*private*/
+void
+STRtreeSnapshot::release()
+{
+#if ! defined(_WIN32)
+	if ( mapping ) munmap(mapping, mappingSize);
+#endif
+	mapping = 0;
+	mappingSize = 0;
+}
+
+/*private*/
+void
+STRtreeSnapshot::attach(const void* data, size_t size)
+{
+	// Auto-pointer of open() releases the mapping on failure
+	if ( reinterpret_cast<size_t>(data) % sizeof(int64) ||
+	     size % sizeof(int64) || size < headerWords * sizeof(int64) )
+		corrupt();
+
+	const int64* words = static_cast<const int64*>(data);
+	if ( memcmp(words, magic, sizeof(magic)) != 0 ) corrupt();
+	if ( words[1] != formatVersion )
+		throw util::GEOSException("STRtreeSnapshot: unsupported version or byte order");
+
+	// Counts are bounded by the size first, so the total cannot wrap
+	const size_t bodyWords = size / sizeof(int64) - headerWords;
+	for (size_t i = 2; i < 5; ++i)
+		if ( words[i] < 0 || static_cast<size_t>(words[i]) > bodyWords ) corrupt();
+	numNodes = static_cast<size_t>(words[2]);
+	numSlots = static_cast<size_t>(words[3]);
+	numItems = static_cast<size_t>(words[4]);
+	if ( numNodes * nodeWords + numSlots * slotWords +
+	     numItems * itemWords != bodyWords ) corrupt();
+	if ( numSlots % PackedSTRtree::slotGroupSize ) corrupt();
+	if ( numItems && ! numNodes ) corrupt();
+
+	double root[4];
+	memcpy(root, &words[5], sizeof(root));
+	rootMinX = root[0];
+	rootMinY = root[1];
+	rootMaxX = root[2];
+	rootMaxY = root[3];
+
+	const int64* p = words + headerWords;
+	nodes = p;
+	p += numNodes * nodeWords;
+	minX = reinterpret_cast<const double*>(p);
+	p += numSlots;
+	minY = reinterpret_cast<const double*>(p);
+	p += numSlots;
+	maxX = reinterpret_cast<const double*>(p);
+	p += numSlots;
+	maxY = reinterpret_cast<const double*>(p);
+	p += numSlots;
+	childRef = p;
+	p += numSlots;
+	itemIds = p;
+	p += numItems;
+	itemSlots = p;
+}
+
+/*public*/
+int64
+STRtreeSnapshot::getItemId(size_t i) const
+{
+	if ( i >= numItems )
+		throw util::GEOSException("STRtreeSnapshot: item index out of range");
+	return itemIds[i];
+}
+
+/*public*/
+void
+STRtreeSnapshot::getItemEnvelope(size_t i, Envelope& env) const
+{
+	if ( i >= numItems )
+		throw util::GEOSException("STRtreeSnapshot: item index out of range");
+	int64 s = itemSlots[i];
+	if ( s < 0 || static_cast<size_t>(s) >= numSlots ) corrupt();
+	env.init(minX[s], maxX[s], minY[s], maxY[s]);
+}
+
+/*private*/
+unsigned int
+STRtreeSnapshot::slotMask(size_t first, size_t count,
+                          double qMinX, double qMinY,
+                          double qMaxX, double qMaxY) const
+{
+	const size_t groupSize = PackedSTRtree::slotGroupSize;
+	size_t padded = (count + groupSize - 1) / groupSize * groupSize;
+	unsigned int mask = PackedSTRtree::overlapMask(minX + first, minY + first,
+	                                               maxX + first, maxY + first,
+	                                               padded,
+	                                               qMinX, qMinY, qMaxX, qMaxY);
+	if ( count < PackedSTRtree::maxMaskSlots ) mask &= (1u << count) - 1u;
+	return mask;
+}
+
+/*public*/
+void
+STRtreeSnapshot::query(const Envelope& searchEnv, vector<int64>& ids) const
+{
+	if ( ! numItems || searchEnv.isNull() ) return;
+
+	const double qMinX = searchEnv.getMinX();
+	const double qMinY = searchEnv.getMinY();
+	const double qMaxX = searchEnv.getMaxX();
+	const double qMaxY = searchEnv.getMaxY();
+
+	if ( qMinX > rootMaxX || qMaxX < rootMinX ||
+	     qMinY > rootMaxY || qMaxY < rootMinY ) return;
+
+	const size_t maxMaskSlots = PackedSTRtree::maxMaskSlots;
+	const size_t groupSize = PackedSTRtree::slotGroupSize;
+
+	// Same walk as PackedSTRtree::query(), with the references
+	// checked: children must follow their parent in level order,
+	// which also rules out cycles
+	vector<size_t> stack;
+	stack.push_back(0);
+
+	while ( ! stack.empty() )
+	{
+		const size_t n = stack.back();
+		stack.pop_back();
+
+		const int64* node = nodes + n * nodeWords;
+		if ( node[0] < 0 || node[1] < 0 ||
+		     static_cast<size_t>(node[0]) > numSlots ||
+		     static_cast<size_t>(node[1]) > numSlots ) corrupt();
+		const size_t start = static_cast<size_t>(node[0]);
+		const size_t count = static_cast<size_t>(node[1]);
+		if ( count == 0 ) continue;
+		if ( (count + groupSize - 1) / groupSize * groupSize > numSlots - start )
+			corrupt();
+		const size_t end = start + count;
+
+		if ( node[2] )
+		{
+			for (size_t first = start; first < end; first += maxMaskSlots)
+			{
+				size_t m = end - first;
+				if ( m > maxMaskSlots ) m = maxMaskSlots;
+				unsigned int hits = slotMask(first, m,
+						qMinX, qMinY, qMaxX, qMaxY);
+				for (size_t b = 0; hits; ++b, hits >>= 1)
+				{
+					if ( ! (hits & 1u) ) continue;
+					int64 item = childRef[first + b];
+					if ( item < 0 || static_cast<size_t>(item) >= numItems )
+						corrupt();
+					ids.push_back(itemIds[item]);
+				}
+			}
+		}
+		else
+		{
+			// push in reverse so that children are visited
+			// in their original order
+			size_t last = start + (count - 1) / maxMaskSlots * maxMaskSlots;
+			for (size_t first = last + maxMaskSlots; first > start; )
+			{
+				first -= maxMaskSlots;
+				size_t m = end - first;
+				if ( m > maxMaskSlots ) m = maxMaskSlots;
+				unsigned int hits = slotMask(first, m,
+						qMinX, qMinY, qMaxX, qMaxY);
+				for (size_t b = m; b > 0; --b)
+				{
+					if ( ! ((hits >> (b - 1)) & 1u) ) continue;
+					int64 child = childRef[first + b - 1];
+					if ( child <= static_cast<int64>(n) ||
+					     static_cast<size_t>(child) >= numNodes ) corrupt();
+					stack.push_back(static_cast<size_t>(child));
+				}
+			}
+		}
+	}
+}
+
+} // namespace geos.index.strtree
+} // namespace geos.index
+} // namespace geos
@@ -0,0 +1,718 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Decimal to double conversion follows W. D. Clinger, "How to Read
+ * Floating Point Numbers Accurately" (PLDI 1990): exact floating
+ * point arithmetic when the digits and the power of ten fit in a
+ * double, and otherwise an approximation corrected by comparing it
+ * with the decimal value in integer arithmetic (his AlgorithmR).
+ *
+ * Double to shortest decimal conversion is Grisu2 from F. Loitsch,
+ * "Printing Floating-Point Numbers Quickly and Accurately with
+ * Integers" (PLDI 2010).
+ *
+ **********************************************************************/
+
+#include <geos/io/DoubleConversion.h>
+#include <geos/platform.h> // for int64, DoubleInfinity, DoubleNotANumber
+
+#include <vector>
+#include <cstring> // for memcpy
+#include <cmath> // for frexp, ldexp
+#include <cfloat> // for DBL_MAX, FLT_EVAL_METHOD
+#include <cstddef>
+
+namespace geos {
+namespace io { // geos.io
+
+namespace {
+
+// Digits past this many can only decide ties, see "sticky" below
+const int MAX_DIGITS = 800;
+
+// The powers of ten which are exact as doubles
+const double POW10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+const int MAX_EXACT_POW10 = 22;
+
+const unsigned int POW10_INT[] = {
+	1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+	1000000000
+};
+
+const int64 MAX_EXACT_INT = static_cast<int64>(1) << 53;
+
+// x87 rounds to extended precision first, which breaks the exact path
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 1 || FLT_EVAL_METHOD == 2)
+const bool EXACT_DOUBLE_ARITHMETIC = false;
+#else
+const bool EXACT_DOUBLE_ARITHMETIC = true;
+#endif
+
+inline bool
+isDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+// True if [p, end) is word, ignoring the case of ASCII letters
+bool
+matchWord(const char *p, const char *end, const char *word)
+{
+	for ( ; *word; ++p, ++word)
+	{
+		if ( p == end ) return false;
+		char c = *p;
+		if ( c >= 'A' && c <= 'Z' ) c += 'a' - 'A';
+		if ( c != *word ) return false;
+	}
+	return p == end;
+}
+
+/*
+ * Unsigned integer of any size, with the few operations the
+ * exact comparisons need
+ */
+class BigInt {
+
+public:
+
+	explicit BigInt(int64 v)
+	{
+		for ( ; v > 0; v >>= 32)
+			limbs.push_back(static_cast<unsigned int>(v & 0xffffffff));
+	}
+
+	// this = this * m + a, m <= 10^9
+	void mulAdd(unsigned int m, unsigned int a)
+	{
+		int64 carry = a;
+		for (std::size_t i=0, n=limbs.size(); i<n; ++i)
+		{
+			int64 t = static_cast<int64>(limbs[i]) * m + carry;
+			limbs[i] = static_cast<unsigned int>(t & 0xffffffff);
+			carry = t >> 32;
+		}
+		if ( carry ) limbs.push_back(static_cast<unsigned int>(carry));
+	}
+
+	void mulPow10(int n)
+	{
+		for ( ; n >= 9; n -= 9) mulAdd(POW10_INT[9], 0);
+		if ( n > 0 ) mulAdd(POW10_INT[n], 0);
+	}
+
+	void mulPow2(int n)
+	{
+		if ( limbs.empty() ) return;
+		int bits = n % 32;
+		if ( bits )
+		{
+			unsigned int carry = 0;
+			for (std::size_t i=0, sz=limbs.size(); i<sz; ++i)
+			{
+				unsigned int l = limbs[i];
+				limbs[i] = (l << bits) | carry;
+				carry = l >> (32 - bits);
+			}
+			if ( carry ) limbs.push_back(carry);
+		}
+		limbs.insert(limbs.begin(), n / 32, 0u);
+	}
+
+	int compare(const BigInt &o) const
+	{
+		if ( limbs.size() != o.limbs.size() )
+			return limbs.size() < o.limbs.size() ? -1 : 1;
+		for (std::size_t i=limbs.size(); i--; )
+		{
+			if ( limbs[i] != o.limbs[i] )
+				return limbs[i] < o.limbs[i] ? -1 : 1;
+		}
+		return 0;
+	}
+
+private:
+
+	// least significant first, without zero limbs on top
+	std::vector<unsigned int> limbs;
+};
+
+// z * 10^e, without overflow or underflow along the way
+double
+scale10(double z, int e)
+{
+	if ( e < 0 )
+	{
+		for ( ; e < -MAX_EXACT_POW10; e += MAX_EXACT_POW10)
+			z /= POW10[MAX_EXACT_POW10];
+		return z / POW10[-e];
+	}
+	for ( ; e > MAX_EXACT_POW10; e -= MAX_EXACT_POW10)
+		z *= POW10[MAX_EXACT_POW10];
+	return z * POW10[e];
+}
+
+// Next double away from zero, or towards it, for z >= 0
+double
+nextDouble(double z, int step)
+{
+	int64 bits;
+	std::memcpy(&bits, &z, sizeof bits);
+	bits += step;
+	std::memcpy(&z, &bits, sizeof bits);
+	return z;
+}
+
+// z = m * 2^k, with m the integer significand of z
+void
+decompose(double z, int64 &m, int &k)
+{
+	if ( z == 0.0 )
+	{
+		m = 0;
+		k = -1074;
+		return;
+	}
+	int e;
+	double f = std::frexp(z, &e);
+	m = static_cast<int64>(std::ldexp(f, 53));
+	k = e - 53;
+	if ( k < -1074 )
+	{
+		// subnormal: exact, z being a multiple of 2^-1074
+		m >>= (-1074 - k);
+		k = -1074;
+	}
+}
+
+/*
+ * Compares the decimal value d * 10^e10, plus a bit more if sticky,
+ * with h * 2^e2
+ */
+int
+compareValue(const BigInt &d, int e10, bool sticky, int64 h, int e2)
+{
+	BigInt lhs(d);
+	BigInt rhs(h);
+	if ( e10 >= 0 ) lhs.mulPow10(e10);
+	else rhs.mulPow10(-e10);
+	if ( e2 >= 0 ) rhs.mulPow2(e2);
+	else lhs.mulPow2(-e2);
+
+	int c = lhs.compare(rhs);
+	if ( c == 0 && sticky ) c = 1;
+	return c;
+}
+
+/*
+ * The double nearest to digits * 10^e10 (plus a bit more if sticky),
+ * starting from the approximation z: moves z by one unit in the last
+ * place until the value lies between the halfway points to the
+ * neighbours of z.
+ */
+double
+correct(const char *digits, int nd, int e10, bool sticky, double z)
+{
+	BigInt d(0);
+	for (int i=0; i<nd; )
+	{
+		int n = nd - i < 9 ? nd - i : 9;
+		unsigned int chunk = 0;
+		for (int j=0; j<n; ++j, ++i) chunk = chunk * 10 + (digits[i] - '0');
+		d.mulAdd(POW10_INT[n], chunk);
+	}
+
+	if ( z > DBL_MAX ) z = DBL_MAX;
+
+	for (;;)
+	{
+		int64 m;
+		int k;
+		decompose(z, m, k);
+
+		// Halfway to the next double up
+		int c = compareValue(d, e10, sticky, 2 * m + 1, k - 1);
+		if ( c > 0 || ( c == 0 && ( m & 1 ) ) )
+		{
+			// past DBL_MAX, this gives the infinity
+			z = nextDouble(z, 1);
+			if ( c == 0 || z > DBL_MAX ) return z;
+			continue;
+		}
+		if ( c == 0 || m == 0 ) return z;
+
+		// Halfway to the next double down, which is twice closer
+		// below powers of two other than the smallest normal
+		if ( m == ( static_cast<int64>(1) << 52 ) && k > -1074 )
+			c = compareValue(d, e10, sticky, 4 * m - 1, k - 2);
+		else
+			c = compareValue(d, e10, sticky, 2 * m - 1, k - 1);
+		if ( c < 0 || ( c == 0 && ( m & 1 ) ) )
+		{
+			z = nextDouble(z, -1);
+			if ( c == 0 ) return z;
+			continue;
+		}
+		return z;
+	}
+}
+
+/*
+ * Grisu2, for toShortest()
+ */
+
+typedef unsigned long long uint64;
+
+const uint64 HIDDEN_BIT = 0x0010000000000000ULL;
+const uint64 SIGNIFICAND_MASK = 0x000FFFFFFFFFFFFFULL;
+
+const uint64 POW10_64[] = {
+	1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+	10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+	100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+	100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+	100000000000000000ULL, 1000000000000000000ULL,
+	10000000000000000000ULL
+};
+
+// 10^k for k = -348, -340, ..., 340, as normalized f * 2^e
+const uint64 CACHED_POWERS_F[] = {
+	0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+	0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+	0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+	0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+	0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+	0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+	0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+	0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+	0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+	0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+	0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+	0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+	0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+	0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+	0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+	0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+	0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+	0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+	0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+	0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+	0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+	0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+	0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+	0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+	0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+	0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+	0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+	0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+	0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL,
+};
+
+const short CACHED_POWERS_E[] = {
+	-1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+	-954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+	-688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+	-422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+	-157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+	109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+	375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+	641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+	907, 933, 960, 986, 1013, 1039, 1066,
+};
+
+// f * 2^e, with 64 bits of significand
+struct DiyFp {
+
+	DiyFp(uint64 significand, int exponent)
+		: f(significand), e(exponent)
+	{}
+
+	uint64 f;
+	int e;
+};
+
+// a * b, rounded to the 64 high bits of the product
+DiyFp
+multiply(const DiyFp &a, const DiyFp &b)
+{
+	const uint64 M32 = 0xFFFFFFFFULL;
+	uint64 ah = a.f >> 32, al = a.f & M32;
+	uint64 bh = b.f >> 32, bl = b.f & M32;
+	uint64 hh = ah * bh;
+	uint64 hl = ah * bl;
+	uint64 lh = al * bh;
+	uint64 ll = al * bl;
+	uint64 mid = ( ll >> 32 ) + ( hl & M32 ) + ( lh & M32 );
+	mid += 1ULL << 31;
+	return DiyFp(hh + ( hl >> 32 ) + ( lh >> 32 ) + ( mid >> 32 ),
+			a.e + b.e + 64);
+}
+
+DiyFp
+normalize(DiyFp x)
+{
+	while ( ! ( x.f & ( 1ULL << 63 ) ) )
+	{
+		x.f <<= 1;
+		--x.e;
+	}
+	return x;
+}
+
+/*
+ * 10^-K as a DiyFp, chosen so that multiplying by it brings the
+ * binary exponent e to [-60, -32]
+ */
+DiyFp
+cachedPower(int e, int &K)
+{
+	double dk = ( -61 - e ) * 0.30102999566398114 + 347; // log10(2)
+	int k = static_cast<int>(dk);
+	if ( dk - k > 0.0 ) ++k;
+	int index = ( k >> 3 ) + 1;
+	K = 348 - index * 8;
+	return DiyFp(CACHED_POWERS_F[index], CACHED_POWERS_E[index]);
+}
+
+/*
+ * Moves the last digit down while that brings the digits closer to
+ * the value and keeps them in the interval of the values which read
+ * back as the double
+ */
+void
+grisuRound(char *digits, int len, uint64 delta, uint64 rest,
+		uint64 tenKappa, uint64 distance)
+{
+	while ( rest < distance && delta - rest >= tenKappa &&
+		( rest + tenKappa < distance ||
+		  distance - rest > rest + tenKappa - distance ) )
+	{
+		--digits[len - 1];
+		rest += tenKappa;
+	}
+}
+
+/*
+ * Generates the digits of high, stopping as soon as they are within
+ * delta of it: the value is digits * 10^K
+ */
+void
+digitGen(const DiyFp &w, const DiyFp &high, uint64 delta, char *digits,
+		int &len, int &K)
+{
+	const int shift = -high.e;
+	const uint64 one = 1ULL << shift;
+	const uint64 distance = high.f - w.f;
+
+	unsigned int p1 = static_cast<unsigned int>(high.f >> shift);
+	uint64 p2 = high.f & ( one - 1 );
+
+	int kappa = 1;
+	while ( kappa < 10 && p1 >= POW10_64[kappa] ) ++kappa;
+
+	len = 0;
+	while ( kappa > 0 )
+	{
+		unsigned int div = static_cast<unsigned int>(POW10_64[kappa - 1]);
+		unsigned int d = p1 / div;
+		p1 %= div;
+		if ( d || len ) digits[len++] = static_cast<char>('0' + d);
+		--kappa;
+		uint64 rest = ( static_cast<uint64>(p1) << shift ) + p2;
+		if ( rest <= delta )
+		{
+			K += kappa;
+			grisuRound(digits, len, delta, rest,
+					POW10_64[kappa] << shift, distance);
+			return;
+		}
+	}
+
+	for (;;)
+	{
+		p2 *= 10;
+		delta *= 10;
+		char d = static_cast<char>(p2 >> shift);
+		if ( d || len ) digits[len++] = static_cast<char>('0' + d);
+		p2 &= one - 1;
+		--kappa;
+		if ( p2 < delta )
+		{
+			K += kappa;
+			int index = -kappa;
+			grisuRound(digits, len, delta, p2, one,
+					index < 20 ? distance * POW10_64[index] : 0);
+			return;
+		}
+	}
+}
+
+/*
+ * The shortest digits, but in rare cases, of a positive finite
+ * double: the value is digits * 10^K
+ */
+void
+grisu2(double value, char *digits, int &len, int &K)
+{
+	uint64 bits;
+	std::memcpy(&bits, &value, sizeof bits);
+	int biased = static_cast<int>(( bits >> 52 ) & 0x7FF);
+	uint64 significand = bits & SIGNIFICAND_MASK;
+
+	DiyFp v = biased ? DiyFp(significand + HIDDEN_BIT, biased - 1075)
+	                 : DiyFp(significand, -1074);
+
+	// Halfway points to the neighbours of v, the one below being
+	// closer above powers of two other than the smallest normal
+	DiyFp plus = normalize(DiyFp(( v.f << 1 ) + 1, v.e - 1));
+	DiyFp minus = ( v.f == HIDDEN_BIT && v.e > -1074 )
+		? DiyFp(( v.f << 2 ) - 1, v.e - 2)
+		: DiyFp(( v.f << 1 ) - 1, v.e - 1);
+	minus.f <<= minus.e - plus.e;
+	minus.e = plus.e;
+
+	DiyFp c = cachedPower(plus.e, K);
+	DiyFp w = multiply(normalize(v), c);
+	DiyFp high = multiply(plus, c);
+	DiyFp low = multiply(minus, c);
+
+	// Stay inside the interval despite the rounding of multiply()
+	++low.f;
+	--high.f;
+
+	digitGen(w, high, high.f - low.f, digits, len, K);
+}
+
+// Writes the exponent of the exponent notation of printf()
+char *
+writeExponent(int e, char *p)
+{
+	*p++ = 'e';
+	*p++ = e < 0 ? '-' : '+';
+	if ( e < 0 ) e = -e;
+	if ( e >= 100 ) *p++ = static_cast<char>('0' + e / 100);
+	*p++ = static_cast<char>('0' + e / 10 % 10);
+	*p++ = static_cast<char>('0' + e % 10);
+	return p;
+}
+
+} // anonymous namespace
+
+/*public static*/
+bool
+DoubleConversion::parse(const char *begin, const char *end, double &value)
+{
+	const char *p = begin;
+
+	bool negative = false;
+	if ( p != end && ( *p == '+' || *p == '-' ) )
+	{
+		negative = ( *p == '-' );
+		++p;
+	}
+	if ( p == end ) return false;
+
+	if ( *p != '.' && ! isDigit(*p) )
+	{
+		double special;
+		if ( matchWord(p, end, "inf") || matchWord(p, end, "infinity") )
+			special = DoubleInfinity;
+		else if ( matchWord(p, end, "nan") )
+			special = DoubleNotANumber;
+		else
+			return false;
+		value = negative ? -special : special;
+		return true;
+	}
+
+	// The value is digits[0..nd) * 10^e10, plus a bit more if sticky
+	char digits[MAX_DIGITS];
+	int nd = 0;
+	int e10 = 0;
+	bool sticky = false;
+	bool anyDigit = false;
+
+	for ( ; p != end && isDigit(*p); ++p)
+	{
+		anyDigit = true;
+		if ( nd == 0 && *p == '0' ) continue;
+		if ( nd < MAX_DIGITS ) digits[nd++] = *p;
+		else
+		{
+			++e10;
+			if ( *p != '0' ) sticky = true;
+		}
+	}
+	if ( p != end && *p == '.' )
+	{
+		for (++p; p != end && isDigit(*p); ++p)
+		{
+			anyDigit = true;
+			if ( nd == 0 && *p == '0' ) --e10;
+			else if ( nd < MAX_DIGITS )
+			{
+				digits[nd++] = *p;
+				--e10;
+			}
+			else if ( *p != '0' ) sticky = true;
+		}
+	}
+	if ( ! anyDigit ) return false;
+
+	if ( p != end && ( *p == 'e' || *p == 'E' ) )
+	{
+		++p;
+		bool expNegative = false;
+		if ( p != end && ( *p == '+' || *p == '-' ) )
+		{
+			expNegative = ( *p == '-' );
+			++p;
+		}
+		if ( p == end || ! isDigit(*p) ) return false;
+		int e = 0;
+		for ( ; p != end && isDigit(*p); ++p)
+		{
+			if ( e < 100000 ) e = e * 10 + ( *p - '0' );
+		}
+		e10 += expNegative ? -e : e;
+	}
+	if ( p != end ) return false;
+
+	// Trailing zeros make the exact path fail for nothing
+	for ( ; nd > 0 && digits[nd - 1] == '0'; --nd) ++e10;
+
+	double result;
+	if ( nd == 0 )
+		result = 0.0;
+	else if ( nd + e10 > 309 ) // >= 1e309
+		result = DoubleInfinity;
+	else if ( nd + e10 < -323 ) // < 1e-324, closer to 0 than to 2^-1074
+		result = 0.0;
+	else
+	{
+		int used = nd < 18 ? nd : 18;
+		int64 mant = 0;
+		for (int i=0; i<used; ++i) mant = mant * 10 + ( digits[i] - '0' );
+		int e = e10 + ( nd - used );
+
+		bool exact = EXACT_DOUBLE_ARITHMETIC && used == nd && ! sticky &&
+			mant <= MAX_EXACT_INT;
+		if ( exact && e > MAX_EXACT_POW10 )
+		{
+			// 123e25 is 123000e22
+			for ( ; e > MAX_EXACT_POW10 && mant <= MAX_EXACT_INT / 10; --e)
+				mant *= 10;
+		}
+
+		if ( exact && e >= -MAX_EXACT_POW10 && e <= MAX_EXACT_POW10 )
+		{
+			// One rounding, of exact operands
+			double m = static_cast<double>(mant);
+			result = e < 0 ? m / POW10[-e] : m * POW10[e];
+		}
+		else
+		{
+			result = correct(digits, nd, e10, sticky,
+					scale10(static_cast<double>(mant), e));
+		}
+	}
+
+	value = negative ? -result : result;
+	return true;
+}
+
+/*public static*/
+std::size_t
+DoubleConversion::toShortest(double value, char *buffer)
+{
+	char *p = buffer;
+
+	if ( value != value )
+	{
+		std::memcpy(p, "nan", 4);
+		return 3;
+	}
+
+	if ( value < 0 || ( value == 0 && 1 / value < 0 ) )
+	{
+		*p++ = '-';
+		value = -value;
+	}
+
+	if ( value > DBL_MAX )
+	{
+		std::memcpy(p, "inf", 4);
+		return p + 3 - buffer;
+	}
+
+	if ( value == 0 )
+	{
+		*p++ = '0';
+		*p = '\0';
+		return p - buffer;
+	}
+
+	char digits[20];
+	int len, K;
+	grisu2(value, digits, len, K);
+	for ( ; len > 1 && digits[len - 1] == '0'; --len) ++K;
+
+	// The exponent of the first digit, as in 1.5e+300
+	int x = len + K - 1;
+
+	if ( x < -4 || x >= 17 )
+	{
+		*p++ = digits[0];
+		if ( len > 1 )
+		{
+			*p++ = '.';
+			std::memcpy(p, digits + 1, len - 1);
+			p += len - 1;
+		}
+		p = writeExponent(x, p);
+	}
+	else if ( K >= 0 )
+	{
+		// 120
+		std::memcpy(p, digits, len);
+		p += len;
+		for (int i=0; i<K; ++i) *p++ = '0';
+	}
+	else if ( x >= 0 )
+	{
+		// 1.25
+		std::memcpy(p, digits, x + 1);
+		p += x + 1;
+		*p++ = '.';
+		std::memcpy(p, digits + x + 1, len - x - 1);
+		p += len - x - 1;
+	}
+	else
+	{
+		// 0.0125
+		*p++ = '0';
+		*p++ = '.';
+		for (int i=0; i<-x-1; ++i) *p++ = '0';
+		std::memcpy(p, digits, len);
+		p += len;
+	}
+
+	*p = '\0';
+	return p - buffer;
+}
+
+} // namespace geos.io
+} // namespace geos
@@ -0,0 +1,69 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/io/GeoJSON.h>
+#include <geos/geom/Geometry.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace geos::geom;
+
+namespace geos {
+namespace io { // geos.io
+
+GeoJSONFeature::GeoJSONFeature(auto_ptr<Geometry> g, const string &i,
+		const string &p)
+	:
+	geometry(0),
+	id(i),
+	properties(p.empty() ? string("null") : p)
+{
+	geometry = g.release();
+}
+
+GeoJSONFeature::~GeoJSONFeature()
+{
+	delete geometry;
+}
+
+/*public*/
+auto_ptr<Geometry>
+GeoJSONFeature::releaseGeometry()
+{
+	auto_ptr<Geometry> ret(geometry);
+	geometry = 0;
+	return ret;
+}
+
+GeoJSONFeatureCollection::GeoJSONFeatureCollection()
+{
+}
+
+GeoJSONFeatureCollection::~GeoJSONFeatureCollection()
+{
+	for (size_t i=0, n=features.size(); i<n; ++i)
+		delete features[i];
+}
+
+/*public*/
+void
+GeoJSONFeatureCollection::add(auto_ptr<GeoJSONFeature> feature)
+{
+	features.push_back(feature.get());
+	feature.release();
+}
+
+} // namespace geos.io
+} // namespace geos
@@ -0,0 +1,849 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/io/GeoJSONReader.h>
+#include <geos/io/GeoJSON.h>
+#include <geos/io/DoubleConversion.h>
+#include <geos/io/ParseException.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryCollection.h>
+#include <geos/geom/Point.h>
+#include <geos/geom/LinearRing.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/Polygon.h>
+#include <geos/geom/MultiPoint.h>
+#include <geos/geom/MultiLineString.h>
+#include <geos/geom/MultiPolygon.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/CoordinateSequenceFactory.h>
+#include <geos/geom/PrecisionModel.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <locale>
+#include <cstddef>
+
+using namespace std;
+using namespace geos::geom;
+
+namespace geos {
+namespace io { // geos.io
+
+namespace {
+
+// Point, LineString, Polygon, MultiPolygon: 1 to 4 levels of arrays
+const int MAX_COORDINATE_DEPTH = 4;
+
+// Deeper collections and features are taken as corrupt, rather than
+// risking the stack on them
+const int MAX_NESTING = 256;
+
+inline bool
+isDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+/*
+ * The "coordinates" of a geometry, kept until the type is known as it
+ * may come after them: the positions, in order, and where each array
+ * of arrays ends. The outermost array is level 0.
+ */
+struct Coordinates {
+
+	Coordinates()
+		: leafLevel(-1), hasZ(false), present(false)
+	{
+		for (int i=0; i<MAX_COORDINATE_DEPTH; ++i) count[i] = 0;
+	}
+
+	vector<Coordinate> positions;
+
+	// ends[l][i]: the number of arrays read at level l+1 when the
+	// i-th array of level l ended
+	vector<size_t> ends[MAX_COORDINATE_DEPTH - 1];
+
+	// the number of arrays read at each level
+	size_t count[MAX_COORDINATE_DEPTH];
+
+	// the level of the positions, -1 if none
+	int leafLevel;
+
+	bool hasZ;
+
+	bool present;
+};
+
+// What a GeoJSON object turned out to be, only one being set
+struct ParsedObject {
+	auto_ptr<Geometry> geometry;
+	auto_ptr<GeoJSONFeature> feature;
+	auto_ptr<GeoJSONFeatureCollection> features;
+};
+
+// Geometries being collected, deleted unless released
+class GeometryList {
+
+public:
+
+	GeometryList() : geoms(new vector<Geometry *>) {}
+
+	~GeometryList()
+	{
+		if ( ! geoms.get() ) return;
+		for (size_t i=0, n=geoms->size(); i<n; ++i)
+			delete (*geoms)[i];
+	}
+
+	void add(auto_ptr<Geometry> g)
+	{
+		geoms->push_back(g.get());
+		g.release();
+	}
+
+	auto_ptr< vector<Geometry *> > release() { return geoms; }
+
+private:
+
+	auto_ptr< vector<Geometry *> > geoms;
+};
+
+/*
+ * Reads GeoJSON in one pass, from begin to end, building the
+ * geometries as their objects end
+ */
+class Parser {
+
+public:
+
+	Parser(const GeometryFactory &f, const char *b, const char *e)
+		:
+		factory(f),
+		precisionModel(*f.getPrecisionModel()),
+		begin(b),
+		p(b),
+		end(e),
+		depth(0)
+	{}
+
+	void readDocument(ParsedObject &out)
+	{
+		skipSpace();
+		if ( peek() != '{' ) fail("expected a GeoJSON object");
+		readObject(out);
+		skipSpace();
+		if ( p != end ) fail("unexpected text after the GeoJSON object");
+	}
+
+private:
+
+	const GeometryFactory &factory;
+	const PrecisionModel &precisionModel;
+
+	const char *begin;
+	const char *p;
+	const char *end;
+
+	// objects open around the current one
+	int depth;
+
+	void fail(const string &msg) const
+	{
+		ostringstream s;
+		s.imbue(std::locale::classic());
+		s << "GeoJSON: " << msg << " at character " << ( p - begin );
+		throw ParseException(s.str());
+	}
+
+	char peek() const { return p != end ? *p : '\0'; }
+
+	void skipSpace()
+	{
+		while ( p != end &&
+			( *p == ' ' || *p == '\n' || *p == '\r' || *p == '\t' ) )
+		{
+			++p;
+		}
+	}
+
+	void expect(char c)
+	{
+		if ( peek() != c ) fail(string("expected '") + c + "'");
+		++p;
+	}
+
+	void readLiteral(const char *word);
+	string readString();
+	void skipString();
+	void appendUtf8(string &s, unsigned int cp);
+	unsigned int readHex4();
+	double readNumber();
+	void skipValue();
+
+	void readObject(ParsedObject &out);
+	void readCoordinates(Coordinates &c, int level);
+	void readPosition(Coordinates &c, int level);
+
+	auto_ptr<Geometry> buildGeometry(const string &type, Coordinates &c);
+	auto_ptr<CoordinateSequence> buildSequence(Coordinates &c,
+			size_t from, size_t to);
+	auto_ptr<Geometry> buildPolygon(Coordinates &c, int level, size_t i);
+};
+
+/*
+ * The arrays of level+1 within the i-th array of level, or the
+ * positions if those are at level+1
+ */
+void
+childRange(const Coordinates &c, int level, size_t i,
+		size_t &from, size_t &to)
+{
+	const vector<size_t> &e = c.ends[level];
+	from = i ? e[i - 1] : 0;
+	to = e[i];
+}
+
+void
+Parser::readLiteral(const char *word)
+{
+	const char *q = p;
+	for ( ; *word; ++word, ++q)
+	{
+		if ( q == end || *q != *word ) fail("invalid value");
+	}
+	p = q;
+}
+
+string
+Parser::readString()
+{
+	expect('"');
+	string s;
+	for (;;)
+	{
+		const char *start = p;
+		while ( p != end && *p != '"' && *p != '\\' &&
+			static_cast<unsigned char>(*p) >= 0x20 )
+		{
+			++p;
+		}
+		s.append(start, p);
+
+		if ( p == end ) fail("unterminated string");
+		if ( *p == '"' )
+		{
+			++p;
+			return s;
+		}
+		if ( *p != '\\' ) fail("control character in string");
+
+		++p;
+		switch ( peek() )
+		{
+			case '"': s += '"'; break;
+			case '\\': s += '\\'; break;
+			case '/': s += '/'; break;
+			case 'b': s += '\b'; break;
+			case 'f': s += '\f'; break;
+			case 'n': s += '\n'; break;
+			case 'r': s += '\r'; break;
+			case 't': s += '\t'; break;
+			case 'u':
+			{
+				++p;
+				unsigned int cp = readHex4();
+				// a surrogate pair is one code point
+				if ( cp >= 0xD800 && cp < 0xDC00 &&
+					end - p >= 6 && p[0] == '\\' && p[1] == 'u' )
+				{
+					const char *save = p;
+					p += 2;
+					unsigned int low = readHex4();
+					if ( low >= 0xDC00 && low < 0xE000 )
+						cp = 0x10000 + ( ( cp - 0xD800 ) << 10 ) + ( low - 0xDC00 );
+					else
+						p = save;
+				}
+				appendUtf8(s, cp);
+				continue;
+			}
+			default:
+				fail("invalid escape in string");
+		}
+		++p;
+	}
+}
+
+void
+Parser::skipString()
+{
+	expect('"');
+	for (;;)
+	{
+		while ( p != end && *p != '"' && *p != '\\' &&
+			static_cast<unsigned char>(*p) >= 0x20 )
+		{
+			++p;
+		}
+		if ( p == end ) fail("unterminated string");
+		if ( *p == '"' )
+		{
+			++p;
+			return;
+		}
+		if ( *p != '\\' ) fail("control character in string");
+		if ( end - p < 2 ) fail("unterminated string");
+		p += 2;
+	}
+}
+
+unsigned int
+Parser::readHex4()
+{
+	if ( end - p < 4 ) fail("invalid escape in string");
+	unsigned int cp = 0;
+	for (int i=0; i<4; ++i, ++p)
+	{
+		char c = *p;
+		cp <<= 4;
+		if ( isDigit(c) ) cp |= c - '0';
+		else if ( c >= 'a' && c <= 'f' ) cp |= c - 'a' + 10;
+		else if ( c >= 'A' && c <= 'F' ) cp |= c - 'A' + 10;
+		else fail("invalid escape in string");
+	}
+	return cp;
+}
+
+void
+Parser::appendUtf8(string &s, unsigned int cp)
+{
+	if ( cp < 0x80 )
+	{
+		s += static_cast<char>(cp);
+	}
+	else if ( cp < 0x800 )
+	{
+		s += static_cast<char>(0xC0 | ( cp >> 6 ));
+		s += static_cast<char>(0x80 | ( cp & 0x3F ));
+	}
+	else if ( cp < 0x10000 )
+	{
+		s += static_cast<char>(0xE0 | ( cp >> 12 ));
+		s += static_cast<char>(0x80 | ( ( cp >> 6 ) & 0x3F ));
+		s += static_cast<char>(0x80 | ( cp & 0x3F ));
+	}
+	else
+	{
+		s += static_cast<char>(0xF0 | ( cp >> 18 ));
+		s += static_cast<char>(0x80 | ( ( cp >> 12 ) & 0x3F ));
+		s += static_cast<char>(0x80 | ( ( cp >> 6 ) & 0x3F ));
+		s += static_cast<char>(0x80 | ( cp & 0x3F ));
+	}
+}
+
+double
+Parser::readNumber()
+{
+	const char *start = p;
+	while ( p != end && ( isDigit(*p) || *p == '-' || *p == '+' ||
+		*p == '.' || *p == 'e' || *p == 'E' ) )
+	{
+		++p;
+	}
+	double d;
+	if ( ! DoubleConversion::parse(start, p, d) )
+	{
+		p = start;
+		fail("invalid number");
+	}
+	return d;
+}
+
+/*
+ * Checks and steps over any value. Nested arrays and objects are
+ * followed with an explicit stack, so that no input can exhaust the
+ * call stack.
+ */
+void
+Parser::skipValue()
+{
+	// '{' or '[' for each open object or array
+	vector<char> open;
+
+	for (;;)
+	{
+		skipSpace();
+		char c = peek();
+		if ( c == '{' || c == '[' )
+		{
+			++p;
+			skipSpace();
+			if ( peek() == ( c == '{' ? '}' : ']' ) )
+			{
+				++p;
+			}
+			else
+			{
+				open.push_back(c);
+				if ( c == '{' )
+				{
+					skipString();
+					skipSpace();
+					expect(':');
+				}
+				continue;
+			}
+		}
+		else if ( c == '"' ) skipString();
+		else if ( c == '-' || isDigit(c) ) readNumber();
+		else if ( c == 't' ) readLiteral("true");
+		else if ( c == 'f' ) readLiteral("false");
+		else if ( c == 'n' ) readLiteral("null");
+		else fail("expected a value");
+
+		// After a value: close what ends here, then go to the next
+		for (;;)
+		{
+			if ( open.empty() ) return;
+			skipSpace();
+			char close = open.back() == '{' ? '}' : ']';
+			if ( peek() == close )
+			{
+				++p;
+				open.pop_back();
+				continue;
+			}
+			expect(',');
+			if ( open.back() == '{' )
+			{
+				skipSpace();
+				skipString();
+				skipSpace();
+				expect(':');
+			}
+			break;
+		}
+	}
+}
+
+void
+Parser::readObject(ParsedObject &out)
+{
+	string type;
+	Coordinates coords;
+	GeometryList geometries;
+	bool hasGeometries = false;
+	auto_ptr<Geometry> geometry;
+	auto_ptr<GeoJSONFeatureCollection> features;
+	string id;
+	string properties;
+
+	if ( ++depth > MAX_NESTING ) fail("objects nested too deeply");
+	expect('{');
+	skipSpace();
+	if ( peek() == '}' ) ++p;
+	else for (;;)
+	{
+		skipSpace();
+		string key = readString();
+		skipSpace();
+		expect(':');
+		skipSpace();
+
+		if ( key == "type" )
+		{
+			type = readString();
+		}
+		else if ( key == "coordinates" )
+		{
+			if ( coords.present ) fail("duplicate coordinates");
+			coords.present = true;
+			readCoordinates(coords, 0);
+		}
+		else if ( key == "geometries" )
+		{
+			hasGeometries = true;
+			expect('[');
+			skipSpace();
+			if ( peek() == ']' ) ++p;
+			else for (;;)
+			{
+				skipSpace();
+				ParsedObject o;
+				readObject(o);
+				if ( ! o.geometry.get() ) fail("expected a geometry");
+				geometries.add(o.geometry);
+				skipSpace();
+				if ( peek() != ',' )
+				{
+					expect(']');
+					break;
+				}
+				++p;
+			}
+		}
+		else if ( key == "geometry" )
+		{
+			if ( peek() == 'n' )
+			{
+				readLiteral("null");
+				geometry.reset();
+			}
+			else
+			{
+				ParsedObject o;
+				readObject(o);
+				if ( ! o.geometry.get() ) fail("expected a geometry");
+				geometry = o.geometry;
+			}
+		}
+		else if ( key == "features" )
+		{
+			features.reset(new GeoJSONFeatureCollection());
+			expect('[');
+			skipSpace();
+			if ( peek() == ']' ) ++p;
+			else for (;;)
+			{
+				skipSpace();
+				ParsedObject o;
+				readObject(o);
+				if ( ! o.feature.get() ) fail("expected a feature");
+				features->add(o.feature);
+				skipSpace();
+				if ( peek() != ',' )
+				{
+					expect(']');
+					break;
+				}
+				++p;
+			}
+		}
+		else if ( key == "id" )
+		{
+			const char *start = p;
+			skipValue();
+			id.assign(start, p);
+		}
+		else if ( key == "properties" )
+		{
+			const char *start = p;
+			skipValue();
+			properties.assign(start, p);
+		}
+		else
+		{
+			skipValue();
+		}
+
+		skipSpace();
+		if ( peek() != ',' )
+		{
+			expect('}');
+			break;
+		}
+		++p;
+	}
+	--depth;
+
+	if ( type == "Feature" )
+	{
+		out.feature.reset(new GeoJSONFeature(geometry, id, properties));
+	}
+	else if ( type == "FeatureCollection" )
+	{
+		if ( ! features.get() ) fail("FeatureCollection without features");
+		out.features = features;
+	}
+	else if ( type == "GeometryCollection" )
+	{
+		if ( ! hasGeometries ) fail("GeometryCollection without geometries");
+		out.geometry = factory.createGeometryCollection(geometries.release());
+	}
+	else if ( type.empty() )
+	{
+		fail("object without type");
+	}
+	else
+	{
+		if ( ! coords.present ) fail(type + " without coordinates");
+		out.geometry = buildGeometry(type, coords);
+	}
+}
+
+void
+Parser::readCoordinates(Coordinates &c, int level)
+{
+	if ( level >= MAX_COORDINATE_DEPTH ) fail("coordinates nested too deeply");
+
+	expect('[');
+	skipSpace();
+	char ch = peek();
+	if ( ch == '-' || isDigit(ch) )
+	{
+		readPosition(c, level);
+		return;
+	}
+
+	if ( ch != ']' ) for (;;)
+	{
+		readCoordinates(c, level + 1);
+		skipSpace();
+		if ( peek() != ',' ) break;
+		++p;
+		skipSpace();
+	}
+	expect(']');
+
+	if ( level + 1 < MAX_COORDINATE_DEPTH )
+		c.ends[level].push_back(c.count[level + 1]);
+	++c.count[level];
+}
+
+/* After the '[' of the position */
+void
+Parser::readPosition(Coordinates &c, int level)
+{
+	if ( c.leafLevel == -1 ) c.leafLevel = level;
+	else if ( c.leafLevel != level ) fail("positions at different depths");
+
+	Coordinate pt;
+	pt.x = readNumber();
+	skipSpace();
+	expect(',');
+	skipSpace();
+	pt.y = readNumber();
+	skipSpace();
+	if ( peek() == ',' )
+	{
+		++p;
+		skipSpace();
+		pt.z = readNumber();
+		c.hasZ = true;
+		skipSpace();
+
+		// m, or anything else, is not kept
+		while ( peek() == ',' )
+		{
+			++p;
+			skipSpace();
+			readNumber();
+			skipSpace();
+		}
+	}
+	expect(']');
+
+	precisionModel.makePrecise(pt);
+	c.positions.push_back(pt);
+	++c.count[level];
+}
+
+auto_ptr<CoordinateSequence>
+Parser::buildSequence(Coordinates &c, size_t from, size_t to)
+{
+	auto_ptr< vector<Coordinate> > v(new vector<Coordinate>());
+	if ( from == 0 && to == c.positions.size() )
+	{
+		// the only part, as is usual for LineStrings
+		v->swap(c.positions);
+	}
+	else
+	{
+		v->assign(c.positions.begin() + from, c.positions.begin() + to);
+	}
+	return factory.getCoordinateSequenceFactory()->create(v,
+			c.hasZ ? 3 : 2);
+}
+
+/* The polygon of the i-th array at level, which holds its rings */
+auto_ptr<Geometry>
+Parser::buildPolygon(Coordinates &c, int level, size_t i)
+{
+	size_t from, to;
+	childRange(c, level, i, from, to);
+	if ( from == to ) return auto_ptr<Geometry>(factory.createPolygon());
+
+	auto_ptr<LinearRing> shell;
+	GeometryList holes;
+	for (size_t j=from; j<to; ++j)
+	{
+		size_t pfrom, pto;
+		childRange(c, level + 1, j, pfrom, pto);
+		auto_ptr<Geometry> ring =
+			factory.createLinearRing(buildSequence(c, pfrom, pto));
+		if ( j == from )
+			shell.reset(dynamic_cast<LinearRing *>(ring.release()));
+		else
+			holes.add(ring);
+	}
+	return factory.createPolygon(shell, holes.release());
+}
+
+auto_ptr<Geometry>
+Parser::buildGeometry(const string &type, Coordinates &c)
+{
+	int depth;
+	if ( type == "Point" ) depth = 1;
+	else if ( type == "LineString" || type == "MultiPoint" ) depth = 2;
+	else if ( type == "Polygon" || type == "MultiLineString" ) depth = 3;
+	else if ( type == "MultiPolygon" ) depth = 4;
+	else
+	{
+		fail("unknown type " + type);
+		return auto_ptr<Geometry>(); // not reached
+	}
+
+	if ( depth == 1 && c.positions.empty() && ! c.count[1] )
+		return auto_ptr<Geometry>(factory.createPoint());
+
+	// The positions, and no empty array, at the level of the type
+	if ( c.leafLevel != -1 && c.leafLevel != depth - 1 )
+		fail("coordinates do not match the type " + type);
+	for (int l=depth; l<MAX_COORDINATE_DEPTH; ++l)
+	{
+		if ( c.count[l] ) fail("coordinates do not match the type " + type);
+	}
+	if ( c.count[depth - 1] != c.positions.size() )
+		fail("empty position");
+
+	size_t from, to;
+	if ( depth == 1 )
+	{
+		return auto_ptr<Geometry>(factory.createPoint(c.positions[0]));
+	}
+
+	childRange(c, 0, 0, from, to);
+	if ( type == "LineString" )
+	{
+		return factory.createLineString(buildSequence(c, from, to));
+	}
+	if ( type == "MultiPoint" )
+	{
+		GeometryList points;
+		for (size_t i=from; i<to; ++i)
+		{
+			points.add(auto_ptr<Geometry>(
+				factory.createPoint(c.positions[i])));
+		}
+		return factory.createMultiPoint(points.release());
+	}
+	if ( type == "Polygon" )
+	{
+		return buildPolygon(c, 0, 0);
+	}
+	if ( type == "MultiLineString" )
+	{
+		GeometryList lines;
+		for (size_t i=from; i<to; ++i)
+		{
+			size_t pfrom, pto;
+			childRange(c, 1, i, pfrom, pto);
+			lines.add(factory.createLineString(
+				buildSequence(c, pfrom, pto)));
+		}
+		return factory.createMultiLineString(lines.release());
+	}
+
+	// MultiPolygon
+	GeometryList polys;
+	for (size_t i=from; i<to; ++i)
+		polys.add(buildPolygon(c, 1, i));
+	return factory.createMultiPolygon(polys.release());
+}
+
+} // anonymous namespace
+
+GeoJSONReader::GeoJSONReader(const GeometryFactory &f)
+	:
+	factory(f)
+{
+}
+
+GeoJSONReader::GeoJSONReader()
+	:
+	factory(*(GeometryFactory::getDefaultInstance()))
+{
+}
+
+GeoJSONReader::~GeoJSONReader()
+{
+}
+
+/*public*/
+Geometry *
+GeoJSONReader::read(const string &geoJson)
+{
+	return read(geoJson.data(), geoJson.size());
+}
+
+/*public*/
+Geometry *
+GeoJSONReader::read(const char *geoJson, size_t size)
+{
+	ParsedObject o;
+	Parser parser(factory, geoJson, geoJson + size);
+	parser.readDocument(o);
+
+	if ( o.geometry.get() ) return o.geometry.release();
+
+	if ( o.feature.get() )
+	{
+		auto_ptr<Geometry> g = o.feature->releaseGeometry();
+		if ( g.get() ) return g.release();
+		return factory.createGeometryCollection();
+	}
+
+	GeometryList geoms;
+	for (size_t i=0, n=o.features->getSize(); i<n; ++i)
+	{
+		auto_ptr<Geometry> g = o.features->getFeature(i).releaseGeometry();
+		if ( g.get() ) geoms.add(g);
+	}
+	return factory.createGeometryCollection(geoms.release()).release();
+}
+
+/*public*/
+auto_ptr<GeoJSONFeatureCollection>
+GeoJSONReader::readFeatures(const string &geoJson)
+{
+	return readFeatures(geoJson.data(), geoJson.size());
+}
+
+/*public*/
+auto_ptr<GeoJSONFeatureCollection>
+GeoJSONReader::readFeatures(const char *geoJson, size_t size)
+{
+	ParsedObject o;
+	Parser parser(factory, geoJson, geoJson + size);
+	parser.readDocument(o);
+
+	if ( o.features.get() ) return o.features;
+
+	auto_ptr<GeoJSONFeatureCollection> ret(new GeoJSONFeatureCollection());
+	if ( o.feature.get() )
+	{
+		ret->add(o.feature);
+	}
+	else
+	{
+		ret->add(auto_ptr<GeoJSONFeature>(
+			new GeoJSONFeature(o.geometry, string(), string())));
+	}
+	return ret;
+}
+
+} // namespace geos.io
+} // namespace geos
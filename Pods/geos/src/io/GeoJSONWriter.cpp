@@ -0,0 +1,291 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/io/GeoJSONWriter.h>
+#include <geos/io/GeoJSON.h>
+#include <geos/io/DoubleConversion.h>
+#include <geos/io/Writer.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryCollection.h>
+#include <geos/geom/Point.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/Polygon.h>
+#include <geos/geom/MultiPoint.h>
+#include <geos/geom/MultiLineString.h>
+#include <geos/geom/MultiPolygon.h>
+#include <geos/util/IllegalArgumentException.h>
+#include <geos/platform.h> // for ISNAN, FINITE
+
+#include <algorithm> // for min
+#include <string>
+#include <cassert>
+
+using namespace std;
+using namespace geos::geom;
+
+namespace geos {
+namespace io { // geos.io
+
+namespace {
+
+char *
+appendNumber(double d, char *buf)
+{
+	if ( ! FINITE(d) )
+	{
+		throw util::IllegalArgumentException(
+			"GeoJSON cannot represent infinite or NaN coordinates");
+	}
+	return buf + DoubleConversion::toShortest(d, buf);
+}
+
+// Writes positions, as [x,y] or [x,y,z], separated by commas
+class PositionAppender {
+
+public:
+
+	PositionAppender(Writer *w, bool z)
+		: writer(w), writeZ(z), first(true)
+	{}
+
+	void operator()(const Coordinate &c)
+	{
+		char buf[3 * DoubleConversion::SHORTEST_BUFFER_SIZE + 8];
+		char *q = buf;
+		if ( ! first ) *q++ = ',';
+		first = false;
+		*q++ = '[';
+		q = appendNumber(c.x, q);
+		*q++ = ',';
+		q = appendNumber(c.y, q);
+		if ( writeZ && ! ISNAN(c.z) )
+		{
+			*q++ = ',';
+			q = appendNumber(c.z, q);
+		}
+		*q++ = ']';
+		writer->write(buf, q - buf);
+	}
+
+private:
+
+	Writer *writer;
+	bool writeZ;
+	bool first;
+};
+
+} // anonymous namespace
+
+GeoJSONWriter::GeoJSONWriter()
+	:
+	defaultOutputDimension(2),
+	outputDimension(2)
+{
+}
+
+GeoJSONWriter::~GeoJSONWriter()
+{
+}
+
+/*public*/
+void
+GeoJSONWriter::setOutputDimension(int dims)
+{
+	if ( dims < 2 || dims > 3 )
+		throw util::IllegalArgumentException("GeoJSON output dimension must be 2 or 3");
+	defaultOutputDimension = dims;
+}
+
+/*public*/
+string
+GeoJSONWriter::write(const Geometry *geometry)
+{
+	Writer w;
+	write(geometry, &w);
+	return w.toString();
+}
+
+/*public*/
+void
+GeoJSONWriter::write(const Geometry *geometry, Writer *writer)
+{
+	appendGeometry(geometry, writer);
+}
+
+/*public*/
+string
+GeoJSONWriter::writeFeatures(const GeoJSONFeatureCollection &features)
+{
+	Writer w;
+	writeFeatures(features, &w);
+	return w.toString();
+}
+
+/*public*/
+void
+GeoJSONWriter::writeFeatures(const GeoJSONFeatureCollection &features,
+		Writer *writer)
+{
+	writer->write("{\"type\":\"FeatureCollection\",\"features\":[");
+	for (size_t i=0, n=features.getSize(); i<n; ++i)
+	{
+		if ( i ) writer->write(",", 1);
+		appendFeature(features.getFeature(i), writer);
+	}
+	writer->write("]}");
+}
+
+/*private*/
+void
+GeoJSONWriter::appendFeature(const GeoJSONFeature &feature, Writer *writer)
+{
+	writer->write("{\"type\":\"Feature\"");
+	if ( ! feature.getId().empty() )
+	{
+		writer->write(",\"id\":");
+		writer->write(feature.getId());
+	}
+	writer->write(",\"geometry\":");
+	if ( feature.getGeometry() )
+		appendGeometry(feature.getGeometry(), writer);
+	else
+		writer->write("null");
+	writer->write(",\"properties\":");
+	writer->write(feature.getProperties());
+	writer->write("}");
+}
+
+/*private*/
+void
+GeoJSONWriter::appendGeometry(const Geometry *geometry, Writer *writer)
+{
+	outputDimension = (std::min)( defaultOutputDimension,
+	                       geometry->getCoordinateDimension() );
+
+	if ( const Point* point = dynamic_cast<const Point*>(geometry) )
+	{
+		writer->write("{\"type\":\"Point\",\"coordinates\":");
+		if ( point->isEmpty() )
+		{
+			writer->write("[]");
+		}
+		else
+		{
+			PositionAppender pos(writer, outputDimension == 3);
+			pos(*point->getCoordinate());
+		}
+	}
+	else if ( const LineString* ls =
+		dynamic_cast<const LineString*>(geometry) )
+	{
+		// LinearRings too
+		writer->write("{\"type\":\"LineString\",\"coordinates\":");
+		appendSequence(*ls->getCoordinatesRO(), writer);
+	}
+	else if ( const Polygon* poly =
+		dynamic_cast<const Polygon*>(geometry) )
+	{
+		writer->write("{\"type\":\"Polygon\",\"coordinates\":");
+		appendPolygonCoordinates(poly, writer);
+	}
+	else if ( const MultiPoint* mp =
+		dynamic_cast<const MultiPoint*>(geometry) )
+	{
+		writer->write("{\"type\":\"MultiPoint\",\"coordinates\":[");
+		PositionAppender pos(writer, outputDimension == 3);
+		for (size_t i=0, n=mp->getNumGeometries(); i<n; ++i)
+		{
+			// GeoJSON has no empty positions
+			const Coordinate* c = mp->getGeometryN(i)->getCoordinate();
+			if ( c ) pos(*c);
+		}
+		writer->write("]");
+	}
+	else if ( const MultiLineString* mls =
+		dynamic_cast<const MultiLineString*>(geometry) )
+	{
+		writer->write("{\"type\":\"MultiLineString\",\"coordinates\":[");
+		for (size_t i=0, n=mls->getNumGeometries(); i<n; ++i)
+		{
+			if ( i ) writer->write(",", 1);
+			const LineString* l =
+				dynamic_cast<const LineString*>(mls->getGeometryN(i));
+			appendSequence(*l->getCoordinatesRO(), writer);
+		}
+		writer->write("]");
+	}
+	else if ( const MultiPolygon* mpoly =
+		dynamic_cast<const MultiPolygon*>(geometry) )
+	{
+		writer->write("{\"type\":\"MultiPolygon\",\"coordinates\":[");
+		for (size_t i=0, n=mpoly->getNumGeometries(); i<n; ++i)
+		{
+			if ( i ) writer->write(",", 1);
+			appendPolygonCoordinates(
+				dynamic_cast<const Polygon*>(mpoly->getGeometryN(i)),
+				writer);
+		}
+		writer->write("]");
+	}
+	else if ( const GeometryCollection* gc =
+		dynamic_cast<const GeometryCollection*>(geometry) )
+	{
+		writer->write("{\"type\":\"GeometryCollection\",\"geometries\":[");
+		for (size_t i=0, n=gc->getNumGeometries(); i<n; ++i)
+		{
+			if ( i ) writer->write(",", 1);
+			appendGeometry(gc->getGeometryN(i), writer);
+		}
+		writer->write("]");
+	}
+	else
+	{
+		assert(0); // Unsupported Geometry implementation
+	}
+	writer->write("}");
+}
+
+/*private*/
+void
+GeoJSONWriter::appendPolygonCoordinates(const Polygon *polygon,
+		Writer *writer)
+{
+	writer->write("[");
+	if ( ! polygon->isEmpty() )
+	{
+		appendSequence(*polygon->getExteriorRing()->getCoordinatesRO(),
+				writer);
+		for (size_t i=0, n=polygon->getNumInteriorRing(); i<n; ++i)
+		{
+			writer->write(",", 1);
+			appendSequence(
+				*polygon->getInteriorRingN(i)->getCoordinatesRO(),
+				writer);
+		}
+	}
+	writer->write("]");
+}
+
+/*private*/
+void
+GeoJSONWriter::appendSequence(const CoordinateSequence &seq, Writer *writer)
+{
+	writer->write("[");
+	PositionAppender pos(writer, outputDimension == 3);
+	seq.forEachCoordinate(pos);
+	writer->write("]");
+}
+
+} // namespace geos.io
+} // namespace geos
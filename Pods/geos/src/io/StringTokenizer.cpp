@@ -18,157 +18,90 @@
  **********************************************************************/
 
 #include <geos/io/StringTokenizer.h>
+#include <geos/io/DoubleConversion.h>
 
 #include <string>
-#include <cstdlib>
 
 using namespace std;
 
 namespace geos {
 namespace io { // geos.io
 
-/*public*/
-StringTokenizer::StringTokenizer(const string &txt)
-	:
-	str(txt)
+namespace {
+
+inline bool
+isSpace(char c)
 {
-	stok="";
-	ntok=0.0;
-	iter=str.begin();
+	return c == ' ' || c == '\n' || c == '\r' || c == '\t';
 }
 
-double strtod_with_vc_fix(const char * str, char ** str_end)
+inline bool
+isDelimiter(char c)
+{
+	return isSpace(c) || c == '(' || c == ')' || c == ',';
+}
+
+} // anonymous namespace
+
+/*public*/
+StringTokenizer::StringTokenizer(const string &txt)
+	:
+	str(txt),
+	iter(str.data()),
+	end(str.data() + str.size()),
+	peeked(false),
+	peekedType(TT_EOF),
+	peekedEnd(iter),
+	ntok(0.0)
 {
-	double dbl = strtod(str, str_end);
-#if _MSC_VER && !__INTEL_COMPILER
-	// Special handling of NAN and INF in MSVC, where strtod returns 0.0
-	// for NAN and INF.		
-	// This fixes failing test GEOSisValidDetail::test<3>, maybe others
-	// as well.
-	// Note: this hack is not robust, Boost lexical_cast or
-	// std::stod (C++11) would be better.
-	if (*str_end[0] != '\0')
-	{
-		char sign = 0;
-		const char *pos = str;
-		if (*pos == '+' || *pos == '-')
-			sign = *pos++;
-
-		if (stricmp(pos, "inf") == 0)
-		{
-			if (!sign || sign == '+')
-				dbl = std::numeric_limits<double>::infinity();
-			else
-				dbl = -(std::numeric_limits<double>::infinity)();
-			*str_end[0] = '\0';
-		}
-		else if (stricmp(pos, "nan") == 0)
-		{
-			dbl = std::numeric_limits<double>::quiet_NaN();
-			*str_end[0] = '\0';
-		}
-	}
-#endif
-	return dbl;
 }
 
 /*public*/
 int
 StringTokenizer::nextToken()
 {
-	string tok="";
-	if (iter==str.end())
-		return StringTokenizer::TT_EOF;
-	switch(*iter) {
-		case '(':
-		case ')':
-		case ',':
-			return *iter++;
-		case '\n':
-		case '\r':
-		case '\t':
-		case ' ':
-			string::size_type pos=str.find_first_not_of(" \n\r\t",
-				iter-str.begin());
-			if (pos==string::npos) {
-				return StringTokenizer::TT_EOF;
-			} else {
-				iter=str.begin()+pos;
-				return nextToken();
-			}
-	}
-	string::size_type pos=str.find_first_of("\n\r\t() ,",
-		iter-str.begin());
-	if (pos==string::npos) {
-		if (iter!=str.end()) {
-			tok.assign(iter,str.end());
-			iter=str.end();
-		} else {
-			return StringTokenizer::TT_EOF;
-		}
-	} else {
-		tok.assign(iter, str.begin()+pos);
-		iter=str.begin()+pos;
-	}
-	char *stopstring;
-	double dbl=strtod_with_vc_fix(tok.c_str(),&stopstring);
-	if (*stopstring=='\0') {
-		ntok=dbl;
-		stok="";
-		return StringTokenizer::TT_NUMBER;
-	} else {
-		ntok=0.0;
-		stok=tok;
-		return StringTokenizer::TT_WORD;
-	}
+	int type=peekNextToken();
+	iter=peekedEnd;
+	peeked=false;
+	return type;
 }
 
 /*public*/
 int
 StringTokenizer::peekNextToken()
 {
+	if (peeked) return peekedType;
+	peeked=true;
 
-	string::size_type pos;
-	string tok="";
-	if (iter==str.end())
-		return StringTokenizer::TT_EOF;
+	const char *p=iter;
+	while (p!=end && isSpace(*p)) ++p;
 
-	pos=str.find_first_not_of(" \r\n\t", iter-str.begin());
+	if (p==end) {
+		peekedEnd=p;
+		return peekedType=StringTokenizer::TT_EOF;
+	}
 
-	if (pos==string::npos) return StringTokenizer::TT_EOF;
-	switch(str[pos]) {
+	switch(*p) {
 		case '(':
 		case ')':
 		case ',':
-			return str[pos];
+			peekedEnd=p+1;
+			return peekedType=*p;
 	}
 
 	// It's either a Number or a Word, let's
 	// see when it ends
+	const char *q=p;
+	while (q!=end && !isDelimiter(*q)) ++q;
+	peekedEnd=q;
 
-	pos=str.find_first_of("\n\r\t() ,", iter-str.begin());
-
-	if (pos==string::npos) {
-		if (iter!=str.end()) {
-			tok.assign(iter,str.end());
-		} else {
-			return StringTokenizer::TT_EOF;
-		}
-	} else {
-		tok.assign(iter, str.begin()+pos); //str.end());
-	}
-
-	char *stopstring;
-	double dbl = strtod_with_vc_fix(tok.c_str(), &stopstring);
-	if (*stopstring=='\0') {
-		ntok=dbl;
-		stok="";
-		return StringTokenizer::TT_NUMBER;
-	} else {
-		ntok=0.0;
-		stok=tok;
-		return StringTokenizer::TT_WORD;
+	if (DoubleConversion::parse(p, q, ntok)) {
+		stok.clear();
+		return peekedType=StringTokenizer::TT_NUMBER;
 	}
+	ntok=0.0;
+	stok.assign(p, q);
+	return peekedType=StringTokenizer::TT_WORD;
 }
 
 /*public*/
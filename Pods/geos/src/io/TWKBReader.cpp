@@ -0,0 +1,446 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/io/TWKBReader.h>
+#include <geos/io/TWKBConstants.h>
+#include <geos/io/ParseException.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/CoordinateSequenceFactory.h>
+#include <geos/geom/Point.h>
+#include <geos/geom/LinearRing.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/Polygon.h>
+#include <geos/geom/MultiPoint.h>
+#include <geos/geom/MultiLineString.h>
+#include <geos/geom/MultiPolygon.h>
+#include <geos/geom/PrecisionModel.h>
+#include <geos/util/IllegalArgumentException.h>
+
+#include <memory>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+using namespace geos::geom;
+
+namespace geos {
+namespace io { // geos.io
+
+namespace {
+
+typedef unsigned long long uint64;
+
+const double POW10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8
+};
+
+// Deeper collections are taken as corrupt, rather than risking the
+// stack on them
+const int MAX_NESTING = 256;
+
+// Turns integers back into ordinates with precision decimal digits
+class Descale {
+
+public:
+
+	Descale(int precision)
+		:
+		factor(POW10[precision < 0 ? -precision : precision]),
+		multiply(precision < 0)
+	{}
+
+	double operator()(int64 v) const
+	{
+		double d = static_cast<double>(v);
+		return multiply ? d * factor : d / factor;
+	}
+
+private:
+
+	double factor;
+	bool multiply;
+};
+
+// The header of a geometry, and its last position read
+struct GeometryState {
+
+	GeometryState(int precision, int precisionZ, bool z, bool m)
+		:
+		xy(precision),
+		zScale(precisionZ),
+		hasZ(z),
+		dims(2 + z + m)
+	{
+		for (int i=0; i<4; ++i) last[i] = 0;
+	}
+
+	Descale xy;
+	Descale zScale;
+	bool hasZ;
+	int dims;
+	int64 last[4];
+};
+
+// Owns the geometries until they are given to the factory
+class GeometryList {
+
+public:
+
+	GeometryList() : geoms(new vector<Geometry *>()) {}
+
+	~GeometryList()
+	{
+		if ( ! geoms ) return;
+		for (size_t i=0, n=geoms->size(); i<n; ++i)
+			delete (*geoms)[i];
+		delete geoms;
+	}
+
+	void reserve(size_t n) { geoms->reserve(n); }
+
+	void add(Geometry *g)
+	{
+		auto_ptr<Geometry> owned(g);
+		geoms->push_back(g);
+		owned.release();
+	}
+
+	vector<Geometry *> *release()
+	{
+		vector<Geometry *> *ret = geoms;
+		geoms = 0;
+		return ret;
+	}
+
+private:
+
+	vector<Geometry *> *geoms;
+
+	// Declare type as noncopyable
+	GeometryList(const GeometryList& other);
+	GeometryList& operator=(const GeometryList& rhs);
+};
+
+// Reads one buffer in a single pass
+class Parser {
+
+public:
+
+	Parser(const GeometryFactory &f, const unsigned char *buf,
+			size_t size, vector<int64> *idsOut)
+		:
+		factory(f),
+		pm(*f.getPrecisionModel()),
+		data(buf),
+		dataEnd(buf + size),
+		ids(idsOut),
+		depth(0)
+	{}
+
+	Geometry *parse();
+
+private:
+
+	const GeometryFactory &factory;
+
+	const PrecisionModel &pm;
+
+	const unsigned char *data;
+
+	const unsigned char *dataEnd;
+
+	// for the outermost geometry only
+	vector<int64> *ids;
+
+	int depth;
+
+	Geometry *readGeometry();
+
+	unsigned char readByte()
+	{
+		if ( data == dataEnd )
+			throw ParseException("Unexpected EOF parsing TWKB");
+		return *data++;
+	}
+
+	uint64 readVarint()
+	{
+		uint64 v = 0;
+		for (int shift=0; ; shift+=7)
+		{
+			if ( shift > 63 )
+				throw ParseException("Varint too long in TWKB");
+			unsigned char b = readByte();
+			v |= static_cast<uint64>(b & 0x7F) << shift;
+			if ( ! (b & 0x80) ) return v;
+		}
+	}
+
+	int64 readSignedVarint()
+	{
+		uint64 u = readVarint();
+		return static_cast<int64>((u >> 1) ^ (0 - (u & 1)));
+	}
+
+	// A count of items, each taking at least itemSize bytes
+	size_t readCount(size_t itemSize)
+	{
+		uint64 n = readVarint();
+		if ( n > static_cast<uint64>(dataEnd - data) / itemSize )
+			throw ParseException("Unexpected EOF parsing TWKB");
+		return static_cast<size_t>(n);
+	}
+
+	void readPosition(GeometryState &s, Coordinate &c)
+	{
+		for (int i=0; i<s.dims; ++i)
+		{
+			// wraps rather than overflows on corrupt input
+			s.last[i] = static_cast<int64>(static_cast<uint64>(s.last[i]) +
+				static_cast<uint64>(readSignedVarint()));
+		}
+		c.x = pm.makePrecise(s.xy(s.last[0]));
+		c.y = pm.makePrecise(s.xy(s.last[1]));
+		if ( s.hasZ ) c.z = s.zScale(s.last[2]);
+	}
+
+	void readIds(size_t n, vector<int64> *geomIds)
+	{
+		if ( geomIds ) geomIds->reserve(n);
+		for (size_t i=0; i<n; ++i)
+		{
+			int64 id = readSignedVarint();
+			if ( geomIds ) geomIds->push_back(id);
+		}
+	}
+
+	CoordinateSequence *readSequence(GeometryState &s);
+
+	Polygon *readPolygon(GeometryState &s);
+
+	Geometry *createEmpty(int type);
+};
+
+/*public*/
+Geometry *
+Parser::parse()
+{
+	try
+	{
+		return readGeometry();
+	}
+	catch (const util::IllegalArgumentException &e)
+	{
+		// the factory refused what was read, e.g. an unclosed ring
+		throw ParseException(e.what());
+	}
+}
+
+/*private*/
+Geometry *
+Parser::readGeometry()
+{
+	using namespace TWKBConstants;
+
+	unsigned char typeByte = readByte();
+	int type = typeByte & 0x0F;
+	int zigzagPrecision = typeByte >> 4;
+	int precision = (zigzagPrecision & 1) ?
+		-(zigzagPrecision >> 1) - 1 : zigzagPrecision >> 1;
+
+	unsigned char metadata = readByte();
+	bool hasZ = false, hasM = false;
+	int precisionZ = 0;
+	if ( metadata & twkbExtendedDims )
+	{
+		unsigned char ext = readByte();
+		hasZ = ( ext & twkbHasZ ) != 0;
+		hasM = ( ext & twkbHasM ) != 0;
+		precisionZ = ( ext >> 2 ) & 0x07;
+	}
+
+	// only needed to skip the geometry
+	if ( metadata & twkbSize ) readCount(1);
+
+	vector<int64> *geomIds = ids;
+	ids = 0;
+	if ( geomIds ) geomIds->clear();
+
+	if ( metadata & twkbEmpty ) return createEmpty(type);
+
+	GeometryState s(precision, precisionZ, hasZ, hasM);
+
+	if ( metadata & twkbBBox )
+	{
+		for (int i=0; i<2*s.dims; ++i) readVarint();
+	}
+
+	switch (type)
+	{
+		case twkbPoint:
+		{
+			Coordinate c;
+			readPosition(s, c);
+			return factory.createPoint(c);
+		}
+
+		case twkbLineString:
+			return factory.createLineString(readSequence(s));
+
+		case twkbPolygon:
+			return readPolygon(s);
+
+		case twkbMultiPoint:
+		{
+			size_t n = readCount(s.dims);
+			if ( metadata & twkbIdList ) readIds(n, geomIds);
+			GeometryList geoms;
+			geoms.reserve(n);
+			for (size_t i=0; i<n; ++i)
+			{
+				Coordinate c;
+				readPosition(s, c);
+				geoms.add(factory.createPoint(c));
+			}
+			return factory.createMultiPoint(geoms.release());
+		}
+
+		case twkbMultiLineString:
+		{
+			size_t n = readCount(1);
+			if ( metadata & twkbIdList ) readIds(n, geomIds);
+			GeometryList geoms;
+			geoms.reserve(n);
+			for (size_t i=0; i<n; ++i)
+				geoms.add(factory.createLineString(readSequence(s)));
+			return factory.createMultiLineString(geoms.release());
+		}
+
+		case twkbMultiPolygon:
+		{
+			size_t n = readCount(1);
+			if ( metadata & twkbIdList ) readIds(n, geomIds);
+			GeometryList geoms;
+			geoms.reserve(n);
+			for (size_t i=0; i<n; ++i)
+				geoms.add(readPolygon(s));
+			return factory.createMultiPolygon(geoms.release());
+		}
+
+		case twkbGeometryCollection:
+		{
+			size_t n = readCount(2); // type and metadata of each
+			if ( metadata & twkbIdList ) readIds(n, geomIds);
+			if ( ++depth > MAX_NESTING )
+				throw ParseException("TWKB collections nested too deep");
+			GeometryList geoms;
+			geoms.reserve(n);
+			for (size_t i=0; i<n; ++i)
+				geoms.add(readGeometry());
+			--depth;
+			return factory.createGeometryCollection(geoms.release());
+		}
+	}
+
+	stringstream err;
+	err << "Unknown TWKB type " << type;
+	throw ParseException(err.str());
+}
+
+/*private*/
+CoordinateSequence *
+Parser::readSequence(GeometryState &s)
+{
+	size_t n = readCount(s.dims);
+	auto_ptr< vector<Coordinate> > coords(new vector<Coordinate>(n));
+	for (size_t i=0; i<n; ++i)
+		readPosition(s, (*coords)[i]);
+
+	// takes ownership of coords
+	return factory.getCoordinateSequenceFactory()->create(coords.release(),
+			s.hasZ ? 3 : 2);
+}
+
+/*private*/
+Polygon *
+Parser::readPolygon(GeometryState &s)
+{
+	size_t numRings = readCount(1); // point count of each
+	if ( ! numRings ) return factory.createPolygon();
+
+	auto_ptr<LinearRing> shell(factory.createLinearRing(readSequence(s)));
+	GeometryList holes;
+	holes.reserve(numRings - 1);
+	for (size_t i=1; i<numRings; ++i)
+		holes.add(factory.createLinearRing(readSequence(s)));
+
+	// takes ownership of shell and holes
+	Polygon *p = factory.createPolygon(shell.get(), holes.release());
+	shell.release();
+	return p;
+}
+
+/*private*/
+Geometry *
+Parser::createEmpty(int type)
+{
+	using namespace TWKBConstants;
+
+	switch (type)
+	{
+		case twkbPoint:
+			return factory.createPoint();
+		case twkbLineString:
+			return factory.createLineString();
+		case twkbPolygon:
+			return factory.createPolygon();
+		case twkbMultiPoint:
+			return factory.createMultiPoint();
+		case twkbMultiLineString:
+			return factory.createMultiLineString();
+		case twkbMultiPolygon:
+			return factory.createMultiPolygon();
+		case twkbGeometryCollection:
+			return factory.createGeometryCollection();
+	}
+
+	stringstream err;
+	err << "Unknown TWKB type " << type;
+	throw ParseException(err.str());
+}
+
+} // anonymous namespace
+
+TWKBReader::TWKBReader()
+	:
+	factory(*(GeometryFactory::getDefaultInstance()))
+{}
+
+Geometry *
+TWKBReader::read(const unsigned char *buf, size_t size)
+{
+	Parser parser(factory, buf, size, 0);
+	return parser.parse();
+}
+
+Geometry *
+TWKBReader::read(const unsigned char *buf, size_t size, vector<int64> &ids)
+{
+	ids.clear();
+	Parser parser(factory, buf, size, &ids);
+	return parser.parse();
+}
+
+} // namespace geos.io
+} // namespace geos
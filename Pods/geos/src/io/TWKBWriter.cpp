@@ -0,0 +1,476 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/io/TWKBWriter.h>
+#include <geos/io/TWKBConstants.h>
+#include <geos/util/IllegalArgumentException.h>
+#include <geos/util/math.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryCollection.h>
+#include <geos/geom/Point.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/Polygon.h>
+#include <geos/geom/MultiPoint.h>
+#include <geos/geom/MultiLineString.h>
+#include <geos/geom/MultiPolygon.h>
+#include <geos/platform.h> // for int64, ISNAN, FINITE
+
+#include <vector>
+#include <cmath>
+#include <cassert>
+
+using namespace std;
+using namespace geos::geom;
+
+namespace geos {
+namespace io { // geos.io
+
+namespace {
+
+typedef unsigned long long uint64;
+
+// Scaled ordinates stay below this, so that their differences fit
+// in an int64
+const double MAX_SCALED = 4611686018427387904.0; // 2^62
+
+const double POW10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8
+};
+
+void
+appendVarint(uint64 v, vector<unsigned char> &buf)
+{
+	while ( v >= 0x80 )
+	{
+		buf.push_back(static_cast<unsigned char>(v | 0x80));
+		v >>= 7;
+	}
+	buf.push_back(static_cast<unsigned char>(v));
+}
+
+// zig-zag encoding: 0, -1, 1, -2... as 0, 1, 2, 3...
+void
+appendSignedVarint(int64 v, vector<unsigned char> &buf)
+{
+	uint64 u = static_cast<uint64>(v) << 1;
+	appendVarint(v < 0 ? ~u : u, buf);
+}
+
+// Rounds d to precision decimal digits, as an integer
+class Scale {
+
+public:
+
+	Scale(int precision)
+		:
+		factor(POW10[precision < 0 ? -precision : precision]),
+		divide(precision < 0)
+	{}
+
+	int64 operator()(double d) const
+	{
+		if ( ! FINITE(d) )
+		{
+			throw util::IllegalArgumentException(
+				"TWKB cannot represent infinite or NaN coordinates");
+		}
+		double r = util::round(divide ? d / factor : d * factor);
+		if ( std::fabs(r) >= MAX_SCALED )
+		{
+			throw util::IllegalArgumentException(
+				"Coordinate too large for the TWKB precision");
+		}
+		return static_cast<int64>(r);
+	}
+
+private:
+
+	double factor;
+	bool divide;
+};
+
+int
+geometryType(const Geometry &g)
+{
+	using namespace TWKBConstants;
+
+	switch ( g.getGeometryTypeId() )
+	{
+		case GEOS_POINT: return twkbPoint;
+		case GEOS_LINESTRING:
+		case GEOS_LINEARRING: return twkbLineString;
+		case GEOS_POLYGON: return twkbPolygon;
+		case GEOS_MULTIPOINT: return twkbMultiPoint;
+		case GEOS_MULTILINESTRING: return twkbMultiLineString;
+		case GEOS_MULTIPOLYGON: return twkbMultiPolygon;
+		case GEOS_GEOMETRYCOLLECTION: return twkbGeometryCollection;
+	}
+	assert(0); // Unsupported Geometry implementation
+	return twkbGeometryCollection;
+}
+
+// Writes one TWKB geometry: its header, then its coordinates, each
+// as the difference from the previous one. Components of collections
+// get their own encoder, as they have their own header.
+class GeometryEncoder {
+
+public:
+
+	GeometryEncoder(const TWKBWriter &w)
+		:
+		writer(w),
+		scaleXY(w.getPrecision()),
+		scaleZ(w.getPrecisionZ()),
+		dims(2),
+		body(0),
+		hasBounds(false)
+	{
+		for (int i=0; i<3; ++i) last[i] = minVal[i] = maxVal[i] = 0;
+	}
+
+	void encode(const Geometry &g, const vector<int64> *ids,
+			vector<unsigned char> &buf);
+
+	/// Writes one position, for CoordinateSequence::forEachCoordinate
+	void operator()(const Coordinate &c)
+	{
+		int64 v[3];
+		v[0] = scaleXY(c.x);
+		v[1] = scaleXY(c.y);
+		if ( dims > 2 ) v[2] = ISNAN(c.z) ? 0 : scaleZ(c.z);
+
+		for (int i=0; i<dims; ++i)
+		{
+			appendSignedVarint(v[i] - last[i], *body);
+			last[i] = v[i];
+		}
+
+		if ( ! writer.getIncludeBBox() ) return;
+		if ( ! hasBounds )
+		{
+			for (int i=0; i<dims; ++i) minVal[i] = maxVal[i] = v[i];
+			hasBounds = true;
+			return;
+		}
+		for (int i=0; i<dims; ++i)
+		{
+			if ( v[i] < minVal[i] ) minVal[i] = v[i];
+			else if ( v[i] > maxVal[i] ) maxVal[i] = v[i];
+		}
+	}
+
+private:
+
+	const TWKBWriter &writer;
+
+	Scale scaleXY;
+
+	Scale scaleZ;
+
+	int dims;
+
+	vector<unsigned char> *body;
+
+	int64 last[3];
+
+	bool hasBounds;
+
+	int64 minVal[3];
+
+	int64 maxVal[3];
+
+	void writeBody(const Geometry &g, const vector<int64> *ids);
+
+	void writeSequence(const CoordinateSequence &seq)
+	{
+		appendVarint(seq.getSize(), *body);
+		seq.forEachCoordinate(*this);
+	}
+
+	void writePolygonRings(const Polygon &p)
+	{
+		if ( p.isEmpty() )
+		{
+			appendVarint(0, *body);
+			return;
+		}
+		size_t nHoles = p.getNumInteriorRing();
+		appendVarint(nHoles + 1, *body);
+		writeSequence(*p.getExteriorRing()->getCoordinatesRO());
+		for (size_t i=0; i<nHoles; ++i)
+			writeSequence(*p.getInteriorRingN(i)->getCoordinatesRO());
+	}
+
+	void expandBounds(const GeometryEncoder &component);
+};
+
+/*public*/
+void
+GeometryEncoder::encode(const Geometry &g, const vector<int64> *ids,
+		vector<unsigned char> &buf)
+{
+	using namespace TWKBConstants;
+
+	bool hasZ = writer.getOutputDimension() == 3 &&
+	            g.getCoordinateDimension() == 3;
+	dims = hasZ ? 3 : 2;
+	bool empty = g.isEmpty();
+
+	unsigned char metadata = 0;
+	if ( hasZ ) metadata |= twkbExtendedDims;
+	if ( empty )
+	{
+		metadata |= twkbEmpty;
+	}
+	else
+	{
+		if ( writer.getIncludeBBox() ) metadata |= twkbBBox;
+		if ( writer.getIncludeSize() ) metadata |= twkbSize;
+		if ( ids ) metadata |= twkbIdList;
+	}
+
+	// precision is zig-zag encoded in the high 4 bits
+	int p = writer.getPrecision();
+	int zigzagPrecision = p < 0 ? -2 * p - 1 : 2 * p;
+	buf.push_back(static_cast<unsigned char>(
+		geometryType(g) | zigzagPrecision << 4));
+	buf.push_back(metadata);
+	if ( hasZ )
+	{
+		buf.push_back(static_cast<unsigned char>(
+			twkbHasZ | writer.getPrecisionZ() << 2));
+	}
+	if ( empty ) return;
+
+	if ( ! ( metadata & (twkbBBox | twkbSize) ) )
+	{
+		body = &buf;
+		writeBody(g, ids);
+		return;
+	}
+
+	// The bounding box and the size come before the coordinates
+	// they depend on
+	vector<unsigned char> bodyBuf;
+	body = &bodyBuf;
+	writeBody(g, ids);
+
+	vector<unsigned char> bbox;
+	if ( metadata & twkbBBox )
+	{
+		for (int i=0; i<dims; ++i)
+		{
+			appendSignedVarint(minVal[i], bbox);
+			appendSignedVarint(maxVal[i] - minVal[i], bbox);
+		}
+	}
+	if ( metadata & twkbSize )
+		appendVarint(bbox.size() + bodyBuf.size(), buf);
+	buf.insert(buf.end(), bbox.begin(), bbox.end());
+	buf.insert(buf.end(), bodyBuf.begin(), bodyBuf.end());
+}
+
+/*private*/
+void
+GeometryEncoder::writeBody(const Geometry &g, const vector<int64> *ids)
+{
+	const GeometryCollection *gc =
+		dynamic_cast<const GeometryCollection *>(&g);
+	if ( gc )
+	{
+		size_t n = gc->getNumGeometries();
+		appendVarint(n, *body);
+		if ( ids )
+		{
+			for (size_t i=0; i<n; ++i)
+				appendSignedVarint((*ids)[i], *body);
+		}
+	}
+
+	switch ( geometryType(g) )
+	{
+		case TWKBConstants::twkbPoint:
+			(*this)(*g.getCoordinate());
+			break;
+
+		case TWKBConstants::twkbLineString:
+			writeSequence(*dynamic_cast<const LineString &>(g)
+					.getCoordinatesRO());
+			break;
+
+		case TWKBConstants::twkbPolygon:
+			writePolygonRings(dynamic_cast<const Polygon &>(g));
+			break;
+
+		case TWKBConstants::twkbMultiPoint:
+			for (size_t i=0, n=gc->getNumGeometries(); i<n; ++i)
+			{
+				const Coordinate *c = gc->getGeometryN(i)->getCoordinate();
+				if ( ! c )
+				{
+					throw util::IllegalArgumentException(
+						"Empty Points cannot be represented in TWKB MultiPoints");
+				}
+				(*this)(*c);
+			}
+			break;
+
+		case TWKBConstants::twkbMultiLineString:
+			for (size_t i=0, n=gc->getNumGeometries(); i<n; ++i)
+			{
+				writeSequence(*dynamic_cast<const LineString *>(
+					gc->getGeometryN(i))->getCoordinatesRO());
+			}
+			break;
+
+		case TWKBConstants::twkbMultiPolygon:
+			for (size_t i=0, n=gc->getNumGeometries(); i<n; ++i)
+			{
+				writePolygonRings(*dynamic_cast<const Polygon *>(
+					gc->getGeometryN(i)));
+			}
+			break;
+
+		case TWKBConstants::twkbGeometryCollection:
+			for (size_t i=0, n=gc->getNumGeometries(); i<n; ++i)
+			{
+				GeometryEncoder component(writer);
+				component.encode(*gc->getGeometryN(i), 0, *body);
+				expandBounds(component);
+			}
+			break;
+	}
+}
+
+/*private*/
+void
+GeometryEncoder::expandBounds(const GeometryEncoder &component)
+{
+	if ( ! component.hasBounds ) return;
+	if ( ! hasBounds )
+	{
+		// z of 2D components is taken as 0
+		for (int i=0; i<3; ++i)
+		{
+			minVal[i] = component.minVal[i];
+			maxVal[i] = component.maxVal[i];
+		}
+		hasBounds = true;
+		return;
+	}
+	for (int i=0; i<3; ++i)
+	{
+		if ( component.minVal[i] < minVal[i] ) minVal[i] = component.minVal[i];
+		if ( component.maxVal[i] > maxVal[i] ) maxVal[i] = component.maxVal[i];
+	}
+}
+
+} // anonymous namespace
+
+TWKBWriter::TWKBWriter(int dims, int prec)
+	:
+	defaultOutputDimension(2),
+	precision(0),
+	precisionZ(0),
+	includeBBox(false),
+	includeSize(false)
+{
+	setOutputDimension(dims);
+	setPrecision(prec);
+}
+
+TWKBWriter::~TWKBWriter()
+{
+}
+
+/*public*/
+void
+TWKBWriter::setOutputDimension(int dims)
+{
+	if ( dims < 2 || dims > 3 )
+		throw util::IllegalArgumentException("TWKB output dimension must be 2 or 3");
+	defaultOutputDimension = dims;
+}
+
+/*public*/
+void
+TWKBWriter::setPrecision(int newPrecision)
+{
+	if ( newPrecision < TWKBConstants::twkbMinPrecision ||
+	     newPrecision > TWKBConstants::twkbMaxPrecision )
+	{
+		throw util::IllegalArgumentException("TWKB precision must be from -8 to 7");
+	}
+	precision = newPrecision;
+}
+
+/*public*/
+void
+TWKBWriter::setPrecisionZ(int newPrecisionZ)
+{
+	if ( newPrecisionZ < 0 ||
+	     newPrecisionZ > TWKBConstants::twkbMaxExtendedPrecision )
+	{
+		throw util::IllegalArgumentException("TWKB z precision must be from 0 to 7");
+	}
+	precisionZ = newPrecisionZ;
+}
+
+/*public*/
+void
+TWKBWriter::write(const Geometry &g, vector<unsigned char> &buf)
+{
+	size_t start = buf.size();
+	try
+	{
+		GeometryEncoder encoder(*this);
+		encoder.encode(g, 0, buf);
+	}
+	catch (...)
+	{
+		buf.resize(start);
+		throw;
+	}
+}
+
+/*public*/
+void
+TWKBWriter::write(const Geometry &g, const vector<int64> &ids,
+		vector<unsigned char> &buf)
+{
+	if ( ! dynamic_cast<const GeometryCollection *>(&g) )
+	{
+		throw util::IllegalArgumentException(
+			"TWKB id lists are for collections only");
+	}
+	if ( ids.size() != g.getNumGeometries() )
+	{
+		throw util::IllegalArgumentException(
+			"TWKB id list must have one id per component");
+	}
+	size_t start = buf.size();
+	try
+	{
+		GeometryEncoder encoder(*this);
+		encoder.encode(g, &ids, buf);
+	}
+	catch (...)
+	{
+		buf.resize(start);
+		throw;
+	}
+}
+
+} // namespace geos.io
+} // namespace geos
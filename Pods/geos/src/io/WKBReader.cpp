@@ -230,6 +230,13 @@ WKBReader::read(istream &is)
 	return readGeometry();
 }
 
+Geometry *
+WKBReader::read(const unsigned char *buf, size_t size)
+{
+	dis.setInBuffer(buf, size); // will default to machine endian
+	return readGeometry();
+}
+
 Geometry *
 WKBReader::readGeometry()
 {
@@ -350,6 +357,7 @@ Polygon *
 WKBReader::readPolygon()
 {
 	int numRings = dis.readInt();
+	dis.checkAvailable(numRings, 4); // point count of each
 
 #if DEBUG_WKB_READER
 	cout<<"WKB numRings: "<<numRings<<endl;
@@ -381,6 +389,7 @@ MultiPoint *
 WKBReader::readMultiPoint()
 {
 	int numGeoms = dis.readInt();
+	dis.checkAvailable(numGeoms, 5); // byte order and type of each
 	vector<Geometry *> *geoms = new vector<Geometry *>(numGeoms);
 
 	try {
@@ -408,6 +417,7 @@ MultiLineString *
 WKBReader::readMultiLineString()
 {
 	int numGeoms = dis.readInt();
+	dis.checkAvailable(numGeoms, 5); // byte order and type of each
 	vector<Geometry *> *geoms = new vector<Geometry *>(numGeoms);
 
 	try {
@@ -435,6 +445,7 @@ MultiPolygon *
 WKBReader::readMultiPolygon()
 {
 	int numGeoms = dis.readInt();
+	dis.checkAvailable(numGeoms, 5); // byte order and type of each
 	vector<Geometry *> *geoms = new vector<Geometry *>(numGeoms);
 
 	try {
@@ -462,6 +473,7 @@ GeometryCollection *
 WKBReader::readGeometryCollection()
 {
 	int numGeoms = dis.readInt();
+	dis.checkAvailable(numGeoms, 5); // byte order and type of each
 	vector<Geometry *> *geoms = new vector<Geometry *>(numGeoms);
 
 	try {
@@ -479,17 +491,30 @@ WKBReader::readGeometryCollection()
 CoordinateSequence *
 WKBReader::readCoordinateSequence(int size)
 {
-	CoordinateSequence *seq = factory.getCoordinateSequenceFactory()->create(size, inputDimension);
-	unsigned int targetDim = seq->getDimension();
-	if ( targetDim > inputDimension )
-		targetDim = inputDimension;
-	for (int i=0; i<size; i++) {
-		readCoordinate();
-		for (unsigned int j=0; j<targetDim; j++) {
-			seq->setOrdinate(i, j, ordValues[j]);
-		}
+	if ( size < 0 )
+		throw ParseException("Negative number of points in WKB");
+	dis.checkAvailable(size, 8 * inputDimension);
+
+	// Read all ordinates at once, rather than one by one
+	size_t n = size;
+	size_t nOrds = n * inputDimension;
+	if ( ordValues.size() < nOrds )
+		ordValues.resize(nOrds);
+	if ( nOrds ) dis.readDoubles(&ordValues[0], nOrds);
+
+	const PrecisionModel &pm = *factory.getPrecisionModel();
+	vector<Coordinate> *coords = new vector<Coordinate>(n);
+	for (size_t i=0; i<n; ++i)
+	{
+		const double *o = &ordValues[i * inputDimension];
+		Coordinate &c = (*coords)[i];
+		c.x = pm.makePrecise(o[0]);
+		c.y = pm.makePrecise(o[1]);
+		if ( inputDimension > 2 ) c.z = o[2];
 	}
-	return seq;
+
+	// takes ownership of coords
+	return factory.getCoordinateSequenceFactory()->create(coords, inputDimension);
 }
 
 void
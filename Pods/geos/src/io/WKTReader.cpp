@@ -20,7 +20,6 @@
 #include <geos/io/WKTReader.h>
 #include <geos/io/StringTokenizer.h>
 #include <geos/io/ParseException.h>
-#include <geos/io/CLocalizer.h>
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/Point.h>
@@ -37,6 +36,8 @@
 
 #include <sstream>
 #include <string>
+#include <vector>
+#include <memory>
 #include <cassert>
 
 #ifndef GEOS_DEBUG
@@ -61,7 +62,6 @@ Geometry *
 WKTReader::read(const string &wellKnownText)
 {
 	//auto_ptr<StringTokenizer> tokenizer(new StringTokenizer(wellKnownText));
-        CLocalizer clocale;
 	StringTokenizer tokenizer(wellKnownText);
 	Geometry *g=NULL;
 	g=readGeometryTaggedText(&tokenizer);
@@ -81,22 +81,21 @@ WKTReader::getCoordinates(StringTokenizer *tokenizer)
 	Coordinate coord;
 	getPreciseCoordinate(tokenizer, coord, dim);
 
-	CoordinateSequence *coordinates = \
-            geometryFactory->getCoordinateSequenceFactory()->create((size_t)0,dim);
-	coordinates->add(coord);
-	try {
+	// The dimension is that of the first point
+	size_t seqDim=dim;
+
+	// Collect the points in a vector, which the sequence takes
+	auto_ptr< vector<Coordinate> > coords(new vector<Coordinate>());
+	coords->push_back(coord);
+	nextToken=getNextCloserOrComma(tokenizer);
+	while (nextToken==",") {
+		getPreciseCoordinate(tokenizer, coord, dim );
+		coords->push_back(coord);
 		nextToken=getNextCloserOrComma(tokenizer);
-		while (nextToken==",") {
-			getPreciseCoordinate(tokenizer, coord, dim );
-			coordinates->add(coord);
-			nextToken=getNextCloserOrComma(tokenizer);
-		}
-	} catch (...) {
-		delete coordinates;
-		throw;
 	}
 
-	return coordinates;
+	return geometryFactory->getCoordinateSequenceFactory()->create(
+			coords.release(), seqDim);
 }
 
 void
@@ -204,7 +203,9 @@ WKTReader::getNextWord(StringTokenizer *tokenizer)
 
             while( --i >= 0 )
             {
-                word[i] = static_cast<char>(toupper(word[i]));
+                // ASCII only: toupper() depends on the locale
+                if ( word[i] >= 'a' && word[i] <= 'z' )
+                    word[i] = static_cast<char>(word[i] - 'a' + 'A');
             }
 			return word;
         }
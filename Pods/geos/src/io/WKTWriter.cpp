@@ -21,7 +21,7 @@
 #include <geos/platform.h>
 #include <geos/io/WKTWriter.h>
 #include <geos/io/Writer.h>
-#include <geos/io/CLocalizer.h>
+#include <geos/io/DoubleConversion.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/Point.h>
 #include <geos/geom/LinearRing.h>
@@ -36,12 +36,13 @@
 
 #include <algorithm> // for min
 #include <typeinfo>
-#include <cstdio> // should avoid this
+#include <cstdio> // for sprintf
 #include <string>
 #include <sstream>
+#include <locale>
+#include <vector>
 #include <cassert>
 #include <cmath>
-#include <iomanip>
 
 using namespace std;
 using namespace geos::geom;
@@ -49,11 +50,58 @@ using namespace geos::geom;
 namespace geos {
 namespace io { // geos.io
 
+namespace {
+
+/*
+ * Writes d with printf() and the given format, which has a precision
+ * argument. printf() takes the decimal point of LC_NUMERIC, so
+ * whatever separates the integer and the fraction digits is replaced
+ * with '.'.
+ */
+void
+printNumber(const char *format, int precision, double d, Writer *writer)
+{
+	// %f of DBL_MAX has 309 integer digits
+	char buf[350];
+	std::vector<char> bigBuf;
+	char *str = buf;
+	if ( precision > 20 )
+	{
+		bigBuf.resize(330 + precision);
+		str = &bigBuf[0];
+	}
+	int n = std::sprintf(str, format, precision, d);
+	if ( n < 0 ) return;
+
+	char *p = str;
+	char *end = str + n;
+	if ( p != end && *p == '-' ) ++p;
+	if ( p == end || *p < '0' || *p > '9' )
+	{
+		// inf or nan
+		writer->write(str, n);
+		return;
+	}
+	while ( p != end && *p >= '0' && *p <= '9' ) ++p;
+	char *sep = p;
+	while ( p != end && ( *p < '0' || *p > '9' ) && *p != 'e' ) ++p;
+	if ( p != sep && p != end && *p != 'e' )
+	{
+		writer->write(str, sep - str);
+		writer->write(".", 1);
+		writer->write(p, end - p);
+	}
+	else writer->write(str, n);
+}
+
+} // anonymous namespace
+
 WKTWriter::WKTWriter():
   decimalPlaces(6),
 	isFormatted(false),
 	roundingPrecision(-1),
 	trim(false),
+	shortestNumbers(false),
 	level(0),
 	defaultOutputDimension(2),
 	old3D(false)
@@ -76,6 +124,7 @@ string
 WKTWriter::toLineString(const CoordinateSequence& seq)
 {
 	stringstream buf(ios_base::in|ios_base::out);
+	buf.imbue(std::locale::classic());
     buf << "LINESTRING ";
 	unsigned int npts = seq.getSize();
 	if ( npts == 0 )
@@ -104,6 +153,7 @@ string
 WKTWriter::toLineString(const Coordinate& p0, const Coordinate& p1)
 {
 	stringstream ret(ios_base::in|ios_base::out);
+	ret.imbue(std::locale::classic());
 	ret << "LINESTRING (" << p0.x << " " << p0.y;
 #if PRINT_Z
 	ret << " " << p0.z;
@@ -122,6 +172,7 @@ string
 WKTWriter::toPoint(const Coordinate& p0)
 {
 	stringstream ret(ios_base::in|ios_base::out);
+	ret.imbue(std::locale::classic());
     ret << "POINT (";
 #if PRINT_Z
 	ret << p0.x << " " << p0.y  << " " << p0.z << " )";
@@ -171,9 +222,11 @@ void
 WKTWriter::writeFormatted(const Geometry *geometry, bool isFormatted,
                           Writer *writer)
 {
-        CLocalizer clocale;
 	this->isFormatted=isFormatted;
-  decimalPlaces = roundingPrecision == -1 ? geometry->getPrecisionModel()->getMaximumSignificantDigits() : roundingPrecision;
+	const PrecisionModel* pm = geometry->getPrecisionModel();
+  decimalPlaces = roundingPrecision == -1 ? pm->getMaximumSignificantDigits() : roundingPrecision;
+	shortestNumbers = trim && roundingPrecision == -1 &&
+		pm->getType() == PrecisionModel::FLOATING;
 	appendGeometryTaggedText(geometry, 0, writer);
 }
 
@@ -320,29 +373,41 @@ void
 WKTWriter::appendCoordinate(const Coordinate* coordinate,
 		Writer *writer)
 {
-	writer->write(writeNumber(coordinate->x));
-	writer->write(" ");
-	writer->write(writeNumber(coordinate->y));
+	appendNumber(coordinate->x, writer);
+	writer->write(" ", 1);
+	appendNumber(coordinate->y, writer);
 	if( outputDimension == 3 )
 	{
-		writer->write(" ");
+		writer->write(" ", 1);
 		if( ISNAN(coordinate->z) )
-			writer->write(writeNumber(0.0));
+			appendNumber(0.0, writer);
 		else
-			writer->write(writeNumber(coordinate->z));
+			appendNumber(coordinate->z, writer);
 	}
 }
 
 /* protected */
 string
 WKTWriter::writeNumber(double d) {
+	Writer w;
+	appendNumber(d, &w);
+	return w.toString();
+}
 
-  std::stringstream ss;
-
-  if ( ! trim ) ss << std::fixed;
-  ss << std::setprecision(decimalPlaces >= 0 ? decimalPlaces : 0) << d;
+/* private */
+void
+WKTWriter::appendNumber(double d, Writer *writer)
+{
+	if ( shortestNumbers )
+	{
+		char buf[DoubleConversion::SHORTEST_BUFFER_SIZE];
+		writer->write(buf, DoubleConversion::toShortest(d, buf));
+		return;
+	}
 
-	return ss.str();
+	// Same as a stream with setprecision(), and std::fixed unless trimmed
+	int precision = decimalPlaces >= 0 ? decimalPlaces : 0;
+	printNumber(trim ? "%.*g" : "%.*f", precision, d, writer);
 }
 
 void
@@ -354,13 +419,19 @@ WKTWriter::appendLineStringText(const LineString *lineString, int level,
 	} else {
 		if (doIndent) indent(level, writer);
 		writer->write("(");
-		for(size_t i=0, n=lineString->getNumPoints(); i<n; ++i)
+		// Copied out, so that sequences such as
+		// PackedXYCoordinateSequence need no Coordinate copy
+		// of all their points
+		const CoordinateSequence* pts = lineString->getCoordinatesRO();
+		Coordinate c;
+		for(size_t i=0, n=pts->getSize(); i<n; ++i)
 		{
 			if (i>0) {
 				writer->write(", ");
 				if (i%10==0) indent(level + 2, writer);
 			}
-			appendCoordinate(&(lineString->getCoordinateN(i)), writer);
+			pts->getAt(i, c);
+			appendCoordinate(&c, writer);
 		}
 		writer->write(")");
 	}
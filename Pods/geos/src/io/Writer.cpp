@@ -19,6 +19,7 @@
 
 #include <geos/io/Writer.h>
 #include <string>
+#include <cstring>
 
 using namespace std;
 
@@ -45,6 +46,18 @@ Writer::write(const std::string& txt)
 	str.append(txt);
 }
 
+void
+Writer::write(const char* txt)
+{
+	str.append(txt, std::strlen(txt));
+}
+
+void
+Writer::write(const char* txt, std::size_t len)
+{
+	str.append(txt, len);
+}
+
 const std::string&
 Writer::toString()
 {
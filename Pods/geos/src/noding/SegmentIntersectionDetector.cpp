@@ -35,10 +35,13 @@ processIntersections(
 	// don't bother intersecting a segment with itself
 	if (e0 == e1 && segIndex0 == segIndex1) return;
 
-	const geom::Coordinate & p00 = (*e0->getCoordinates())[ segIndex0 ];
-	const geom::Coordinate & p01 = (*e0->getCoordinates())[ segIndex0 + 1 ];
-	const geom::Coordinate & p10 = (*e1->getCoordinates())[ segIndex1 ];
-	const geom::Coordinate & p11 = (*e1->getCoordinates())[ segIndex1 + 1 ];
+	// Copied out, so that sequences such as PackedXYCoordinateSequence
+	// need no Coordinate copy of all their points
+	geom::Coordinate p00, p01, p10, p11;
+	e0->getCoordinates()->getAt( segIndex0, p00 );
+	e0->getCoordinates()->getAt( segIndex0 + 1, p01 );
+	e1->getCoordinates()->getAt( segIndex1, p10 );
+	e1->getCoordinates()->getAt( segIndex1 + 1, p11 );
 
 	li->computeIntersection( p00, p01, p10, p11);
 
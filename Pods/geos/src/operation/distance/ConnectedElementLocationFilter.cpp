@@ -23,6 +23,7 @@
 #include <geos/geom/LineString.h>
 #include <geos/geom/LinearRing.h>
 #include <geos/geom/Polygon.h>
+#include <geos/geom/CoordinateSequence.h>
 
 #include <vector>
 #include <typeinfo>
@@ -52,7 +53,19 @@ ConnectedElementLocationFilter::filter_ro(const Geometry *geom)
 		(typeid(*geom)==typeid(LinearRing)) ||
 		(typeid(*geom)==typeid(Polygon)))
 	{
-		locations->push_back(new GeometryLocation(geom, 0, *(geom->getCoordinate())));
+		// The first point of a line is copied out of its sequence,
+		// so that sequences such as PackedXYCoordinateSequence need
+		// no Coordinate copy of all their points
+		const LineString* line = dynamic_cast<const LineString*>(geom);
+		if (const Polygon* poly = dynamic_cast<const Polygon*>(geom))
+			line = poly->getExteriorRing();
+
+		Coordinate pt;
+		if (line && !line->isEmpty())
+			line->getCoordinatesRO()->getAt(0, pt);
+		else
+			pt = *(geom->getCoordinate());
+		locations->push_back(new GeometryLocation(geom, 0, pt));
 	}
 }
 
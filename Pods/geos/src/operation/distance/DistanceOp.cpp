@@ -551,16 +551,20 @@ DistanceOp::computeMinDistance(
 	size_t npts1=coord1->getSize();
 
 	// brute force approach!
+	Coordinate p0, p1, q0, q1;
 	for(size_t i=0; i<npts0-1; ++i)
 	{
+		coord0->getAt(i, p0);
+		coord0->getAt(i+1, p1);
 		for(size_t j=0; j<npts1-1; ++j)
 		{
-			double dist=CGAlgorithms::distanceLineLine(coord0->getAt(i),coord0->getAt(i+1),
-				coord1->getAt(j),coord1->getAt(j+1));
+			coord1->getAt(j, q0);
+			coord1->getAt(j+1, q1);
+			double dist=CGAlgorithms::distanceLineLine(p0,p1,q0,q1);
 			if (dist < minDistance) {
 				minDistance = dist;
-				LineSegment seg0(coord0->getAt(i), coord0->getAt(i + 1));
-				LineSegment seg1(coord1->getAt(j), coord1->getAt(j + 1));
+				LineSegment seg0(p0, p1);
+				LineSegment seg1(q0, q1);
 				CoordinateSequence* closestPt = seg0.closestPoints(seg1);
 				Coordinate *c1 = new Coordinate(closestPt->getAt(0));
 				Coordinate *c2 = new Coordinate(closestPt->getAt(1));
@@ -597,12 +601,15 @@ DistanceOp::computeMinDistance(const LineString *line,
 
 	// brute force approach!
 	size_t npts0=coord0->getSize();
+	Coordinate p0, p1;
 	for(size_t i=0; i<npts0-1; ++i)
 	{
-		double dist=CGAlgorithms::distancePointLine(*coord,coord0->getAt(i),coord0->getAt(i+1));
+		coord0->getAt(i, p0);
+		coord0->getAt(i+1, p1);
+		double dist=CGAlgorithms::distancePointLine(*coord,p0,p1);
         	if (dist < minDistance) {
           		minDistance = dist;
-			LineSegment seg(coord0->getAt(i), coord0->getAt(i + 1));
+			LineSegment seg(p0, p1);
 			Coordinate segClosestPoint;
 			seg.closestPoint(*coord, segClosestPoint);
 
@@ -22,6 +22,7 @@
 #include <geos/geom/Geometry.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/util/CoordinateVisitor.h>
 
 #include <cassert>
 #include <cmath>
@@ -45,6 +46,20 @@ namespace geos {
 namespace operation { // geos.operation
 namespace overlay { // geos.operation.overlay
 
+namespace {
+
+// Passes copies of the coordinates to filter_ro(), for
+// CoordinateVisitor::forEachCoordinate()
+class FilterCaller {
+public:
+	FilterCaller(ElevationMatrixFilter& f) : filter(f) {}
+	void operator()(const Coordinate& c) { filter.filter_ro(&c); }
+private:
+	ElevationMatrixFilter& filter;
+};
+
+} // anonymous namespace
+
 ElevationMatrixFilter::ElevationMatrixFilter(ElevationMatrix &newEm):
 	em(newEm)
 { }
@@ -117,8 +132,11 @@ ElevationMatrix::add(const Geometry *geom)
 	// elevation has been computed
 	assert(!avgElevationComputed);
 
-	//ElevationMatrixFilter filter(this);
-	geom->apply_ro(&filter);
+	// Unlike apply_ro(), this does not make sequences such as
+	// PackedXYCoordinateSequence build a Coordinate copy of
+	// all their points
+	FilterCaller caller(filter);
+	geom::util::CoordinateVisitor::forEachCoordinate(*geom, caller);
 
 }
 
@@ -374,7 +374,8 @@ PolygonBuilder::computePolygons(vector<EdgeRing*>& newShellList)
 	for(size_t i=0, n=newShellList.size(); i<n; i++)
 	{
 		EdgeRing *er=newShellList[i];
-		Polygon *poly=er->toPolygon(geometryFactory);
+		// The rings are not needed anymore, so don't copy them
+		Polygon *poly=er->releasePolygon(geometryFactory);
 		resultPolyList->push_back(poly);
 	}
 	return resultPolyList;
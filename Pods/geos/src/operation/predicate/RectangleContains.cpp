@@ -93,9 +93,10 @@ bool
 RectangleContains::isLineStringContainedInBoundary(const LineString& line)
 {
 	const CoordinateSequence &seq = *(line.getCoordinatesRO());
+	Coordinate p0, p1;
 	for (unsigned int i=0, n=seq.getSize()-1; i<n; ++i) {
-		const Coordinate& p0=seq.getAt(i);
-		const Coordinate& p1=seq.getAt(i+1);
+		seq.getAt(i, p0);
+		seq.getAt(i+1, p1);
 		if (! isLineSegmentContainedInBoundary(p0, p1))
 			return false;
 	}
@@ -226,7 +226,7 @@ CascadedPolygonUnion::restrictToPolygons(std::auto_ptr<geom::Geometry> g)
     }
 
     Polygon::ConstVect polygons;
-    util::PolygonExtracter::getPolygons(*g, polygons);
+    geom::util::PolygonExtracter::getPolygons(*g, polygons);
 
     if (polygons.size() == 1)
       return std::auto_ptr<Geometry>(polygons[0]->clone());
@@ -605,13 +605,15 @@ void
 IsValidOp::checkInvalidCoordinates(const CoordinateSequence *cs)
 {
 	unsigned int size=cs->getSize();
+	Coordinate c;
 	for (unsigned int i=0; i<size; ++i)
 	{
-		if (! isValid(cs->getAt(i)) )
+		cs->getAt(i, c);
+		if (! isValid(c) )
 		{
 			validErr = new TopologyValidationError(
 				TopologyValidationError::eInvalidCoordinate,
-				cs->getAt(i));
+				c);
 			return;
 
 		}
@@ -84,12 +84,16 @@ bool
 RepeatedPointTester::hasRepeatedPoint(const CoordinateSequence *coord)
 {
 	unsigned int npts=coord->getSize();
+	Coordinate prev, c;
+	if (npts) coord->getAt(0, prev);
 	for(unsigned int i=1; i<npts; ++i)
 	{
-		if (coord->getAt(i - 1)==coord->getAt(i)) {
-			repeatedCoord=coord->getAt(i);
+		coord->getAt(i, c);
+		if (prev==c) {
+			repeatedCoord=c;
 			return true;
 		}
+		prev=c;
 	}
 	return false;
 }
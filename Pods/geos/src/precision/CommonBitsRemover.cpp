@@ -19,6 +19,7 @@
 #include <geos/geom/CoordinateFilter.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/Geometry.h>
+#include <geos/geom/util/CoordinateVisitor.h>
 #include <geos/util.h>
 
 #include <cassert>
@@ -78,8 +79,14 @@ public:
 
 	void filter_ro(const geom::Coordinate *coord)
 	{
-		commonBitsX.add(coord->x);
-		commonBitsY.add(coord->y);
+		(*this)(coord->x, coord->y);
+	}
+
+	// For CoordinateVisitor::forEachXY()
+	void operator()(double x, double y)
+	{
+		commonBitsX.add(x);
+		commonBitsY.add(y);
 	}
 
 	void getCommonCoordinate(geom::Coordinate& c)
@@ -112,7 +119,7 @@ CommonBitsRemover::~CommonBitsRemover()
 void
 CommonBitsRemover::add(const Geometry *geom)
 {
-	geom->apply_ro(ccFilter);
+	geom::util::CoordinateVisitor::forEachXY(*geom, *ccFilter);
 	ccFilter->getCommonCoordinate(commonCoord);
 }
 
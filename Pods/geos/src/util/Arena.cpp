@@ -0,0 +1,196 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/util/Arena.h>
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#ifdef _MSC_VER
+# define GEOS_THREAD_LOCAL __declspec(thread)
+#else
+# define GEOS_THREAD_LOCAL __thread
+#endif
+
+namespace geos {
+namespace util { // geos::util
+
+namespace {
+
+// Alignment of everything handed out, enough for any type we place
+const std::size_t alignment = 16;
+
+std::size_t
+alignUp(std::size_t size)
+{
+	return (size + alignment - 1) & ~(alignment - 1);
+}
+
+// Set by Arena::deleting() for the freeObject() which follows
+GEOS_THREAD_LOCAL const void* deletedPart = 0;
+
+} // anonymous namespace
+
+Arena::Arena(std::size_t bs)
+	:
+	blockSize(alignUp(bs ? bs : 1)),
+	next(0),
+	left(0),
+	allocatedSize(0)
+{
+}
+
+Arena::~Arena()
+{
+	release();
+}
+
+void*
+Arena::allocate(std::size_t size)
+{
+	size = alignUp(size ? size : 1);
+
+	if ( size > left )
+	{
+		// Large requests get a block of their own, leaving the
+		// current one in use
+		if ( size > blockSize / 4 ) return addBlock(size);
+
+		next = addBlock(blockSize);
+		left = blockSize;
+	}
+
+	void* p = next;
+	next += size;
+	left -= size;
+	return p;
+}
+
+/*private*/
+char*
+Arena::addBlock(std::size_t size)
+{
+	blocks.reserve(blocks.size() + 1);
+	char* block = static_cast<char*>(::operator new(size));
+	blocks.push_back(block);
+	allocatedSize += size;
+	return block;
+}
+
+/*private*/
+void
+Arena::addFinalizer(void* obj, void (*fn)(void*))
+{
+	Finalizer f;
+	f.obj = obj;
+	f.destroy = fn;
+	finalizers.push_back(f);
+}
+
+void
+Arena::release()
+{
+	// Later objects may own earlier ones, never the other way round,
+	// so destroying the last first leaves the earlier ones deleted
+	// by their owners, and skipped here
+	for (std::size_t i = finalizers.size(); i > 0; --i)
+	{
+		const Finalizer& f = finalizers[i - 1];
+		ObjectHeader* h = headerOf(f.obj);
+		if ( ! h->live ) continue;
+		f.destroy(f.obj);
+		h->live = 0;
+	}
+	finalizers.clear();
+
+	// The destructors above called deleting() with no freeObject()
+	// after them
+	deletedPart = 0;
+
+	for (std::size_t i = 0; i < blocks.size(); ++i)
+		::operator delete(blocks[i]);
+	blocks.clear();
+	next = 0;
+	left = 0;
+	allocatedSize = 0;
+}
+
+/*private static*/
+Arena::ObjectHeader*
+Arena::headerOf(void* obj)
+{
+	return reinterpret_cast<ObjectHeader*>(
+		static_cast<char*>(obj) - alignUp(sizeof(ObjectHeader)));
+}
+
+/*public*/
+void*
+Arena::allocateObject(std::size_t size)
+{
+	const std::size_t headerSize = alignUp(sizeof(ObjectHeader));
+
+	char* mem = static_cast<char*>(allocate(headerSize + size));
+	reinterpret_cast<ObjectHeader*>(mem)->live = 1;
+	return mem + headerSize;
+}
+
+/*public static*/
+void
+Arena::deleting(const void* part)
+{
+	deletedPart = part;
+}
+
+/*public static*/
+void
+Arena::freeObject(void* p, std::size_t size)
+{
+	const void* part = deletedPart;
+	if ( part )
+	{
+		deletedPart = 0;
+		const char* c = static_cast<const char*>(part);
+		const char* start = static_cast<const char*>(p);
+		if ( c >= start && c < start + size )
+		{
+			headerOf(p)->live = 0;
+			return;
+		}
+	}
+	::operator delete(p);
+}
+
+/*public static*/
+void
+Arena::freeObject(void* p, Arena* arena)
+{
+	if ( ! p ) return;
+
+	if ( arena ) headerOf(p)->live = 0;
+	else ::operator delete(p);
+}
+
+} // namespace geos::util
+} // namespace geos
+
+void*
+operator new(std::size_t size, geos::util::Arena* arena)
+{
+	return arena ? arena->allocateObject(size) : ::operator new(size);
+}
+
+void
+operator delete(void* p, geos::util::Arena* arena)
+{
+	geos::util::Arena::freeObject(p, arena);
+}
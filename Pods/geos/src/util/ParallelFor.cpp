@@ -0,0 +1,119 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/util/ParallelFor.h>
+#include <geos/util/GEOSException.h>
+
+#include <vector>
+
+#ifndef _WIN32
+# include <pthread.h>
+# define GEOS_PARALLELFOR_PTHREADS 1
+#endif
+
+namespace geos {
+namespace util { // geos.util
+
+namespace {
+
+struct Worker {
+	ParallelTask* task;
+	std::size_t first;
+	std::size_t stride;
+	std::size_t numTasks;
+	bool failed;
+
+	void runAll()
+	{
+		try {
+			for (std::size_t i = first; i < numTasks; i += stride)
+				task->run(i);
+		} catch (...) {
+			failed = true;
+		}
+	}
+};
+
+#ifdef GEOS_PARALLELFOR_PTHREADS
+extern "C" void* parallelForWorker(void* arg)
+{
+	static_cast<Worker*>(arg)->runAll();
+	return 0;
+}
+#endif
+
+} // anonymous namespace
+
+void
+parallelFor(std::size_t numTasks, std::size_t numThreads, ParallelTask& task)
+{
+	if ( numThreads > numTasks ) numThreads = numTasks;
+
+#ifdef GEOS_PARALLELFOR_PTHREADS
+	if ( numThreads > 1 )
+	{
+		std::vector<Worker> workers(numThreads);
+		std::vector<pthread_t> threads(numThreads);
+		std::vector<bool> started(numThreads, false);
+
+		for (std::size_t t = 0; t < numThreads; ++t)
+		{
+			Worker& w = workers[t];
+			w.task = &task;
+			w.first = t;
+			w.stride = numThreads;
+			w.numTasks = numTasks;
+			w.failed = false;
+		}
+
+		// Worker 0 runs on the calling thread. A worker whose thread
+		// cannot be started also runs here, after the others.
+		for (std::size_t t = 1; t < numThreads; ++t)
+		{
+			started[t] = 0 == pthread_create(&threads[t], NULL,
+			                                 parallelForWorker, &workers[t]);
+		}
+
+		bool failed = false;
+		try {
+			for (std::size_t t = 0; t < numThreads; ++t)
+			{
+				if ( t == 0 || ! started[t] )
+				{
+					Worker& w = workers[t];
+					for (std::size_t i = w.first; i < numTasks; i += w.stride)
+						task.run(i);
+				}
+			}
+		} catch (...) {
+			for (std::size_t t = 1; t < numThreads; ++t)
+				if ( started[t] ) pthread_join(threads[t], NULL);
+			throw;
+		}
+
+		for (std::size_t t = 1; t < numThreads; ++t)
+		{
+			if ( started[t] ) pthread_join(threads[t], NULL);
+			failed = failed || workers[t].failed;
+		}
+		if ( failed )
+			throw GEOSException("parallelFor: a task failed in a worker thread");
+		return;
+	}
+#endif
+
+	for (std::size_t i = 0; i < numTasks; ++i)
+		task.run(i);
+}
+
+} // namespace geos.util
+} // namespace geos